@@ -336,6 +336,7 @@ uint32_t GmmLib::GmmGen10CachePolicy::BestMatchingPATIdx(GMM_CACHE_POLICY_ELEMEN
 /////////////////////////////////////////////////////////////////////////////////////
 GMM_STATUS GmmLib::GmmGen10CachePolicy::SetupPAT()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_PAT);
     GMM_STATUS Status = GMM_SUCCESS;
 #if(defined(__GMM_KMD__))
     uint32_t i = 0;
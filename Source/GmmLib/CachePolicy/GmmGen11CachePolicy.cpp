@@ -294,6 +294,7 @@ GMM_STATUS GmmLib::GmmGen11CachePolicy::InitCachePolicy()
 //-----------------------------------------------------------------------------
 void GmmLib::GmmGen11CachePolicy::SetUpMOCSTable()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_MOCS_TABLE);
     GMM_CACHE_POLICY_TBL_ELEMENT *pCachePolicyTlbElement = &(pGmmLibContext->GetCachePolicyTlbElement()[0]);
 
 #define GMM_DEFINE_MOCS(Index, L3_ESC, L3_SCC, L3_CC, LeCC_CC, LeCC_TC, LeCC_LRUM, LeCC_AOM, LeCC_ESC, LeCC_SCC, LeCC_PFM, LeCC_SCF, LeCC_CoS, LeCC_SelfSnoop) \
@@ -488,6 +488,7 @@ GMM_STATUS GmmLib::GmmGen12CachePolicy::SetPATInitWA()
 /////////////////////////////////////////////////////////////////////////////////////
 GMM_STATUS GmmLib::GmmGen12CachePolicy::SetupPAT()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_PAT);
     GMM_STATUS Status = GMM_SUCCESS;
 #if(defined(__GMM_KMD__))
     uint32_t i = 0;
@@ -598,6 +599,7 @@ GMM_STATUS GmmLib::GmmGen12CachePolicy::SetupPAT()
 //-----------------------------------------------------------------------------
 void GmmLib::GmmGen12CachePolicy::SetUpMOCSTable()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_MOCS_TABLE);
     GMM_CACHE_POLICY_TBL_ELEMENT *pCachePolicyTlbElement = &(pGmmLibContext->GetCachePolicyTlbElement()[0]);
 
 #define GMM_DEFINE_MOCS(Index, L3_ESC, L3_SCC, L3_CC, LeCC_CC, LeCC_TC, LeCC_LRUM, LeCC_AOM, LeCC_ESC, LeCC_SCC, LeCC_PFM, LeCC_SCF, LeCC_CoS, LeCC_SelfSnoop, _HDCL1) \
@@ -343,6 +343,7 @@ GMM_STATUS GmmLib::GmmGen12dGPUCachePolicy::InitCachePolicy()
 //-----------------------------------------------------------------------------
 void GmmLib::GmmGen12dGPUCachePolicy::SetUpMOCSTable()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_MOCS_TABLE);
     GMM_CACHE_POLICY_TBL_ELEMENT *pCachePolicyTlbElement = &(pGmmLibContext->GetCachePolicyTlbElement()[0]);
     CurrentMaxL1HdcMocsIndex                             = 0;
     CurrentMaxSpecialMocsIndex                           = 0;
@@ -474,6 +475,7 @@ void GmmLib::GmmGen12dGPUCachePolicy::SetUpMOCSTable()
 //-----------------------------------------------------------------------------
 GMM_STATUS GmmLib::GmmGen12dGPUCachePolicy::SetupPAT()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_PAT);
     GMM_PRIVATE_PAT *pPATTlbElement = &(pGmmLibContext->GetPrivatePATTable()[0]);
 
 #define L3_UC (0x0)
@@ -134,6 +134,7 @@ uint8_t GMM_STDCALL GmmLib::GmmGen8CachePolicy::CachePolicyIsUsagePTECached(GMM_
 /////////////////////////////////////////////////////////////////////////////////////
 GMM_STATUS GmmLib::GmmGen8CachePolicy::SetupPAT()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_PAT);
     GMM_STATUS Status = GMM_SUCCESS;
 #if(defined(__GMM_KMD__))
     uint32_t i = 0;
@@ -261,6 +261,7 @@ GMM_STATUS GmmLib::GmmGen9CachePolicy::InitCachePolicy()
 /////////////////////////////////////////////////////////////////////////////////////
 GMM_STATUS GmmLib::GmmGen9CachePolicy::SetupPAT()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_PAT);
     GMM_STATUS Status = GMM_SUCCESS;
 #if(defined(__GMM_KMD__))
     uint32_t i = 0;
@@ -310,6 +310,7 @@ uint32_t GMM_STDCALL GmmLib::GmmXe_LPGCachePolicy::CachePolicyGetPATIndex(GMM_RE
 //-----------------------------------------------------------------------------
 void GmmLib::GmmXe_LPGCachePolicy::SetUpMOCSTable()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_MOCS_TABLE);
     GMM_CACHE_POLICY_TBL_ELEMENT *pCachePolicyTlbElement = &(pGmmLibContext->GetCachePolicyTlbElement()[0]);
     CurrentMaxL1HdcMocsIndex                             = 0;
     CurrentMaxSpecialMocsIndex                           = 0;
@@ -378,6 +379,7 @@ void GmmLib::GmmXe_LPGCachePolicy::SetUpMOCSTable()
 //-----------------------------------------------------------------------------
 GMM_STATUS GmmLib::GmmXe_LPGCachePolicy::SetupPAT()
 {
+    GmmLib::InitPhaseTimer PhaseTimer(pGmmLibContext, GMM_INIT_PHASE_SETUP_PAT);
     GMM_PRIVATE_PAT *pPATTlbElement = &(pGmmLibContext->GetPrivatePATTable()[0]);
 
 #define L4_WB (0x0)
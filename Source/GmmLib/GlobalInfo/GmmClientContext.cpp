@@ -22,6 +22,7 @@ OTHER DEALINGS IN THE SOFTWARE.
 
 #include "Internal/Common/GmmLibInc.h"
 #include "External/Common/GmmClientContext.h"
+#include <stddef.h>
 
 #if !__GMM_KMD__ && LHDM
 #include "..\..\inc\common\gfxEscape.h"
@@ -30,6 +31,34 @@ OTHER DEALINGS IN THE SOFTWARE.
 #include "../TranslationTable/GmmUmdTranslationTable.h"
 #endif
 
+#define GMM_RESOURCE_MEM_MIN_ENTRIES 64
+
+//===========================================================================
+// typedef:
+//     GMM_RESOURCE_MEM_TRACKER
+//
+// Description:
+//     Client context's resource mem stats and the size info each live resource
+//     was added with, keyed by resource so it is removed with the same numbers
+//     after Override*() calls. Open addressing over a power of two entries,
+//     kept at most half full. Lock guards the entries, Stats is updated with
+//     atomics so GetResourceMemStats reads it without the lock.
+//---------------------------------------------------------------------------
+typedef struct GMM_RESOURCE_MEM_ENTRY_REC
+{
+    GMM_RESOURCE_INFO     *pRes;        // NULL if free
+    GMM_RESOURCE_SIZE_INFO Size;
+} GMM_RESOURCE_MEM_ENTRY;
+
+typedef struct GMM_RESOURCE_MEM_TRACKER_REC
+{
+    GMM_RESOURCE_MEM_STATS  Stats;
+    uint32_t                Lock;
+    uint32_t                NumEntries;
+    uint32_t                MaxEntries;
+    GMM_RESOURCE_MEM_ENTRY *pEntries;
+} GMM_RESOURCE_MEM_TRACKER;
+
 extern GMM_MA_LIB_CONTEXT *pGmmMALibContext;
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -42,16 +71,47 @@ GmmLib::GmmClientContext::GmmClientContext(GMM_CLIENT ClientType, Context *pLibC
       pUmdAdapter(),
       pGmmUmdContext(),
       DeviceCB(),
-      IsDeviceCbReceived(0)
+      IsDeviceCbReceived(0),
+      AllocatorCb(),
+      pResMemTracker()
 {
     this->ClientType     = ClientType;
     this->pGmmLibContext = pLibContext;
 }
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Overloaded Constructor taking client heap hooks, used for the context's internal
+/// allocations. pAllocatorCb is copied, NULL selects malloc. Clients built before
+/// pfnResetArena was added pass a shorter struct, its size member tells which.
+/////////////////////////////////////////////////////////////////////////////////////
+GmmLib::GmmClientContext::GmmClientContext(GMM_CLIENT ClientType, Context *pLibContext, const GmmClientAllocationCallbacks *pAllocatorCb)
+    : GmmClientContext(ClientType, pLibContext)
+{
+    if(pAllocatorCb)
+    {
+        AllocatorCb.pUserData     = pAllocatorCb->pUserData;
+        AllocatorCb.size          = pAllocatorCb->size;
+        AllocatorCb.alignment     = pAllocatorCb->alignment;
+        AllocatorCb.pfnAllocation = pAllocatorCb->pfnAllocation;
+        AllocatorCb.pfnFree       = pAllocatorCb->pfnFree;
+
+        if(pAllocatorCb->size >= offsetof(GmmClientAllocationCallbacks, pfnResetArena) + sizeof(PFN_ClientResetFunction))
+        {
+            AllocatorCb.pfnResetArena = pAllocatorCb->pfnResetArena;
+        }
+    }
+}
 /////////////////////////////////////////////////////////////////////////////////////
 /// Destructor to free  GmmLib::GmmClientContext object memory
 /////////////////////////////////////////////////////////////////////////////////////
 GmmLib::GmmClientContext::~GmmClientContext()
 {
+    if(pResMemTracker)
+    {
+        GmmMemAllocator::DeleteArray(pResMemTracker->pEntries);
+        GmmMemAllocator::DeleteArray(pResMemTracker);
+        pResMemTracker = NULL;
+    }
     pGmmLibContext = NULL;
 }
 
@@ -378,7 +438,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmLib::GmmClientContext::CreateCustomResInfoObje
 
     pClientContextIn = this;
 
-    if((pRes = new GMM_RESOURCE_INFO(pClientContextIn)) == NULL)
+    if((pRes = new(GetAllocatorCb(), GMM_HEAP_RESOURCE_INFO) GMM_RESOURCE_INFO(pClientContextIn)) == NULL)
     {
         GMM_ASSERTDPF(0, "Allocation failed!");
         goto ERROR_CASE;
@@ -388,6 +448,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmLib::GmmClientContext::CreateCustomResInfoObje
     {
         goto ERROR_CASE;
     }
+    AddResourceMem(pRes);
 
     return (pRes);
 
@@ -415,7 +476,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmLib::GmmClientContext::CreateCustomResInfoObje
 
     pClientContextIn = this;
 
-    if((pRes = new GMM_RESOURCE_INFO(pClientContextIn)) == NULL)
+    if((pRes = new(GetAllocatorCb(), GMM_HEAP_RESOURCE_INFO) GMM_RESOURCE_INFO(pClientContextIn)) == NULL)
     {
         GMM_ASSERTDPF(0, "Allocation failed!");
         goto ERROR_CASE;
@@ -425,6 +486,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmLib::GmmClientContext::CreateCustomResInfoObje
     {
         goto ERROR_CASE;
     }
+    AddResourceMem(pRes);
 
     return (pRes);
 
@@ -467,7 +529,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmLib::GmmClientContext::CreateResInfoObject(GMM
     }
     else
     {
-        if((pRes = new GMM_RESOURCE_INFO(pClientContextIn)) == NULL)
+        if((pRes = new(GetAllocatorCb(), GMM_HEAP_RESOURCE_INFO) GMM_RESOURCE_INFO(pClientContextIn)) == NULL)
         {
             GMM_ASSERTDPF(0, "Allocation failed!");
             goto ERROR_CASE;
@@ -478,6 +540,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmLib::GmmClientContext::CreateResInfoObject(GMM
     {
         goto ERROR_CASE;
     }
+    AddResourceMem(pRes);
 
     GMM_DPF_EXIT;
 
@@ -513,7 +576,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmLib::GmmClientContext::CopyResInfoObject(GMM_R
 
     __GMM_ASSERTPTR(pSrcRes, NULL);
 
-    pResCopy = new GMM_RESOURCE_INFO(pClientContextIn);
+    pResCopy = new(GetAllocatorCb(), GMM_HEAP_RESOURCE_INFO) GMM_RESOURCE_INFO(pClientContextIn);
     if(!pResCopy)
     {
         GMM_ASSERTDPF(0, "Allocation failed.");
@@ -575,6 +638,8 @@ void GMM_STDCALL GmmLib::GmmClientContext::DestroyResInfoObject(GMM_RESOURCE_INF
 {
     __GMM_ASSERTPTR(pResInfo, VOIDRETURN);
 
+    RemoveResourceMem(pResInfo);
+
     if(pResInfo->GetResFlags().Info.__PreallocatedResInfo)
     {
         *pResInfo = GmmLib::GmmResourceInfo();
@@ -618,7 +683,7 @@ GMM_PAGETABLE_MGR* GMM_STDCALL GmmLib::GmmClientContext::CreatePageTblMgrObject(
 {
     GMM_PAGETABLE_MGR* pPageTableMgr = NULL;
 
-    pPageTableMgr = new GMM_PAGETABLE_MGR(pDevCb, TTFlags, this);
+    pPageTableMgr = new(GetAllocatorCb(), GMM_HEAP_PAGETABLE) GMM_PAGETABLE_MGR(pDevCb, TTFlags, this);
 
     return pPageTableMgr;
 }
@@ -684,6 +749,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmLib::GmmClientContext::CreateResInfoObject(GMM
         {
             goto ERROR_CASE;
         }
+        AddResourceMem(pRes);
 
         return (pRes);
 
@@ -723,6 +789,8 @@ void GMM_STDCALL GmmLib::GmmClientContext::DestroyResInfoObject(GMM_RESOURCE_INF
     }
     else
     {
+        RemoveResourceMem(pResInfo);
+
         if(pResInfo->GetResFlags().Info.__PreallocatedResInfo)
         {
             *pResInfo = GmmLib::GmmResourceInfo();
@@ -825,6 +893,300 @@ GMM_STATUS GMM_STDCALL GmmLib::GmmClientContext::GmmSetDeviceInfo(GMM_DEVICE_INF
     return Status;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function of ClientContext class for querying GmmLib heap usage by
+/// category (resource infos, page tables, contexts, cache policy, log buffers).
+/// Counters are kept per loaded GmmLib module, so they cover every adapter and
+/// client context of this module, not just this one. All zero unless the module
+/// is built with GMM_HEAP_TRACK_STATS.
+/// @param[out] pStats : Current/peak bytes and objects per category
+/// @return     Void
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::GmmClientContext::GetHeapStats(GMM_HEAP_STATS *pStats)
+{
+    __GMM_ASSERTPTR(pStats, VOIDRETURN);
+
+    GmmMemAllocator::GetHeapStats(pStats);
+}
+
+static void __GmmLockResourceMem(GMM_RESOURCE_MEM_TRACKER *pTracker)
+{
+#if _WIN32
+    while(InterlockedExchange((LONG *)&pTracker->Lock, 1))
+#else
+    while(__sync_lock_test_and_set(&pTracker->Lock, 1))
+#endif
+    {
+    }
+}
+
+static void __GmmUnlockResourceMem(GMM_RESOURCE_MEM_TRACKER *pTracker)
+{
+#if _WIN32
+    InterlockedExchange((LONG *)&pTracker->Lock, 0);
+#else
+    __sync_lock_release(&pTracker->Lock);
+#endif
+}
+
+// Slot pRes' probe starts at, MaxEntries must be non-zero
+static uint32_t __GmmResourceMemHome(const GMM_RESOURCE_MEM_TRACKER *pTracker, const GMM_RESOURCE_INFO *pRes)
+{
+    return (uint32_t)((((uint64_t)(uintptr_t)pRes >> 4) * 0x9E3779B97F4A7C15ull) >> 32) & (pTracker->MaxEntries - 1);
+}
+
+//=============================================================================
+//
+// Function: __GmmFindResourceMemEntry
+//
+// Desc: Probes the entries for pRes. MaxEntries must be non-zero.
+//
+// Returns: index of pRes' entry, or of the free entry ending the probe
+//-----------------------------------------------------------------------------
+static uint32_t __GmmFindResourceMemEntry(const GMM_RESOURCE_MEM_TRACKER *pTracker, const GMM_RESOURCE_INFO *pRes)
+{
+    uint32_t Mask = pTracker->MaxEntries - 1;
+    uint32_t i    = __GmmResourceMemHome(pTracker, pRes);
+
+    while(pTracker->pEntries[i].pRes && (pTracker->pEntries[i].pRes != pRes))
+    {
+        i = (i + 1) & Mask;
+    }
+    return i;
+}
+
+//=============================================================================
+//
+// Function: __GmmInsertResourceMemEntry
+//
+// Desc: Records the size info pRes is accounted with, growing the entries
+//       when half full. Caller holds the lock.
+//
+// Returns: false if the entries could not grow
+//-----------------------------------------------------------------------------
+static bool __GmmInsertResourceMemEntry(const GmmClientAllocationCallbacks *pAllocatorCb, GMM_RESOURCE_MEM_TRACKER *pTracker,
+                                        GMM_RESOURCE_INFO *pRes, const GMM_RESOURCE_SIZE_INFO *pSize)
+{
+    GMM_RESOURCE_MEM_ENTRY *pEntry;
+
+    if((pTracker->NumEntries + 1) * 2 > pTracker->MaxEntries)
+    {
+        GMM_RESOURCE_MEM_ENTRY *pOld       = pTracker->pEntries;
+        uint32_t                OldEntries = pTracker->MaxEntries;
+        uint32_t                MaxEntries = GFX_MAX(OldEntries * 2, GMM_RESOURCE_MEM_MIN_ENTRIES);
+        GMM_RESOURCE_MEM_ENTRY *pNew       = GmmMemAllocator::NewArray<GMM_RESOURCE_MEM_ENTRY>(pAllocatorCb, MaxEntries, GMM_HEAP_CONTEXT);
+
+        if(!pNew)
+        {
+            return false;
+        }
+
+        pTracker->pEntries   = pNew;
+        pTracker->MaxEntries = MaxEntries;
+        for(uint32_t i = 0; i < OldEntries; i++)
+        {
+            if(pOld[i].pRes)
+            {
+                pNew[__GmmFindResourceMemEntry(pTracker, pOld[i].pRes)] = pOld[i];
+            }
+        }
+        GmmMemAllocator::DeleteArray(pOld);
+    }
+
+    pEntry = &pTracker->pEntries[__GmmFindResourceMemEntry(pTracker, pRes)];
+    if(!pEntry->pRes)
+    {
+        pTracker->NumEntries++;
+    }
+    pEntry->pRes = pRes;
+    pEntry->Size = *pSize;
+    return true;
+}
+
+//=============================================================================
+//
+// Function: __GmmRemoveResourceMemEntry
+//
+// Desc: Takes out pRes' entry, shifting back later entries of its probe so
+//       lookups need no tombstones. Caller holds the lock.
+//
+// Returns: false if pRes is not accounted
+//-----------------------------------------------------------------------------
+static bool __GmmRemoveResourceMemEntry(GMM_RESOURCE_MEM_TRACKER *pTracker, const GMM_RESOURCE_INFO *pRes, GMM_RESOURCE_SIZE_INFO *pSize)
+{
+    uint32_t Mask = pTracker->MaxEntries - 1;
+    uint32_t i, j;
+
+    if(!pTracker->NumEntries)
+    {
+        return false;
+    }
+
+    i = __GmmFindResourceMemEntry(pTracker, pRes);
+    if(!pTracker->pEntries[i].pRes)
+    {
+        return false;
+    }
+    *pSize = pTracker->pEntries[i].Size;
+
+    for(j = (i + 1) & Mask; pTracker->pEntries[j].pRes; j = (j + 1) & Mask)
+    {
+        uint32_t Home = __GmmResourceMemHome(pTracker, pTracker->pEntries[j].pRes);
+
+        // Entry j stays if its home slot is in (i, j], its probe doesn't pass i
+        if((j > i) ? ((Home > i) && (Home <= j)) : ((Home > i) || (Home <= j)))
+        {
+            continue;
+        }
+        pTracker->pEntries[i] = pTracker->pEntries[j];
+        i                     = j;
+    }
+    pTracker->pEntries[i].pRes = NULL;
+    pTracker->NumEntries--;
+    return true;
+}
+
+//=============================================================================
+//
+// Function: __GmmUpdateResourceMemBucket
+//
+// Desc: Adds (Sign 1) or removes (Sign -1) a resource to/from a histogram bucket
+//
+// Returns: new AllocationSize of the bucket
+//-----------------------------------------------------------------------------
+static uint64_t __GmmUpdateResourceMemBucket(GMM_RESOURCE_MEM_BUCKET *pBucket, const GMM_RESOURCE_SIZE_INFO *pSize, int64_t Sign)
+{
+    GmmMemAllocator::AtomicAdd64(&pBucket->Count, Sign);
+    GmmMemAllocator::AtomicAdd64(&pBucket->LogicalSize, Sign * (int64_t)pSize->LogicalSize);
+    return GmmMemAllocator::AtomicAdd64(&pBucket->AllocationSize, Sign * (int64_t)pSize->AllocationSize);
+}
+
+//=============================================================================
+//
+// Function: __GmmUpdateResourceMemStats
+//
+// Desc: Adds (Sign 1) or removes (Sign -1) a resource to/from the totals and
+//       histograms. Lock free, a concurrent GetResourceMemStats may see a
+//       resource in some counters only.
+//-----------------------------------------------------------------------------
+static void __GmmUpdateResourceMemStats(GMM_RESOURCE_MEM_STATS *pStats, const GMM_RESOURCE_SIZE_INFO *pSize, int64_t Sign)
+{
+    GMM_RESOURCE_SIZE_INFO *pSum = &pStats->Breakdown;
+
+    GmmMemAllocator::AtomicMax64(&pStats->PeakAllocationSize, __GmmUpdateResourceMemBucket(&pStats->Total, pSize, Sign));
+
+    if((uint32_t)pSize->Type < GMM_MAX_HW_RESOURCE_TYPE)
+    {
+        __GmmUpdateResourceMemBucket(&pStats->Type[pSize->Type], pSize, Sign);
+    }
+    if((uint32_t)pSize->Format < GMM_RESOURCE_FORMATS)
+    {
+        __GmmUpdateResourceMemBucket(&pStats->Format[pSize->Format], pSize, Sign);
+    }
+    if((uint32_t)pSize->TileMode < GMM_TILE_MODES)
+    {
+        __GmmUpdateResourceMemBucket(&pStats->TileMode[pSize->TileMode], pSize, Sign);
+    }
+
+    GmmMemAllocator::AtomicAdd64(&pSum->LogicalSize, Sign * (int64_t)pSize->LogicalSize);
+    GmmMemAllocator::AtomicAdd64(&pSum->AlignPadding, Sign * (int64_t)pSize->AlignPadding);
+    GmmMemAllocator::AtomicAdd64(&pSum->MipTailPadding, Sign * (int64_t)pSize->MipTailPadding);
+    GmmMemAllocator::AtomicAdd64(&pSum->LayoutPadding, Sign * (int64_t)pSize->LayoutPadding);
+    GmmMemAllocator::AtomicAdd64(&pSum->MainSurfaceSize, Sign * (int64_t)pSize->MainSurfaceSize);
+    GmmMemAllocator::AtomicAdd64(&pSum->AuxSize, Sign * (int64_t)pSize->AuxSize);
+    GmmMemAllocator::AtomicAdd64(&pSum->ClearColorSize, Sign * (int64_t)pSize->ClearColorSize);
+    GmmMemAllocator::AtomicAdd64(&pSum->AuxPadding, Sign * (int64_t)pSize->AuxPadding);
+    GmmMemAllocator::AtomicAdd64(&pSum->PageSizePadding, Sign * (int64_t)pSize->PageSizePadding);
+    GmmMemAllocator::AtomicAdd64(&pSum->AllocationSize, Sign * (int64_t)pSize->AllocationSize);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function of ClientContext class for adding a newly created resource to
+/// the context's resource mem stats. The size info is kept in the context, keyed by
+/// pRes, so RemoveResourceMem() takes out the same numbers.
+/// @param[in]  pRes : Created resource
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::GmmClientContext::AddResourceMem(GMM_RESOURCE_INFO *pRes)
+{
+    GMM_RESOURCE_MEM_TRACKER *pTracker = pResMemTracker;
+    GMM_RESOURCE_SIZE_INFO    Size;
+
+    if(!pTracker)
+    {
+        GMM_RESOURCE_MEM_TRACKER *pPrev;
+
+        // Best effort, resource creation doesn't fail for want of stats
+        if(!(pTracker = GmmMemAllocator::NewArray<GMM_RESOURCE_MEM_TRACKER>(GetAllocatorCb(), 1, GMM_HEAP_CONTEXT)))
+        {
+            return;
+        }
+#if _WIN32
+        pPrev = (GMM_RESOURCE_MEM_TRACKER *)InterlockedCompareExchangePointer((PVOID *)&pResMemTracker, pTracker, NULL);
+#else
+        pPrev = __sync_val_compare_and_swap(&pResMemTracker, (GMM_RESOURCE_MEM_TRACKER *)NULL, pTracker);
+#endif
+        if(pPrev)
+        {
+            GmmMemAllocator::DeleteArray(pTracker);
+            pTracker = pPrev;
+        }
+    }
+
+    pRes->GetSizeInfo(&Size);
+
+    __GmmLockResourceMem(pTracker);
+    if(__GmmInsertResourceMemEntry(GetAllocatorCb(), pTracker, pRes, &Size))
+    {
+        __GmmUpdateResourceMemStats(&pTracker->Stats, &Size, 1);
+    }
+    __GmmUnlockResourceMem(pTracker);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function of ClientContext class for removing a resource about to be
+/// destroyed from the context's resource mem stats. No-op for resources that were
+/// not added, e.g. copies or failed creations.
+/// @param[in]  pRes : Resource being destroyed
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::GmmClientContext::RemoveResourceMem(GMM_RESOURCE_INFO *pRes)
+{
+    GMM_RESOURCE_MEM_TRACKER *pTracker = pResMemTracker;
+    GMM_RESOURCE_SIZE_INFO    Size;
+
+    if(pTracker)
+    {
+        __GmmLockResourceMem(pTracker);
+        if(__GmmRemoveResourceMemEntry(pTracker, pRes, &Size))
+        {
+            __GmmUpdateResourceMemStats(&pTracker->Stats, &Size, -1);
+        }
+        __GmmUnlockResourceMem(pTracker);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function of ClientContext class for querying the memory used by the
+/// resources created through this context and not yet destroyed: totals, peak,
+/// summed size breakdown (see GmmResourceInfoCommon::GetSizeInfo) and histograms by
+/// resource type, format and tile mode. Resources must be destroyed through the
+/// context that created them.
+/// @param[out] pStats : Resource mem stats
+/// @return     Void
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::GmmClientContext::GetResourceMemStats(GMM_RESOURCE_MEM_STATS *pStats)
+{
+    __GMM_ASSERTPTR(pStats, VOIDRETURN);
+
+    if(pResMemTracker)
+    {
+        *pStats = pResMemTracker->Stats;
+    }
+    else
+    {
+        memset(pStats, 0, sizeof(*pStats));
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 /// Gmm lib DLL C wrapper for creating GmmLib::GmmClientContext object
 /// This C wrapper is used for Multi-Adapter scenarios to take in Adapter's BDF as
@@ -839,11 +1201,37 @@ GMM_STATUS GMM_STDCALL GmmLib::GmmClientContext::GmmSetDeviceInfo(GMM_DEVICE_INF
 /////////////////////////////////////////////////////////////////////////////////////
 extern "C" GMM_CLIENT_CONTEXT *GMM_STDCALL GmmCreateClientContextForAdapter(GMM_CLIENT  ClientType,
                                                                             ADAPTER_BDF sBdf)
+{
+    return GmmCreateClientContextWithAllocator(ClientType, sBdf, NULL);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Gmm lib DLL C wrapper for creating GmmLib::GmmClientContext object whose internal
+/// allocations (context itself, resource infos, page-table manager) go through
+/// client heap hooks.
+///
+/// @see        Class GmmLib::GmmClientContext
+///
+/// @param[in]  ClientType : describles the UMD clients such as OCL, DX, OGL, Vulkan etc
+/// @param[in]  sBDF: Adapter's BDF info
+/// @param[in]  pAllocatorCb: Client heap hooks, copied. NULL selects malloc
+///
+/// @return     Pointer to GmmClientContext, if Context is created
+/////////////////////////////////////////////////////////////////////////////////////
+extern "C" GMM_CLIENT_CONTEXT *GMM_STDCALL GmmCreateClientContextWithAllocator(GMM_CLIENT                     ClientType,
+                                                                               ADAPTER_BDF                    sBdf,
+                                                                               const GmmClientAllocationCallbacks *pAllocatorCb)
 {
     GMM_CLIENT_CONTEXT *pGmmClientContext = nullptr;
     GMM_LIB_CONTEXT *   pLibContext       = pGmmMALibContext->GetAdapterLibContext(sBdf);
 
-    pGmmClientContext = new GMM_CLIENT_CONTEXT(ClientType, pLibContext);
+    if(pAllocatorCb && (!pAllocatorCb->pfnAllocation || !pAllocatorCb->pfnFree))
+    {
+        GMM_ASSERTDPF(0, "Allocator needs both pfnAllocation and pfnFree");
+        return NULL;
+    }
+
+    pGmmClientContext = new(pAllocatorCb, GMM_HEAP_CONTEXT) GMM_CLIENT_CONTEXT(ClientType, pLibContext, pAllocatorCb);
 
     return pGmmClientContext;
 }
@@ -858,7 +1246,20 @@ extern "C" void GMM_STDCALL GmmDeleteClientContext(GMM_CLIENT_CONTEXT *pGmmClien
 {
     if(pGmmClientContext)
     {
+        GmmClientAllocationCallbacks AllocatorCb = {0};
+
+        if(pGmmClientContext->GetAllocatorCb())
+        {
+            AllocatorCb = *pGmmClientContext->GetAllocatorCb();
+        }
+
         delete pGmmClientContext;
         pGmmClientContext = NULL;
+
+        // Everything allocated on behalf of the context is gone by now
+        if(AllocatorCb.pfnResetArena)
+        {
+            AllocatorCb.pfnResetArena(AllocatorCb.pUserData);
+        }
     }
 }
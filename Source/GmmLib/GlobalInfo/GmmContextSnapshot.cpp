@@ -0,0 +1,425 @@
+/*==============================================================================
+Copyright(c) 2017 Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files(the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and / or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+============================================================================*/
+
+#include "Internal/Common/GmmLibInc.h"
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @file GmmContextSnapshot.cpp
+/// @brief Opt-in on-disk snapshot of the immutable state computed by
+///        GmmLib::Context::InitContext (cache policy, MOCS and PAT tables).
+///
+/// Setting GMM_CONTEXT_SNAPSHOT_DIR to a writable directory makes the first process
+/// write the initialized state to <dir>/gmm_ctx_<key>.bin. Later processes with the
+/// same platform, SKU, WA, GT system info and library binary map that file instead of
+/// re-running InitCachePolicy. Any mismatch or corruption falls back to a full init.
+/////////////////////////////////////////////////////////////////////////////////////
+
+#if(!defined(__GMM_KMD__) && defined(__linux__))
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define GMM_CONTEXT_SNAPSHOT_ENV      "GMM_CONTEXT_SNAPSHOT_DIR"
+#define GMM_CONTEXT_SNAPSHOT_MAGIC    0x534D4D47 // 'GMMS'
+#define GMM_CONTEXT_SNAPSHOT_VERSION  1
+#define GMM_CONTEXT_SNAPSHOT_PATH_MAX 4096
+
+//===========================================================================
+// typedef:
+//      GMM_CONTEXT_SNAPSHOT
+//
+// Description:
+//      On-disk layout of a context snapshot. The payload is the raw image of
+//      the context owned tables, so it is only valid for the library binary
+//      that wrote it (which is part of Key).
+//----------------------------------------------------------------------------
+typedef struct GMM_CONTEXT_SNAPSHOT_REC
+{
+    uint32_t                     Magic;
+    uint32_t                     Version;
+    uint64_t                     Key;
+    uint64_t                     PayloadChecksum;
+    uint32_t                     Size;
+    uint32_t                     Reserved;
+
+    // Payload
+    GMM_CACHE_POLICY_STATE       CachePolicyState;
+    GMM_CACHE_POLICY_ELEMENT     CachePolicy[GMM_RESOURCE_USAGE_MAX];
+    GMM_CACHE_POLICY_TBL_ELEMENT CachePolicyTbl[GMM_MAX_NUMBER_MOCS_INDEXES];
+    GMM_PRIVATE_PAT              PrivatePATTable[GMM_NUM_PAT_ENTRIES];
+} GMM_CONTEXT_SNAPSHOT;
+
+#define GMM_CONTEXT_SNAPSHOT_PAYLOAD_OFFSET offsetof(GMM_CONTEXT_SNAPSHOT, CachePolicyState)
+
+//=============================================================================
+//
+// Function: __GmmSnapshotHash
+//
+// Desc: FNV-1a hash, chained through Hash so several buffers can be combined.
+//
+// Returns: updated hash
+//-----------------------------------------------------------------------------
+static uint64_t __GmmSnapshotHash(uint64_t Hash, const void *pData, size_t Size)
+{
+    const uint8_t *pByte = static_cast<const uint8_t *>(pData);
+
+    for(size_t i = 0; i < Size; i++)
+    {
+        Hash ^= pByte[i];
+        Hash *= 0x100000001B3ULL;
+    }
+
+    return Hash;
+}
+
+//=============================================================================
+//
+// Function: __GmmSnapshotGetPath
+//
+// Desc: Builds the snapshot file name for Key inside the snapshot directory.
+//
+// Returns: true if pPath was filled
+//-----------------------------------------------------------------------------
+static bool __GmmSnapshotGetPath(const char *pDir, uint64_t Key, char *pPath, size_t PathSize)
+{
+    int Len = snprintf(pPath, PathSize, "%s/gmm_ctx_%016llx.bin", pDir, (unsigned long long)Key);
+
+    return (Len > 0 && (size_t)Len < PathSize);
+}
+
+//=============================================================================
+//
+// Function: __GmmSnapshotGetKey
+//
+// Desc: Hashes everything the snapshot payload depends on: the platform, the
+//       SKU/WA/GT system info fields the cache policy reads, the snapshot format
+//       and the identity (size, mtime, inode) of the loaded library binary.
+//       Fields are widened into a padding free array, hashing the client's
+//       structs whole would pick up padding and unused bitfield bits. A library
+//       reading more fields is a new binary, so gets new keys anyway, but the
+//       list has to follow CachePolicy/ and CreateCachePolicyCommon().
+//
+// Returns: snapshot key
+//-----------------------------------------------------------------------------
+static uint64_t __GmmSnapshotGetKey(const PLATFORM &Platform, GmmLib::Context *pGmmLibContext)
+{
+    const SKU_FEATURE_TABLE &Sku     = pGmmLibContext->GetSkuTable();
+    const WA_TABLE &         Wa      = pGmmLibContext->GetWaTable();
+    const GT_SYSTEM_INFO *   pSys    = pGmmLibContext->GetGtSysInfoPtr();
+    uint64_t                 Hash    = 0xCBF29CE484222325ULL;
+    Dl_info                  LibInfo = {};
+    struct stat              LibStat;
+
+    const uint64_t Inputs[] =
+    {
+        GMM_CONTEXT_SNAPSHOT_VERSION,
+        sizeof(GMM_CONTEXT_SNAPSHOT),
+
+        (uint64_t)Platform.eProductFamily,
+        (uint64_t)Platform.ePCHProductFamily,
+        (uint64_t)Platform.eDisplayCoreFamily,
+        (uint64_t)Platform.eRenderCoreFamily,
+#ifndef _COMMON_PPA
+        (uint64_t)Platform.ePlatformType,
+#endif
+        Platform.usDeviceID,
+        Platform.usRevId,
+        Platform.usDeviceID_PCH,
+        Platform.usRevId_PCH,
+        (uint64_t)Platform.eGTType,
+
+        Sku.FtrCameraCaptureCaching,
+        Sku.FtrEDram,
+        Sku.FtrFrameBufferLLC,
+        Sku.FtrIA32eGfxPTEs,
+        Sku.FtrLCIA,
+        Sku.FtrLLCBypass,
+        Sku.FtrLocalMemory,
+        Sku.FtrMemTypeMocsDeferPAT,
+        Sku.FtrULT,
+        Sku.FtrWddm2Svm,
+
+        Wa.Wa_1606955757,
+        Wa.WaDisableEdramForDisplayRT,
+        Wa.WaEncryptedEdramOnlyPartials,
+        Wa.WaGttPat0,
+        Wa.WaGttPat0GttWbOverOsIommuEllcOnly,
+        Wa.WaGttPat0WB,
+        Wa.WaMemTypeIsMaxOfPatAndMocs,
+        Wa.WaNoMocsEllcOnly,
+
+        pSys->L3CacheSizeInKb,
+        pSys->LLCCacheSizeInKb,
+        pSys->EdramSizeInKb,
+    };
+
+    Hash = __GmmSnapshotHash(Hash, Inputs, sizeof(Inputs));
+
+    if(dladdr(reinterpret_cast<void *>(&__GmmSnapshotGetKey), &LibInfo) &&
+       LibInfo.dli_fname &&
+       (stat(LibInfo.dli_fname, &LibStat) == 0))
+    {
+        uint64_t LibId[3] = {(uint64_t)LibStat.st_size, (uint64_t)LibStat.st_mtime, (uint64_t)LibStat.st_ino};
+        Hash              = __GmmSnapshotHash(Hash, LibId, sizeof(LibId));
+    }
+
+    return Hash;
+}
+
+// Saves or restores the bookkeeping of cache policy class T, see __GmmCachePolicyState
+template <class T>
+static void __GmmCachePolicyStateOf(GMM_CACHE_POLICY *pGmmCachePolicy, GMM_CACHE_POLICY_STATE *pState, bool Restore)
+{
+    T *pCachePolicy = static_cast<T *>(pGmmCachePolicy);
+
+    if(Restore)
+    {
+        pCachePolicy->SetCachePolicyState(pState);
+    }
+    else
+    {
+        pCachePolicy->GetCachePolicyState(pState);
+    }
+}
+
+//=============================================================================
+//
+// Function: __GmmCachePolicyState
+//
+// Desc: Saves (Restore false) or restores the gen specific cache policy
+//       bookkeeping. Get/SetCachePolicyState() are not virtual, so the class is
+//       picked the way GmmLib::Context::CreateCachePolicyCommon() picked it.
+//-----------------------------------------------------------------------------
+static void __GmmCachePolicyState(GmmLib::Context *pGmmLibContext, GMM_CACHE_POLICY_STATE *pState, bool Restore)
+{
+    GMM_CACHE_POLICY *pGmmCachePolicy = pGmmLibContext->GetCachePolicyObj();
+
+    if(GFX_GET_CURRENT_PRODUCT(pGmmLibContext->GetPlatformInfo().Platform) == IGFX_METEORLAKE)
+    {
+        __GmmCachePolicyStateOf<GmmLib::GmmXe_LPGCachePolicy>(pGmmCachePolicy, pState, Restore);
+        return;
+    }
+
+    switch(GFX_GET_CURRENT_RENDERCORE(pGmmLibContext->GetPlatformInfo().Platform))
+    {
+        case IGFX_GEN12LP_CORE:
+        case IGFX_GEN12_CORE:
+        case IGFX_XE_HP_CORE:
+        case IGFX_XE_HPG_CORE:
+        case IGFX_XE_HPC_CORE:
+            if(pGmmLibContext->GetSkuTable().FtrLocalMemory)
+            {
+                __GmmCachePolicyStateOf<GmmLib::GmmGen12dGPUCachePolicy>(pGmmCachePolicy, pState, Restore);
+            }
+            else
+            {
+                __GmmCachePolicyStateOf<GmmLib::GmmGen12CachePolicy>(pGmmCachePolicy, pState, Restore);
+            }
+            break;
+        case IGFX_GEN11_CORE:
+            __GmmCachePolicyStateOf<GmmLib::GmmGen11CachePolicy>(pGmmCachePolicy, pState, Restore);
+            break;
+        case IGFX_GEN10_CORE:
+            __GmmCachePolicyStateOf<GmmLib::GmmGen10CachePolicy>(pGmmCachePolicy, pState, Restore);
+            break;
+        case IGFX_GEN9_CORE:
+            __GmmCachePolicyStateOf<GmmLib::GmmGen9CachePolicy>(pGmmCachePolicy, pState, Restore);
+            break;
+        default:
+            __GmmCachePolicyStateOf<GmmLib::GmmGen8CachePolicy>(pGmmCachePolicy, pState, Restore);
+            break;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function to restore the cache policy state of the GmmLib::Context from
+/// an on-disk snapshot. Must be called after the cache policy object is created.
+/// @param[in]  Platform: ref to platform
+/// @return     GMM_SUCCESS if the state was restored, GMM_ERROR otherwise in which
+///             case the caller has to do a full InitCachePolicy()
+/////////////////////////////////////////////////////////////////////////////////////
+GMM_STATUS GMM_STDCALL GmmLib::Context::LoadContextSnapshot(const PLATFORM &Platform)
+{
+    char        Path[GMM_CONTEXT_SNAPSHOT_PATH_MAX];
+    const char *pDir   = getenv(GMM_CONTEXT_SNAPSHOT_ENV);
+    uint64_t    Key    = 0;
+    GMM_STATUS  Status = GMM_ERROR;
+    struct stat FileStat;
+    int         Fd;
+    void *      pMapping;
+
+    __GMM_ASSERTPTR(pGmmCachePolicy, GMM_ERROR);
+
+    // Snapshots are disabled unless GMM_CONTEXT_SNAPSHOT_DIR is set
+    if(!pDir || !*pDir)
+    {
+        return GMM_ERROR;
+    }
+
+    Key = __GmmSnapshotGetKey(Platform, this);
+
+    if(!__GmmSnapshotGetPath(pDir, Key, Path, sizeof(Path)))
+    {
+        return GMM_ERROR;
+    }
+
+    Fd = open(Path, O_RDONLY | O_CLOEXEC);
+    if(Fd < 0)
+    {
+        return GMM_ERROR;
+    }
+
+    if((fstat(Fd, &FileStat) != 0) || (FileStat.st_size != sizeof(GMM_CONTEXT_SNAPSHOT)))
+    {
+        GMM_DPF(GFXDBG_NORMAL, "%s: Ignoring snapshot %s with unexpected size\n", __FUNCTION__, Path);
+        close(Fd);
+        return GMM_ERROR;
+    }
+
+    pMapping = mmap(NULL, sizeof(GMM_CONTEXT_SNAPSHOT), PROT_READ, MAP_PRIVATE, Fd, 0);
+    close(Fd);
+    if(pMapping == MAP_FAILED)
+    {
+        return GMM_ERROR;
+    }
+
+    const GMM_CONTEXT_SNAPSHOT *pSnapshot = static_cast<const GMM_CONTEXT_SNAPSHOT *>(pMapping);
+    const uint8_t *             pPayload  = static_cast<const uint8_t *>(pMapping) + GMM_CONTEXT_SNAPSHOT_PAYLOAD_OFFSET;
+
+    if((pSnapshot->Magic == GMM_CONTEXT_SNAPSHOT_MAGIC) &&
+       (pSnapshot->Version == GMM_CONTEXT_SNAPSHOT_VERSION) &&
+       (pSnapshot->Size == sizeof(GMM_CONTEXT_SNAPSHOT)) &&
+       (pSnapshot->Key == Key) &&
+       (pSnapshot->PayloadChecksum == __GmmSnapshotHash(Key, pPayload, sizeof(GMM_CONTEXT_SNAPSHOT) - GMM_CONTEXT_SNAPSHOT_PAYLOAD_OFFSET)))
+    {
+        memcpy(CachePolicy, pSnapshot->CachePolicy, sizeof(CachePolicy));
+        memcpy(CachePolicyTbl, pSnapshot->CachePolicyTbl, sizeof(CachePolicyTbl));
+        memcpy(PrivatePATTable, pSnapshot->PrivatePATTable, sizeof(PrivatePATTable));
+        GMM_CACHE_POLICY_STATE CachePolicyState = pSnapshot->CachePolicyState;
+        __GmmCachePolicyState(this, &CachePolicyState, true);
+
+        Status = GMM_SUCCESS;
+    }
+    else
+    {
+        GMM_DPF(GFXDBG_NORMAL, "%s: Snapshot %s does not match, falling back to full init\n", __FUNCTION__, Path);
+    }
+
+    munmap(pMapping, sizeof(GMM_CONTEXT_SNAPSHOT));
+
+    return Status;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function to write the initialized cache policy state of the
+/// GmmLib::Context to disk. The file is written under a temporary name and renamed
+/// so concurrent processes never observe a partial snapshot. Failures are ignored.
+/// @param[in]  Platform: ref to platform
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::Context::SaveContextSnapshot(const PLATFORM &Platform)
+{
+    char                  Path[GMM_CONTEXT_SNAPSHOT_PATH_MAX];
+    char                  TmpPath[GMM_CONTEXT_SNAPSHOT_PATH_MAX];
+    const char *          pDir = getenv(GMM_CONTEXT_SNAPSHOT_ENV);
+    uint64_t              Key  = 0;
+    GMM_CONTEXT_SNAPSHOT *pSnapshot;
+    bool                  Written = false;
+    int                   Fd;
+
+    __GMM_ASSERTPTR(pGmmCachePolicy, VOIDRETURN);
+
+    // Snapshots are disabled unless GMM_CONTEXT_SNAPSHOT_DIR is set
+    if(!pDir || !*pDir)
+    {
+        return;
+    }
+
+    Key = __GmmSnapshotGetKey(Platform, this);
+
+    if(!__GmmSnapshotGetPath(pDir, Key, Path, sizeof(Path)))
+    {
+        return;
+    }
+
+    int Len = snprintf(TmpPath, sizeof(TmpPath), "%s.%d.tmp", Path, (int)getpid());
+    if(Len <= 0 || (size_t)Len >= sizeof(TmpPath))
+    {
+        return;
+    }
+
+    pSnapshot = (GMM_CONTEXT_SNAPSHOT *)calloc(1, sizeof(GMM_CONTEXT_SNAPSHOT));
+    if(!pSnapshot)
+    {
+        return;
+    }
+
+    pSnapshot->Magic   = GMM_CONTEXT_SNAPSHOT_MAGIC;
+    pSnapshot->Version = GMM_CONTEXT_SNAPSHOT_VERSION;
+    pSnapshot->Key     = Key;
+    pSnapshot->Size    = sizeof(GMM_CONTEXT_SNAPSHOT);
+    __GmmCachePolicyState(this, &pSnapshot->CachePolicyState, false);
+    memcpy(pSnapshot->CachePolicy, CachePolicy, sizeof(CachePolicy));
+    memcpy(pSnapshot->CachePolicyTbl, CachePolicyTbl, sizeof(CachePolicyTbl));
+    memcpy(pSnapshot->PrivatePATTable, PrivatePATTable, sizeof(PrivatePATTable));
+    pSnapshot->PayloadChecksum = __GmmSnapshotHash(Key, reinterpret_cast<uint8_t *>(pSnapshot) + GMM_CONTEXT_SNAPSHOT_PAYLOAD_OFFSET,
+                                                   sizeof(GMM_CONTEXT_SNAPSHOT) - GMM_CONTEXT_SNAPSHOT_PAYLOAD_OFFSET);
+
+    Fd = open(TmpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(Fd >= 0)
+    {
+        Written = (write(Fd, pSnapshot, sizeof(GMM_CONTEXT_SNAPSHOT)) == (ssize_t)sizeof(GMM_CONTEXT_SNAPSHOT));
+        close(Fd);
+
+        if(!Written || (rename(TmpPath, Path) != 0))
+        {
+            unlink(TmpPath);
+            Written = false;
+        }
+    }
+
+    GMM_DPF(GFXDBG_NORMAL, "%s: %s snapshot %s\n", __FUNCTION__, Written ? "Wrote" : "Failed to write", Path);
+
+    free(pSnapshot);
+}
+
+#else
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Context snapshots are only supported for the Linux UMD.
+/////////////////////////////////////////////////////////////////////////////////////
+GMM_STATUS GMM_STDCALL GmmLib::Context::LoadContextSnapshot(const PLATFORM &Platform)
+{
+    GMM_UNREFERENCED_PARAMETER(Platform);
+    return GMM_ERROR;
+}
+
+void GMM_STDCALL GmmLib::Context::SaveContextSnapshot(const PLATFORM &Platform)
+{
+    GMM_UNREFERENCED_PARAMETER(Platform);
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*==============================================================================
+Copyright(c) 2017 Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files(the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and / or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+============================================================================*/
+
+
+#include "Internal/Common/GmmLibInc.h"
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @file GmmHeapStats.cpp
+/// @brief Reporting of GmmMemAllocator heap usage by category. The counters are kept
+///        by GmmMemAllocator (GmmMemAllocator.cpp) for the whole module; debug builds
+///        also keep a list of outstanding blocks which is dumped when a lib context is
+///        destroyed.
+/////////////////////////////////////////////////////////////////////////////////////
+
+#define GMM_HEAP_DUMP_MAX_BLOCKS 64
+
+static const char *const GmmHeapCategoryName[GMM_HEAP_CATEGORY_MAX] =
+{
+    "Other",
+    "ResourceInfo",
+    "PageTable",
+    "Context",
+    "CachePolicy",
+    "Log",
+};
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function to write the module's heap usage (GMM_HEAP_TRACK_STATS builds) to
+/// GmmLog and, in debug builds, the allocations still outstanding. Called at the end
+/// of DestroyContext, so the dump still includes the lib context itself and anything
+/// owned by other contexts.
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::Context::LogHeapStats()
+{
+    GMM_HEAP_STATS Stats;
+
+    GmmMemAllocator::GetHeapStats(&Stats);
+
+    for(uint32_t i = 0; i < GMM_HEAP_CATEGORY_MAX; i++)
+    {
+        const GMM_HEAP_CATEGORY_STATS *pCategory = &Stats.Category[i];
+
+        GMM_LOG_INFO_IF(pCategory->TotalObjects, "HeapStats: %-12s cur %llu B / %llu objs peak %llu B / %llu objs total %llu objs\n",
+                        GmmHeapCategoryName[i],
+                        (unsigned long long)pCategory->CurrentBytes,
+                        (unsigned long long)pCategory->CurrentObjects,
+                        (unsigned long long)pCategory->PeakBytes,
+                        (unsigned long long)pCategory->PeakObjects,
+                        (unsigned long long)pCategory->TotalObjects);
+    }
+
+    // Logging allocates, so snapshot the list and log after
+    GmmMemAllocator::GMM_HEAP_BLOCK_INFO Blocks[GMM_HEAP_DUMP_MAX_BLOCKS];
+    uint32_t                             Count = GmmMemAllocator::GetOutstandingBlocks(Blocks, GMM_HEAP_DUMP_MAX_BLOCKS);
+
+    for(uint32_t i = 0; i < GFX_MIN(Count, GMM_HEAP_DUMP_MAX_BLOCKS); i++)
+    {
+        GMM_LOG_INFO("HeapStats: outstanding %p %-12s %llu B seq %llu\n",
+                     Blocks[i].ptr,
+                     (Blocks[i].Category < GMM_HEAP_CATEGORY_MAX) ? GmmHeapCategoryName[Blocks[i].Category] : "?",
+                     (unsigned long long)Blocks[i].Size,
+                     (unsigned long long)Blocks[i].Seq);
+    }
+    GMM_LOG_INFO_IF(Count > GMM_HEAP_DUMP_MAX_BLOCKS, "HeapStats: ... %u more outstanding\n", Count - GMM_HEAP_DUMP_MAX_BLOCKS);
+}
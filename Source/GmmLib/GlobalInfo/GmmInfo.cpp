@@ -52,8 +52,8 @@ GMM_MUTEX_HANDLE      GmmLib::Context::SingletonContextSyncMutex = PTHREAD_MUTEX
 /// 7  Ex: N UMD clients querying GmmLib for an GPU Adapter's Properties will have the
 ///    Same/Single LibContext and Unique N ClientContexts for that same adpater, on
 ///    same process.
-/// 8. GmmLib is dynamically scalable for any number of GPU Adapters and any number
-///    of Clients per Adapter.
+/// 8. GmmLib supports up to MAX_NUM_ADAPTERS GPU Adapters and any number of Clients
+///    per Adapter. Adapter lookups and Client ref counting are lock-free.
 /// 9. In Multiprocessing, for a process, the Gmmlib Multi-Adpater Context
 ///    object is protected/syncronized using the Lock/UnLockMAContextSyncMutex
 /// 9. In Multiprocessing, for a process with Gmmlib Multi-Adpater Context the
@@ -73,7 +73,7 @@ extern "C" GMM_LIB_API_CONSTRUCTOR void GmmCreateMultiAdapterContext()
     {
         // This is called only during dll load
         // Initializes the MA context.
-	pGmmMALibContext = new GMM_MA_LIB_CONTEXT();
+	pGmmMALibContext = new(GMM_HEAP_CONTEXT) GMM_MA_LIB_CONTEXT();
     }
 }
 
@@ -89,7 +89,7 @@ extern "C" GMM_LIB_API_DESTRUCTOR void GmmDestroyMultiAdapterContext()
     {
         // Before destroying GmmMultiAdapterContext, check if all the Adapters have
         // their GmmLibContext destroyed.
-        // At this point the linked list is empty and pHeadNode = NULL & NumAdapter=0.
+        // At this point all AdapterInfo slots are free & NumAdapter=0.
 	if(!pGmmMALibContext->GetNumAdapters())
         {
             delete pGmmMALibContext;
@@ -134,11 +134,13 @@ extern "C" GMM_STATUS GMM_STDCALL GmmCreateLibContext(const PLATFORM Platform,
     __GMM_ASSERTPTR(pWaTable, GMM_ERROR);
     __GMM_ASSERTPTR(pGtSysInfo, GMM_ERROR);
 
-    GMM_STATUS         Status = GMM_SUCCESS;
-    SKU_FEATURE_TABLE *skuTable;
-    WA_TABLE *         waTable;
-    GT_SYSTEM_INFO *   sysInfo;
-    GMM_LIB_CONTEXT *  pGmmLibContext = NULL;
+    GMM_STATUS                Status = GMM_SUCCESS;
+    SKU_FEATURE_TABLE *       skuTable;
+    WA_TABLE *                waTable;
+    GT_SYSTEM_INFO *          sysInfo;
+    GMM_LIB_CONTEXT *         pGmmLibContext = NULL;
+    GmmLib::GMM_ADAPTER_INFO *pNode          = NULL;
+    GmmLib::InitPhaseTimer    CreateTimer(NULL, GMM_INIT_PHASE_CREATE_LIB_CONTEXT);
 
     skuTable = (SKU_FEATURE_TABLE *)pSkuTable;
     waTable  = (WA_TABLE *)pWaTable;
@@ -150,10 +152,21 @@ extern "C" GMM_STATUS GMM_STDCALL GmmCreateLibContext(const PLATFORM Platform,
         return GMM_ERROR;
     }
 
-    GMM_STATUS SyncLockStatus = pGmmMALibContext->LockMAContextSyncMutex();
-    if(SyncLockStatus == GMM_SUCCESS)
+    // Fast path, the requested Adapter already has a LibContext.
+    // Take a reference without the MA context lock.
+    if(pGmmMALibContext->IncrementRefCountIfActive(sBdf))
     {
-        // Create the dynamic vectored linked list to register each new BDF.
+        return GMM_SUCCESS;
+    }
+
+    while(1)
+    {
+        if(pGmmMALibContext->LockMAContextSyncMutex() != GMM_SUCCESS)
+        {
+            return GMM_ERROR;
+        }
+
+        // Register the new BDF in the AdapterInfo table.
 	Status = pGmmMALibContext->IntializeAdapterInfo(sBdf);
         if(GMM_SUCCESS != Status)
         {
@@ -161,57 +174,100 @@ extern "C" GMM_STATUS GMM_STDCALL GmmCreateLibContext(const PLATFORM Platform,
             return GMM_ERROR;
         }
 
-        int32_t ContextRefCount = pGmmMALibContext->IncrementRefCount(sBdf);
-        if(ContextRefCount)
+        if(pGmmMALibContext->IncrementRefCountIfActive(sBdf))
         {
-            // The requested Adapter is already registered.
+            // The requested Adapter got registered by another client since the fast path.
             // Do not create new LibContext.
             // Use the one already created.
 	    pGmmMALibContext->UnLockMAContextSyncMutex();
             return GMM_SUCCESS;
         }
-        // Requested Adapter is new, Lets create a new LibContext
-	pGmmLibContext = new GMM_LIB_CONTEXT();
-        if(!pGmmLibContext)
+
+        pNode = (GmmLib::GMM_ADAPTER_INFO *)pGmmMALibContext->GetAdapterNode(sBdf);
+        if(pNode->InitState != GmmLib::GMM_ADAPTER_INITIALIZING)
         {
-            pGmmMALibContext->DecrementRefCount(sBdf);
-            pGmmMALibContext->ReleaseAdapterInfo(sBdf);
-            pGmmMALibContext->UnLockMAContextSyncMutex();
-            return GMM_ERROR;
+            // Requested Adapter is new, this client creates its LibContext
+            break;
         }
 
-        Status = (pGmmLibContext->InitContext(Platform, skuTable, waTable, sysInfo, GMM_KMD_VISTA));
-
-#if LHDM
-        // Intialize SingletonContext Data.
-        // ProcessHeap creation requires size and GfxAddress parameters. These parameters are constants
-        // and are given by GMM lib internally by PageTableMgr. Hence pHeapObj should be created here at the
-        // time of SingletonContext creation. But untill all UMD clients have moved to GMM DLL, then we will
-        // create this here.
-        pGmmLibContext->pHeapObj           = NULL;
-        pGmmLibContext->ProcessHeapCounter = 0;
-
-        // ProcessVA Gfx partition should be created here using VirtualAlloc at the time of SingletonContext
-        // creation. But untill all UMD clients have moved to GMM DLL, then we will
-        // create this here.
-        pGmmLibContext->ProcessVA        = {0};
-        pGmmLibContext->ProcessVACounter = 0;
-
-        pGmmLibContext->IsSVMReserved = 0;
-#endif
-
-        pGmmLibContext->sBdf = sBdf;
+        // Another client is creating this Adapter's LibContext. Wait on the Adapter's
+        // own lock instead of the MA context lock, then retry. InitWaiters keeps the
+        // Adapter slot (and its lock) alive while waiting.
+        pNode->InitWaiters++;
+        pGmmMALibContext->UnLockMAContextSyncMutex();
 
-        pGmmMALibContext->SetAdapterLibContext(sBdf, pGmmLibContext);
+        pGmmMALibContext->LockSingletonContextSyncMutex(sBdf);
+        pGmmMALibContext->UnlockSingletonContextSyncMutex(sBdf);
 
+        pGmmMALibContext->LockMAContextSyncMutex();
+        pNode->InitWaiters--;
         pGmmMALibContext->UnLockMAContextSyncMutex();
 
-        return Status;
+        if(pGmmMALibContext->IncrementRefCountIfActive(sBdf))
+        {
+            return GMM_SUCCESS;
+        }
     }
-    else
+
+    // Hold the Adapter's lock for the LibContext creation and drop the MA context
+    // lock, so that other Adapters initialize in parallel.
+    pNode->InitState = GmmLib::GMM_ADAPTER_INITIALIZING;
+    pGmmMALibContext->LockSingletonContextSyncMutex(sBdf);
+    pGmmMALibContext->UnLockMAContextSyncMutex();
+
+    pGmmLibContext = new(GMM_HEAP_CONTEXT) GMM_LIB_CONTEXT();
+    if(!pGmmLibContext)
     {
+        pGmmMALibContext->LockMAContextSyncMutex();
+        pNode->InitState = GmmLib::GMM_ADAPTER_UNINITIALIZED;
+        pGmmMALibContext->UnlockSingletonContextSyncMutex(sBdf);
+        // Waiters retry the creation themselves, the last one out frees the slot
+        if(!pNode->InitWaiters)
+        {
+            pGmmMALibContext->ReleaseAdapterInfo(sBdf);
+        }
+        pGmmMALibContext->UnLockMAContextSyncMutex();
         return GMM_ERROR;
     }
+    CreateTimer.SetLibContext(pGmmLibContext);
+
+    Status = (pGmmLibContext->InitContext(Platform, skuTable, waTable, sysInfo, GMM_KMD_VISTA));
+
+#if LHDM
+    // Intialize SingletonContext Data.
+    // ProcessHeap creation requires size and GfxAddress parameters. These parameters are constants
+    // and are given by GMM lib internally by PageTableMgr. Hence pHeapObj should be created here at the
+    // time of SingletonContext creation. But untill all UMD clients have moved to GMM DLL, then we will
+    // create this here.
+    pGmmLibContext->pHeapObj           = NULL;
+    pGmmLibContext->ProcessHeapCounter = 0;
+
+    // ProcessVA Gfx partition should be created here using VirtualAlloc at the time of SingletonContext
+    // creation. But untill all UMD clients have moved to GMM DLL, then we will
+    // create this here.
+    pGmmLibContext->ProcessVA        = {0};
+    pGmmLibContext->ProcessVACounter = 0;
+
+    pGmmLibContext->IsSVMReserved = 0;
+#endif
+
+    pGmmLibContext->sBdf = sBdf;
+
+    pGmmMALibContext->LockMAContextSyncMutex();
+
+    pGmmMALibContext->SetAdapterLibContext(sBdf, pGmmLibContext);
+    pNode->InitState = GmmLib::GMM_ADAPTER_READY;
+
+    // Publish the LibContext to the lock-free fast path
+    pGmmMALibContext->IncrementRefCount(sBdf);
+
+    pGmmMALibContext->UnLockMAContextSyncMutex();
+    pGmmMALibContext->UnlockSingletonContextSyncMutex(sBdf);
+
+    CreateTimer.Stop();
+    pGmmLibContext->LogInitStats();
+
+    return Status;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -227,6 +283,13 @@ extern "C" void GMM_STDCALL GmmLibContextFree(ADAPTER_BDF sBdf)
     {
         __GMM_ASSERTPTR(pGmmMALibContext->GetAdapterLibContext(sBdf), VOIDRETURN);
 
+        // Fast path, other clients still use this LibContext.
+        // Drop the reference without the MA context lock.
+        if(pGmmMALibContext->DecrementRefCountIfShared(sBdf))
+        {
+            return;
+        }
+
         GMM_STATUS SyncLockStatus = pGmmMALibContext->LockMAContextSyncMutex();
         if(SyncLockStatus == GMM_SUCCESS)
         {
@@ -240,8 +303,21 @@ extern "C" void GMM_STDCALL GmmLibContextFree(ADAPTER_BDF sBdf)
                 pGmmMALibContext->GetAdapterLibContext(sBdf)->DestroyContext();
                 // Delete/free the LibContext object
                 delete pGmmMALibContext->GetAdapterLibContext(sBdf);
-                // Delete/free the AdapterNode from the Linked List
-                pGmmMALibContext->ReleaseAdapterInfo(sBdf);
+
+                GmmLib::GMM_ADAPTER_INFO *pNode = (GmmLib::GMM_ADAPTER_INFO *)pGmmMALibContext->GetAdapterNode(sBdf);
+                if(pNode->InitWaiters)
+                {
+                    // Clients still waiting on the Adapter's lock look the slot up
+                    // again, keep it (and its lock) alive. They retry the creation
+                    // themselves.
+                    pGmmMALibContext->SetAdapterLibContext(sBdf, NULL);
+                    pNode->InitState = GmmLib::GMM_ADAPTER_UNINITIALIZED;
+                }
+                else
+                {
+                    // Free the Adapter slot in the AdapterInfo table
+                    pGmmMALibContext->ReleaseAdapterInfo(sBdf);
+                }
             }
             // RefCount !=0
             // Retain the same LibContext and the Adapter Node
@@ -261,15 +337,13 @@ GmmLib::GmmMultiAdapterContext::GmmMultiAdapterContext()
     NumAdapters     = 0;
     pCpuReserveBase = NULL;
     CpuReserveSize  = 0;
-    // The Multi-Adapter Initialization is done dynamiclly using a Single Linked list Vector
-    // pHeadNode points to the root node of the linked list and registers the first
-    // adapter received from UMD.
-    // Initializing to NULL at DLL load.
-    pHeadNode = NULL;
+    // Adapters are registered in the fixed AdapterInfo table. A slot with
+    // KeyRefCount = 0 is free; all slots are free at DLL load.
+    memset(AdapterInfo, 0, sizeof(AdapterInfo));
 
     // Initializes the GmmLib::GmmMultiAdapterContext sync Mutex
     // This is required whenever any update has to be done Multiadapter context
-    // This includes Addition, deletion and search operations of the GMM_ADAPTER_INFO linked list
+    // This includes Addition and deletion of GMM_ADAPTER_INFO slots, lookups are lock-free
 
     MAContextSyncMutex = PTHREAD_MUTEX_INITIALIZER;
 }
@@ -285,192 +359,102 @@ GmmLib::GmmMultiAdapterContext::~GmmMultiAdapterContext()
 
 /////////////////////////////////////////////////////////////////////////////////////
 /// Member function of GmmMultiAdapterContext class for initializing Adapter details
+/// Must be called with MAContextSyncMutex held.
 ///
 /// @param[in]  sBdf       : Adpater Bus, Device and Function details
 /// @return     GMM_STATUS
 /////////////////////////////////////////////////////////////////////////////////////
 GMM_STATUS GMM_STDCALL GmmLib::GmmMultiAdapterContext::IntializeAdapterInfo(ADAPTER_BDF sBdf)
 {
-    GMM_STATUS        Status = GMM_SUCCESS;
-    uint32_t          i      = 0;
-    GMM_ADAPTER_INFO *pNode = NULL, *pPrev = NULL;
-
-    // Create the Root Node
-    // If the list is empty, this is the first adapter initialization. This node will
-    // be root node of the list. Any further Adapter additions will be appeneded to this
-    // list i.e pNext
-    if(!pHeadNode)
-    {
-        pNode = (GMM_ADAPTER_INFO *)malloc(sizeof(GMM_ADAPTER_INFO));
-        if(pNode)
-        {
-            NumAdapters++;
-
-            pNode->sBdf.Bus      = sBdf.Bus;
-            pNode->sBdf.Device   = sBdf.Device;
-            pNode->sBdf.Function = sBdf.Function;
-
-            //Protect this adapter node with the sync mutex. Initialize sync mutex
-            pNode->SyncMutex     = PTHREAD_MUTEX_INITIALIZER;
+    GMM_ADAPTER_INFO *pNode = NULL;
+    uint32_t          i     = 0;
 
-            pNode->pGmmLibContext = NULL;
-            pNode->RefCount       = 0;
-            pNode->pNext          = NULL;
+    // Adapter is already active in MA context.
+    // Going forward, Lets just incremnent the number of clients using this libContext
+    // i.e Increment the RefCount in on this sBdf Adapter Node
+    if(GetAdapterNode(sBdf))
+    {
+        return GMM_SUCCESS;
+    }
 
-            pHeadNode = pNode;
-        }
-        else
+    // New Adapter, the UMD might have requested this for the first time on a new GPU
+    // adpater, or the LibContext of this adapter was already destroyed before.
+    for(i = 0; i < MAX_NUM_ADAPTERS; i++)
+    {
+        if(!AdapterInfo[i].KeyRefCount)
         {
-            // No memory for new node, return error
-            Status = GMM_ERROR;
+            pNode = &AdapterInfo[i];
+            break;
         }
     }
-    else
-    {
-        // This happens if atleast 1 adapter is still registered in a Gmmlib
-        // MA context.
 
-        pNode = pHeadNode;
-        // Check if the Adapter Node already exists in the list
-        // Search the list if the Adapter is already registerted or not.
-        while(pNode)
-        {
-            if((sBdf.Bus == pNode->sBdf.Bus) &&
-               (sBdf.Device == pNode->sBdf.Device) &&
-               (sBdf.Function == pNode->sBdf.Function))
-            {
-                break;
-            }
-            else
-            {
-                pPrev = pNode;
-                pNode = pNode->pNext;
-            }
-        }
+    if(!pNode)
+    {
+        GMM_DPF_CRITICAL("Exceeded MAX_NUM_ADAPTERS");
+        return GMM_ERROR;
+    }
 
-        // New Adapter adding to the list, add it to the end
-        // After search, If pNode = NULL, It means that
-        // The requested adapter is not yet registered before. An UMD might have
-        // requested this for the first time on a new GPU adpater, Or
-        // Requested Adapter LibContext have been already destroyed/Un-registered
-        // for the same adpater before.
-        if(!pNode)
-        {
-            pNode = (GMM_ADAPTER_INFO *)malloc(sizeof(GMM_ADAPTER_INFO));
-            if(pNode)
-            {
-                NumAdapters++;
+    NumAdapters++;
 
-                pNode->sBdf.Bus      = sBdf.Bus;
-                pNode->sBdf.Device   = sBdf.Device;
-                pNode->sBdf.Function = sBdf.Function;
+    pNode->sBdf.Bus      = sBdf.Bus;
+    pNode->sBdf.Device   = sBdf.Device;
+    pNode->sBdf.Function = sBdf.Function;
 
-                //Protect this adapter node with the sync mutex. Initialize sync mutex
-                pNode->SyncMutex = PTHREAD_MUTEX_INITIALIZER;
+    //Protect this adapter node with the sync mutex. Initialize sync mutex
+    pNode->SyncMutex = PTHREAD_MUTEX_INITIALIZER;
 
-                pNode->pGmmLibContext = NULL;
-                pNode->RefCount       = 0;
-                pNode->pNext          = NULL;
+    pNode->pGmmLibContext = NULL;
+    pNode->InitState      = GMM_ADAPTER_UNINITIALIZED;
+    pNode->InitWaiters    = 0;
 
-                // Add the new node at the end
-                // Appending the newly created Adapter Node to the end of the list.
-                pPrev->pNext = pNode;
-            }
-            else
-            {
-                // No memory for new node, return error
-                Status = GMM_ERROR;
-            }
-        }
-        else // Adapter node already exists in the list
-        {
-            // Already intialized, do nothing
-            // Adapter is already active in MA context.
-            // Going forward, Lets just incremnent the number of clients using this libContext
-            // i.e Increment the RefCount in on this sBdf Adapter Node
-        }
-    }
+    // Publish the slot to the lock-free lookups with RefCount = 0
+    GMM_ADAPTER_STORE_RELEASE(&pNode->KeyRefCount, GMM_ADAPTER_KEY(sBdf) << 32);
 
-    return Status;
+    return GMM_SUCCESS;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
 /// Member function of GmmMultiAdapterContext class for releasing Adapter Node
+/// Must be called with MAContextSyncMutex held.
 ///
 /// @param[in]  sBdf       : Adpater Bus, Device and Fucntion details
-/// @return     Void       : Deletes the Adpter Node either at Head, Tail or in between
+/// @return     Void       : Frees the Adapter's slot in the AdapterInfo table
 /////////////////////////////////////////////////////////////////////////////////////
 void GMM_STDCALL GmmLib::GmmMultiAdapterContext::ReleaseAdapterInfo(ADAPTER_BDF sBdf)
 {
-    GMM_ADAPTER_INFO *pNode = NULL, *pPrev = NULL;
-
-    pNode = pHeadNode;
-
-    // Search the linked list for the node with the sBdf value to be freed
-    while(pNode)
-    {
-        if((sBdf.Bus == pNode->sBdf.Bus) &&
-           (sBdf.Device == pNode->sBdf.Device) &&
-           (sBdf.Function == pNode->sBdf.Function))
-        {
-            // If sBdf was registered as the first Node i.e HeadNode
-            // Delete the first Node and make the second node as HeadNode
-            if(pNode == pHeadNode)
-            {
-                pHeadNode = pNode->pNext;
-            }
-            else
-            {
-                // If Adapter sBdf was registered as second Node or any in-between node or the Tail Node,
-                // Delete this Adapter Node and connect the adjacent Nodes if second or Middle
-                // i.e pNode->pNext != NULL,
-                // Or
-                // Completely delete the tail Node, i.e. pNode->pNext = NULL, if its a Tail Node.
-                pPrev->pNext = pNode->pNext;
-            }
-            // Decrement the Adapter Node count tracker variable
-            NumAdapters--;
+    GMM_ADAPTER_INFO *pNode = (GMM_ADAPTER_INFO *)GetAdapterNode(sBdf);
 
-            break;
-        }
-        else
-        {
-            // If sBdf is not registered as this pNode, then search next Node
-            // Do this till the end of the list if necessary
-            pPrev = pNode;
-            pNode = pNode->pNext;
-        }
-    }
-
-    // Free the deleted Node above.
-    // This can either be HeadNode, TailNode or Any node between Head and Tail
     if(pNode)
     {
+        // Unpublish first so lock-free lookups and ref count updates miss the slot
+        GMM_ADAPTER_STORE_RELEASE(&pNode->KeyRefCount, 0);
+
         pNode->pGmmLibContext = NULL;
-        pNode->pNext          = NULL;
-        pNode->RefCount       = 0;
+        pNode->InitState      = GMM_ADAPTER_UNINITIALIZED;
 
         // Close the Mutex protecting thsi Adapter node
         pthread_mutex_destroy(&pNode->SyncMutex);
 
-        free(pNode);
+        // Decrement the Adapter Node count tracker variable
+        NumAdapters--;
     }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
 /// Member function of GmmMultiAdapterContext class for returning the AdapterIdx
+/// Lock-free.
 ///
 /// @param[in]  sBdf       : Adpater Bus, Device and Fucntion details
-/// @return     Adpater Idx corresponding the given BDF.
+/// @return     Adpater Idx corresponding the given BDF, MAX_NUM_ADAPTERS if not found.
 /////////////////////////////////////////////////////////////////////////////////////
 uint32_t GMM_STDCALL GmmLib::GmmMultiAdapterContext::GetAdapterIndex(ADAPTER_BDF sBdf)
 {
+    uint64_t Key        = GMM_ADAPTER_KEY(sBdf);
     uint32_t AdapterIdx = 0;
+
     for(AdapterIdx = 0; AdapterIdx < MAX_NUM_ADAPTERS; AdapterIdx++)
     {
-        if((sBdf.Bus == AdapterInfo[AdapterIdx].sBdf.Bus) &&
-           (sBdf.Device == AdapterInfo[AdapterIdx].sBdf.Device) &&
-           (sBdf.Function == AdapterInfo[AdapterIdx].sBdf.Function))
+        if((GMM_ADAPTER_LOAD_ACQUIRE(&AdapterInfo[AdapterIdx].KeyRefCount) >> 32) == Key)
         {
             break;
         }
@@ -703,35 +687,18 @@ GMM_STATUS GMM_STDCALL GmmLib::GmmMultiAdapterContext::UnlockSingletonContextSyn
 
 /////////////////////////////////////////////////////////////////////////////////////
 /// Member function of GmmMultiAdapterContext class for returning the Adapter Node
+/// Lock-free, the slot's KeyRefCount is published last by IntializeAdapterInfo.
+/// The returned node stays valid as long as the caller holds a reference on the
+/// adapter or the MAContextSyncMutex.
 ///
 /// @param[in]  sBdf       : Adpater Bus, Device and Fucntion details
 /// @return     Adpater Node corresponding the given BDF or return NULL if not found
 /////////////////////////////////////////////////////////////////////////////////////
 void *GMM_STDCALL GmmLib::GmmMultiAdapterContext::GetAdapterNode(ADAPTER_BDF sBdf)
 {
-    GMM_ADAPTER_INFO *pNode = NULL;
-
-    pNode = pHeadNode;
-    // Search the entire linked list if the Adapter Node with sBdf is found or not
-    while(pNode)
-    {
-        if((sBdf.Bus == pNode->sBdf.Bus) &&
-           (sBdf.Device == pNode->sBdf.Device) &&
-           (sBdf.Function == pNode->sBdf.Function))
-        {
-            // Yes, Found!. This is the Adapter Node
-            // pNode != NULL, will be valid pointer.
-            break;
-        }
-        else
-        {
-            // Not found, Search Next
-            // pNode = NULL if traversed till the tail and not found
-            pNode = pNode->pNext;
-        }
-    }
+    uint32_t AdapterIdx = GetAdapterIndex(sBdf);
 
-    return pNode;
+    return (AdapterIdx < MAX_NUM_ADAPTERS) ? &AdapterInfo[AdapterIdx] : NULL;
 }
 
 
@@ -745,26 +712,24 @@ void *GMM_STDCALL GmmLib::GmmMultiAdapterContext::GetAdapterNode(ADAPTER_BDF sBd
 /// RefCount > 0, when at least one client is using the adapter's LibContext
 //
 /// @param1     sBdf        Adpater's Bus, Device and Fucntion
-/// @return     Current value of the ref count.
+/// @return     Previous value of the ref count.
 /////////////////////////////////////////////////////////////////////////////////////
 int32_t GMM_STDCALL GmmLib::GmmMultiAdapterContext::IncrementRefCount(ADAPTER_BDF sBdf)
 {
-    GMM_ADAPTER_INFO *pNode = NULL;
-
-    pNode = (GMM_ADAPTER_INFO *)GetAdapterNode(sBdf);
-    if(pNode)
-    {
-        int32_t *Ref = &pNode->RefCount;
+    return UpdateRefCount(sBdf, 1, 0);
+}
 
-#if defined(__linux__)
-        // returns 0 only when registering the first client
-        return (__sync_fetch_and_add(Ref, 1));
-#endif
-    }
-    else
-    {
-        return 0;
-    }
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function of GmmMultiAdapterContext class for Incrementing Adpater Node Ref
+/// Count only if the adapter already has an active LibContext (RefCount > 0).
+/// Lock-free fast path for clients opening an already initialized adapter.
+//
+/// @param1     sBdf        Adpater's Bus, Device and Fucntion
+/// @return     Previous value of the ref count, 0 if nothing was changed.
+/////////////////////////////////////////////////////////////////////////////////////
+int32_t GMM_STDCALL GmmLib::GmmMultiAdapterContext::IncrementRefCountIfActive(ADAPTER_BDF sBdf)
+{
+    return UpdateRefCount(sBdf, 1, 1);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -781,37 +746,72 @@ int32_t GMM_STDCALL GmmLib::GmmMultiAdapterContext::IncrementRefCount(ADAPTER_BD
 /////////////////////////////////////////////////////////////////////////////////////
 int32_t GMM_STDCALL GmmLib::GmmMultiAdapterContext::DecrementRefCount(ADAPTER_BDF sBdf)
 {
-    GMM_ADAPTER_INFO *pNode = NULL;
+    int32_t Previous = UpdateRefCount(sBdf, -1, 1);
 
-    pNode = (GMM_ADAPTER_INFO *)GetAdapterNode(sBdf);
-    if(pNode)
+    return Previous ? (Previous - 1) : 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function of GmmMultiAdapterContext class for Decrementing Adpater's Ref
+/// Count only if other clients still use the LibContext (RefCount > 1), so the
+/// last reference is always dropped under MAContextSyncMutex.
+//
+/// @param1     sBdf        Adpater's Bus, Device and Fucntion
+/// @return     Previous value of the ref count, 0 if nothing was changed.
+/////////////////////////////////////////////////////////////////////////////////////
+int32_t GMM_STDCALL GmmLib::GmmMultiAdapterContext::DecrementRefCountIfShared(ADAPTER_BDF sBdf)
+{
+    return UpdateRefCount(sBdf, -1, 2);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function of GmmMultiAdapterContext class to atomically add Delta to an
+/// adapter's RefCount. The BDF key and the count share one 64 bit word, so the
+/// update fails instead of landing on a slot that was released and reused for
+/// another adapter in the meantime.
+//
+/// @param1     sBdf        Adpater's Bus, Device and Fucntion
+/// @param2     Delta       +1 or -1
+/// @param3     MinCount    update only if the current count is >= MinCount
+/// @return     Previous value of the ref count, 0 if nothing was changed.
+/////////////////////////////////////////////////////////////////////////////////////
+int32_t GMM_STDCALL GmmLib::GmmMultiAdapterContext::UpdateRefCount(ADAPTER_BDF sBdf, int32_t Delta, int32_t MinCount)
+{
+    uint64_t Key = GMM_ADAPTER_KEY(sBdf);
+    uint64_t CurrentValue, TargetValue;
+    int32_t  RefCount;
+
+    for(uint32_t AdapterIdx = 0; AdapterIdx < MAX_NUM_ADAPTERS; AdapterIdx++)
     {
-        int32_t *Ref          = &pNode->RefCount;
-	int      CurrentValue = 0;
-        int      TargetValue  = 0;
+        volatile uint64_t *Ref = &AdapterInfo[AdapterIdx].KeyRefCount;
+
         do
         {
-            CurrentValue = *Ref;
-            if(CurrentValue > 0)
+            CurrentValue = GMM_ADAPTER_LOAD_ACQUIRE(Ref);
+            if((CurrentValue >> 32) != Key)
             {
-                TargetValue = CurrentValue - 1;
+                break;
             }
-            else
+
+            RefCount = (int32_t)(CurrentValue & 0xFFFFFFFF);
+            if(RefCount < MinCount)
             {
-                break;
+                return 0;
             }
+            TargetValue = (Key << 32) | (uint32_t)(RefCount + Delta);
 #if defined(_WIN32)
-        } while(!(InterlockedCompareExchange((LONG *)Ref, TargetValue, CurrentValue) == CurrentValue));
-#elif defined(__linux__) 
+        } while(!(InterlockedCompareExchange64((LONG64 *)Ref, TargetValue, CurrentValue) == (LONG64)CurrentValue));
+#else
         } while(!__sync_bool_compare_and_swap(Ref, CurrentValue, TargetValue));
 #endif
 
-        return TargetValue;
-    }
-    else
-    {
-        return 0;
+        if((CurrentValue >> 32) == Key)
+        {
+            return RefCount;
+        }
     }
+
+    return 0;
 }
 
 #ifdef _WIN32
@@ -991,6 +991,7 @@ GmmLib::Context::Context()
 {
     memset(CachePolicy, 0, sizeof(CachePolicy));
     memset(CachePolicyTbl, 0, sizeof(CachePolicyTbl));
+    memset(&InitStats, 0, sizeof(InitStats));
 
     //Default initialize 64KB Page padding percentage.
     AllowedPaddingFor64KbPagesPercentage = 10;
@@ -1000,6 +1001,19 @@ GmmLib::Context::Context()
 #if(!defined(__GMM_KMD__) && !defined(GMM_UNIFIED_LIB))
     pGmmGlobalClientContext = NULL;
 #endif
+
+#if GMM_CONTEXT_LAZY_INIT
+    memset((void *)SubsystemState, 0, sizeof(SubsystemState));
+#if _WIN32
+    SubsystemLock = ::CreateMutex(NULL, false, NULL);
+#else
+    pthread_mutexattr_t Attr;
+    pthread_mutexattr_init(&Attr);
+    pthread_mutexattr_settype(&Attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&SubsystemLock, &Attr);
+    pthread_mutexattr_destroy(&Attr);
+#endif
+#endif
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -1007,6 +1021,13 @@ GmmLib::Context::Context()
 /////////////////////////////////////////////////////////////////////////////////////
 GmmLib::Context::~Context()
 {
+#if GMM_CONTEXT_LAZY_INIT
+#if _WIN32
+    ::CloseHandle(SubsystemLock);
+#else
+    pthread_mutex_destroy(&SubsystemLock);
+#endif
+#endif
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -1026,6 +1047,8 @@ const WA_TABLE *         pWaTable,
 const GT_SYSTEM_INFO *   pGtSysInfo,
 GMM_CLIENT               ClientType)
 {
+    InitPhaseTimer PhaseTimer(this, GMM_INIT_PHASE_INIT_CONTEXT);
+
     this->ClientType = ClientType;
 
     // Save the SKU and WA
@@ -1037,30 +1060,156 @@ GMM_CLIENT               ClientType)
 
     OverrideSkuWa();
 
-  
-    this->pGmmCachePolicy = CreateCachePolicyCommon();
-    if(this->pGmmCachePolicy == NULL)
+#if(!GMM_CONTEXT_LAZY_INIT)
+    if(BuildCachePolicy(Platform) != GMM_SUCCESS)
     {
         return GMM_ERROR;
     }
 
-    this->pGmmCachePolicy->InitCachePolicy();
-
-    this->pTextureCalc = CreateTextureCalc(Platform, false);
+    {
+        InitPhaseTimer TextureCalcTimer(this, GMM_INIT_PHASE_CREATE_TEXTURE_CALC);
+        this->pTextureCalc = CreateTextureCalc(Platform, false);
+    }
     if(this->pTextureCalc == NULL)
     {
         return GMM_ERROR;
     }
+#endif
+
+    // With GMM_CONTEXT_LAZY_INIT the cache policy and texture calculator are
+    // built by InitSubsystem() on first access, so this only covers platform info.
+    GMM_DPF(GFXDBG_NORMAL, "%s: Context init took %llu us\n", __FUNCTION__,
+            (unsigned long long)(PhaseTimer.GetElapsedNs() / 1000));
 
     return GMM_SUCCESS;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function to create the cache policy object and fill the context's
+/// cache policy, TBL and PAT tables.
+/// @param[in]  Platform: ref to platform
+/// @return   GMM_SUCCESS if init is success, GMM_ERROR otherwise
+/////////////////////////////////////////////////////////////////////////////////////
+GMM_STATUS GMM_STDCALL GmmLib::Context::BuildCachePolicy(const PLATFORM &Platform)
+{
+    bool           FromSnapshot;
+    InitPhaseTimer PhaseTimer(this, GMM_INIT_PHASE_INIT_CACHE_POLICY);
+
+    this->pGmmCachePolicy = CreateCachePolicyCommon();
+    if(this->pGmmCachePolicy == NULL)
+    {
+        return GMM_ERROR;
+    }
+
+    // Opt-in (GMM_CONTEXT_SNAPSHOT_DIR): reuse the cache policy computed by an
+    // earlier process with identical inputs, otherwise build and save it.
+    FromSnapshot = (LoadContextSnapshot(Platform) == GMM_SUCCESS);
+    if(!FromSnapshot)
+    {
+        this->pGmmCachePolicy->InitCachePolicy();
+        SaveContextSnapshot(Platform);
+    }
+
+    GMM_DPF(GFXDBG_NORMAL, "%s: Cache policy built from %s\n", __FUNCTION__,
+            FromSnapshot ? "snapshot" : "full init");
+
+    return GMM_SUCCESS;
+}
+
+#if GMM_CONTEXT_LAZY_INIT
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function to build a context subsystem on first use. Safe to call from
+/// any thread; the builder itself may re-enter through the context getters, which
+/// then see the raw (partially filled) tables instead of recursing.
+/// @param[in]  Subsystem: subsystem to be built
+/// @return   GMM_SUCCESS if the subsystem is built, GMM_ERROR otherwise. A failed
+///           subsystem stays not ready and is retried on the next access.
+/////////////////////////////////////////////////////////////////////////////////////
+GMM_STATUS GMM_STDCALL GmmLib::Context::InitSubsystem(GMM_CONTEXT_SUBSYSTEM Subsystem)
+{
+    GMM_STATUS Status = GMM_SUCCESS;
+
+    __GMM_ASSERT(Subsystem < GMM_CONTEXT_SUBSYSTEM_MAX);
+
+#if _WIN32
+    if(SubsystemState[Subsystem] == SUBSYSTEM_READY) // volatile read has acquire semantics
+#else
+    if(__atomic_load_n(&SubsystemState[Subsystem], __ATOMIC_ACQUIRE) == SUBSYSTEM_READY)
+#endif
+    {
+        return GMM_SUCCESS;
+    }
+
+#if _WIN32
+    while(WAIT_OBJECT_0 != ::WaitForSingleObject(SubsystemLock, INFINITE))
+        ;
+#else
+    pthread_mutex_lock(&SubsystemLock);
+#endif
+
+    // Skip if already built by another thread or being built further up this stack
+    if(SubsystemState[Subsystem] != SUBSYSTEM_NOT_READY)
+    {
+        goto Unlock;
+    }
+
+    // InitContext() has not run yet
+    if(pPlatformInfo == NULL)
+    {
+        Status = GMM_ERROR;
+        goto Unlock;
+    }
+
+    SubsystemState[Subsystem] = SUBSYSTEM_IN_PROGRESS;
+
+    switch(Subsystem)
+    {
+        case GMM_CONTEXT_SUBSYSTEM_CACHE_POLICY:
+            Status = BuildCachePolicy(GetPlatformInfo().Platform);
+            break;
+        case GMM_CONTEXT_SUBSYSTEM_TEXTURE_CALC:
+        {
+            InitPhaseTimer PhaseTimer(this, GMM_INIT_PHASE_CREATE_TEXTURE_CALC);
+            this->pTextureCalc = CreateTextureCalc(GetPlatformInfo().Platform, false);
+            Status             = (this->pTextureCalc != NULL) ? GMM_SUCCESS : GMM_ERROR;
+            break;
+        }
+        default:
+            break;
+    }
+
+    if(Status != GMM_SUCCESS)
+    {
+        GMM_DPF_CRITICAL("unable to build context subsystem");
+        SubsystemState[Subsystem] = SUBSYSTEM_NOT_READY;
+        goto Unlock;
+    }
+
+#if _WIN32
+    InterlockedExchange((LONG *)&SubsystemState[Subsystem], SUBSYSTEM_READY);
+#else
+    __atomic_store_n(&SubsystemState[Subsystem], SUBSYSTEM_READY, __ATOMIC_RELEASE);
+#endif
+
+Unlock:
+#if _WIN32
+    ::ReleaseMutex(SubsystemLock);
+#else
+    pthread_mutex_unlock(&SubsystemLock);
+#endif
+
+    return Status;
+}
+#endif
+
 /////////////////////////////////////////////////////////////////////////////////////
 /// Member function to deallcoate the GmmLib::Context's cache policy, platform info,
 /// Texture calculator etc.
 /////////////////////////////////////////////////////////////////////////////////////
 void GMM_STDCALL GmmLib::Context::DestroyContext()
 {
+    InitPhaseTimer PhaseTimer(this, GMM_INIT_PHASE_DESTROY_CONTEXT);
+
     if(this->pGmmCachePolicy)
     {
             delete this->pGmmCachePolicy;
@@ -1078,6 +1227,14 @@ void GMM_STDCALL GmmLib::Context::DestroyContext()
             delete this->pPlatformInfo;
             this->pPlatformInfo = NULL;
     }
+
+#if GMM_CONTEXT_LAZY_INIT
+    memset((void *)SubsystemState, 0, sizeof(SubsystemState));
+#endif
+
+    PhaseTimer.Stop();
+    LogInitStats();
+    LogHeapStats();
 }
 
 void GMM_STDCALL GmmLib::Context::OverrideSkuWa()
@@ -1106,7 +1263,7 @@ GMM_CACHE_POLICY *GMM_STDCALL GmmLib::Context::CreateCachePolicyCommon()
 
     if((GFX_GET_CURRENT_PRODUCT(GetPlatformInfo().Platform) == IGFX_METEORLAKE))
     {
-        pGmmCachePolicy = new GmmLib::GmmXe_LPGCachePolicy(CachePolicy, this);
+        pGmmCachePolicy = new(GMM_HEAP_CACHE_POLICY) GmmLib::GmmXe_LPGCachePolicy(CachePolicy, this);
     }
     else
     {
@@ -1119,24 +1276,24 @@ GMM_CACHE_POLICY *GMM_STDCALL GmmLib::Context::CreateCachePolicyCommon()
             case IGFX_XE_HPC_CORE:
                 if(GetSkuTable().FtrLocalMemory)
                 {
-                    pGmmCachePolicy = new GmmLib::GmmGen12dGPUCachePolicy(CachePolicy, this);
+                    pGmmCachePolicy = new(GMM_HEAP_CACHE_POLICY) GmmLib::GmmGen12dGPUCachePolicy(CachePolicy, this);
                 }
                 else
                 {
-                    pGmmCachePolicy = new GmmLib::GmmGen12CachePolicy(CachePolicy, this);
+                    pGmmCachePolicy = new(GMM_HEAP_CACHE_POLICY) GmmLib::GmmGen12CachePolicy(CachePolicy, this);
                 }
                 break;
             case IGFX_GEN11_CORE:
-                pGmmCachePolicy = new GmmLib::GmmGen11CachePolicy(CachePolicy, this);
+                pGmmCachePolicy = new(GMM_HEAP_CACHE_POLICY) GmmLib::GmmGen11CachePolicy(CachePolicy, this);
                 break;
             case IGFX_GEN10_CORE:
-                pGmmCachePolicy = new GmmLib::GmmGen10CachePolicy(CachePolicy, this);
+                pGmmCachePolicy = new(GMM_HEAP_CACHE_POLICY) GmmLib::GmmGen10CachePolicy(CachePolicy, this);
                 break;
             case IGFX_GEN9_CORE:
-                pGmmCachePolicy = new GmmLib::GmmGen9CachePolicy(CachePolicy, this);
+                pGmmCachePolicy = new(GMM_HEAP_CACHE_POLICY) GmmLib::GmmGen9CachePolicy(CachePolicy, this);
                 break;
             default:
-                pGmmCachePolicy = new GmmLib::GmmGen8CachePolicy(CachePolicy, this);
+                pGmmCachePolicy = new(GMM_HEAP_CACHE_POLICY) GmmLib::GmmGen8CachePolicy(CachePolicy, this);
                 break;
         }
     }
@@ -0,0 +1,193 @@
+/*==============================================================================
+Copyright(c) 2017 Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files(the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and / or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+============================================================================*/
+
+
+#include "Internal/Common/GmmLibInc.h"
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @file GmmInitStats.cpp
+/// @brief Per phase wall-clock, CPU time and allocation accounting for lib context
+///        creation and destruction. Read back with GmmLib::Context::GetInitStats()
+///        and written to GmmLog (Info level) when a context is created or destroyed.
+/////////////////////////////////////////////////////////////////////////////////////
+
+#if(!defined(__GMM_KMD__))
+#include <chrono>
+#ifndef _WIN32
+#include <time.h>
+#endif
+#endif
+
+static const char *const GmmInitPhaseName[GMM_INIT_PHASE_MAX] =
+{
+    "CreateLibContext",
+    "InitContext",
+    "InitCachePolicy",
+    "SetUpMOCSTable",
+    "SetupPAT",
+    "CreateTextureCalc",
+    "DestroyContext",
+};
+
+//=============================================================================
+//
+// Function: __GmmGetWallTimeNs
+//
+// Desc: Monotonic wall-clock time
+//
+// Returns: time in ns, 0 where no clock is available (KMD)
+//-----------------------------------------------------------------------------
+static uint64_t __GmmGetWallTimeNs()
+{
+#if(!defined(__GMM_KMD__))
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+           .count();
+#else
+    return 0;
+#endif
+}
+
+//=============================================================================
+//
+// Function: __GmmGetThreadCpuTimeNs
+//
+// Desc: CPU time (user + kernel) consumed by the calling thread
+//
+// Returns: time in ns, 0 where not available (KMD)
+//-----------------------------------------------------------------------------
+static uint64_t __GmmGetThreadCpuTimeNs()
+{
+#if defined(__GMM_KMD__)
+    return 0;
+#elif defined(_WIN32)
+    FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+    if(!GetThreadTimes(GetCurrentThread(), &CreationTime, &ExitTime, &KernelTime, &UserTime))
+    {
+        return 0;
+    }
+    return ((((uint64_t)KernelTime.dwHighDateTime << 32) | KernelTime.dwLowDateTime) +
+            (((uint64_t)UserTime.dwHighDateTime << 32) | UserTime.dwLowDateTime)) * 100;
+#else
+    struct timespec Ts;
+    if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Ts))
+    {
+        return 0;
+    }
+    return (uint64_t)Ts.tv_sec * 1000000000ull + (uint64_t)Ts.tv_nsec;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Starts timing a phase
+/// @param[in]  pGmmLibContext: context the phase is accounted to
+/// @param[in]  Phase: phase being timed
+/////////////////////////////////////////////////////////////////////////////////////
+GmmLib::InitPhaseTimer::InitPhaseTimer(Context *pGmmLibContext, GMM_INIT_PHASE Phase)
+    : pGmmLibContext(pGmmLibContext),
+      Phase(Phase)
+{
+    StartAllocCount = GmmMemAllocator::AllocCount();
+    StartCpuTimeNs  = __GmmGetThreadCpuTimeNs();
+    StartWallTimeNs = __GmmGetWallTimeNs();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Records the phase unless it was already stopped
+/////////////////////////////////////////////////////////////////////////////////////
+GmmLib::InitPhaseTimer::~InitPhaseTimer()
+{
+    Stop();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Stops timing and records the phase into the context's init stats. Later calls
+/// are no-ops.
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::InitPhaseTimer::Stop()
+{
+    uint64_t WallTimeNs = GetElapsedNs();
+    uint64_t CpuTimeNs  = __GmmGetThreadCpuTimeNs() - StartCpuTimeNs;
+
+    if(pGmmLibContext)
+    {
+        pGmmLibContext->RecordInitPhase(Phase, WallTimeNs, CpuTimeNs, GmmMemAllocator::AllocCount() - StartAllocCount);
+        pGmmLibContext = NULL;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Returns the wall-clock time since the timer was started
+/// @return   elapsed time in ns
+/////////////////////////////////////////////////////////////////////////////////////
+uint64_t GMM_STDCALL GmmLib::InitPhaseTimer::GetElapsedNs()
+{
+    return __GmmGetWallTimeNs() - StartWallTimeNs;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function to accumulate the cost of one run of a phase. The allocation
+/// count is module wide, so it includes allocations made by other threads while
+/// the phase was running.
+/// @param[in]  Phase: phase that ran
+/// @param[in]  WallTimeNs: wall-clock time of the run
+/// @param[in]  CpuTimeNs: thread CPU time of the run
+/// @param[in]  AllocCount: GmmMemAllocator allocations during the run
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::Context::RecordInitPhase(GMM_INIT_PHASE Phase, uint64_t WallTimeNs, uint64_t CpuTimeNs, uint64_t AllocCount)
+{
+    __GMM_ASSERT(Phase < GMM_INIT_PHASE_MAX);
+
+    GMM_INIT_PHASE_STATS *pPhase = &InitStats.Phase[Phase];
+
+    pPhase->Count++;
+    pPhase->WallTimeNs += WallTimeNs;
+    pPhase->CpuTimeNs += CpuTimeNs;
+    pPhase->AllocCount += AllocCount;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Returns the per phase creation/destruction cost of this context.
+/// Lazily built subsystems show up once they have been accessed.
+/// @return   init stats
+/////////////////////////////////////////////////////////////////////////////////////
+const GMM_INIT_STATS &GMM_STDCALL GmmLib::Context::GetInitStats()
+{
+    return (InitStats);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Member function to write the phases that ran so far to GmmLog
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::Context::LogInitStats()
+{
+    for(uint32_t i = 0; i < GMM_INIT_PHASE_MAX; i++)
+    {
+        const GMM_INIT_PHASE_STATS *pPhase = &InitStats.Phase[i];
+
+        GMM_LOG_INFO_IF(pPhase->Count, "InitStats: %-18s count %u wall %llu ns cpu %llu ns allocs %llu\n",
+                        GmmInitPhaseName[i], pPhase->Count,
+                        (unsigned long long)pPhase->WallTimeNs,
+                        (unsigned long long)pPhase->CpuTimeNs,
+                        (unsigned long long)pPhase->AllocCount);
+    }
+}
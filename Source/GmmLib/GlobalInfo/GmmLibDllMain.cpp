@@ -40,9 +40,26 @@ OTHER DEALINGS IN THE SOFTWARE.
 /////////////////////////////////////////////////////////////////////////////////////
 extern "C" GMM_LIB_API GMM_STATUS GMM_STDCALL InitializeGmm(GMM_INIT_IN_ARGS *pInArgs, 
 		                                              GMM_INIT_OUT_ARGS *pOutArgs)
+{
+    return InitializeGmmWithAllocator(pInArgs, pOutArgs, NULL);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+// Same as InitializeGmm, client context's internal allocations (context itself,
+// resource infos, page-table manager) go through pAllocatorCb. pfnResetArena, if
+// set, is called from GmmAdapterDestroy once the client context is freed.
+/////////////////////////////////////////////////////////////////////////////////////
+extern "C" GMM_LIB_API GMM_STATUS GMM_STDCALL InitializeGmmWithAllocator(GMM_INIT_IN_ARGS *                  pInArgs,
+                                                                         GMM_INIT_OUT_ARGS *                 pOutArgs,
+                                                                         const GmmClientAllocationCallbacks *pAllocatorCb)
 {
     GMM_STATUS Status = GMM_ERROR;
 
+    if(pAllocatorCb && (!pAllocatorCb->pfnAllocation || !pAllocatorCb->pfnFree))
+    {
+        return GMM_INVALIDPARAM;
+    }
+
     if(pInArgs && pOutArgs)
     {
 #if GMM_LIB_DLL_MA
@@ -59,8 +76,8 @@ extern "C" GMM_LIB_API GMM_STATUS GMM_STDCALL InitializeGmm(GMM_INIT_IN_ARGS *pI
 
         if(Status == GMM_SUCCESS)
         {
-            pOutArgs->pGmmClientContext = GmmCreateClientContextForAdapter(pInArgs->ClientType,
-			                                                          stAdapterBDF);
+            pOutArgs->pGmmClientContext = GmmCreateClientContextWithAllocator(pInArgs->ClientType,
+                                                                              stAdapterBDF, pAllocatorCb);
         }
 
 #endif
@@ -49,7 +49,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmResCreate(GMM_RESCREATE_PARAMS *pCreateParams,
     }
     else
     {
-        if((pRes = new GMM_RESOURCE_INFO) == NULL)
+        if((pRes = new(GMM_HEAP_RESOURCE_INFO) GMM_RESOURCE_INFO) == NULL)
         {
             GMM_ASSERTDPF(0, "Allocation failed!");
             goto ERROR_CASE;
@@ -96,7 +96,7 @@ GMM_RESOURCE_INFO *GMM_STDCALL GmmResCopy(GMM_RESOURCE_INFO *pRes)
     return pResCopy;
 #else
 
-    pResCopy = new GMM_RESOURCE_INFO;
+    pResCopy = new(GMM_HEAP_RESOURCE_INFO) GMM_RESOURCE_INFO;
 
     if(!pResCopy)
     {
@@ -427,6 +427,11 @@ GMM_STATUS GMM_STDCALL GmmLib::GmmResourceInfoCommon::Create(Context &GmmLibCont
     pGmmUmdLibContext = reinterpret_cast<uint64_t>(&GmmLibContext);
     __GMM_ASSERTPTR(pGmmUmdLibContext, GMM_ERROR);
 
+    if(CreateParams.Flags.Info.OptimizeTilingForSize)
+    {
+        SelectTilingForSize(GmmLibContext, CreateParams);
+    }
+
     if(CreateParams.Flags.Info.ExistingSysMem &&
        (CreateParams.Flags.Info.TiledW ||
         CreateParams.Flags.Info.TiledX ||
@@ -2270,3 +2275,126 @@ uint32_t GMM_STDCALL GmmLib::GmmResourceInfoCommon::GetMipDepth(uint32_t MipLeve
     GMM_TEXTURE_CALC *pTextureCalc = GMM_OVERRIDE_TEXTURE_CALC(&Surf, GetGmmLibContext());
     return pTextureCalc->GmmTexGetMipDepth(&Surf, MipLevel);
 }
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Returns the size of the chroma planes of a planar surface relative to its luma
+/// plane, from the format's subsampling.
+/// @param[in] Format: Planar format
+/// @param[in] LumaSize: Size of the tightly packed luma plane
+/// @return    Size of the tightly packed chroma planes
+/////////////////////////////////////////////////////////////////////////////////////
+static GMM_GFX_SIZE_T GmmGetPlanarChromaSize(GMM_RESOURCE_FORMAT Format, GMM_GFX_SIZE_T LumaSize)
+{
+    switch(Format)
+    {
+        case GMM_FORMAT_YVU9: // 4x4 subsampled
+            return LumaSize / 8;
+        case GMM_FORMAT_P208: // Horizontally or vertically subsampled
+        case GMM_FORMAT_MFX_JPEG_YUV422H:
+        case GMM_FORMAT_MFX_JPEG_YUV422V:
+            return LumaSize;
+        case GMM_FORMAT_RGBP: // Full size
+        case GMM_FORMAT_BGRP:
+        case GMM_FORMAT_MFX_JPEG_YUV444:
+            return LumaSize * 2;
+        default: // 4:2:0, NV11 and 4:1:1
+            return LumaSize / 2;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Explains the resource's size: how many bytes its texels need and how much of the
+/// allocation is alignment, mip tail, layout and page-size padding or aux data.
+/// The padding split is derived from mip dimensions and alignments, each term is
+/// clamped so the main surface parts always add up to Surf.Size.
+/// @param[out] pSizeInfo: Size breakdown
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmLib::GmmResourceInfoCommon::GetSizeInfo(GMM_RESOURCE_SIZE_INFO *pSizeInfo)
+{
+    __GMM_ASSERTPTR(pSizeInfo, VOIDRETURN);
+
+    const GMM_PLATFORM_INFO &Platform = GetPlatformInfo();
+    const GMM_FORMAT_ENTRY & Entry    = Platform.FormatTable[(Surf.Format < GMM_RESOURCE_FORMATS) ? Surf.Format : GMM_FORMAT_INVALID];
+    uint32_t                 ElementW = GFX_MAX(Entry.Element.Width, 1);
+    uint32_t                 ElementH = GFX_MAX(Entry.Element.Height, 1);
+    uint32_t                 ElementD = GFX_MAX(Entry.Element.Depth, 1);
+    uint32_t                 Slices   = GFX_MAX(Surf.ArraySize, 1) * ((Surf.Type == RESOURCE_CUBE) ? 6 : 1) * GFX_MAX(Surf.MSAA.NumSamples, 1);
+    GMM_GFX_SIZE_T           Logical = 0, Aligned = 0, TailUsed = 0, TailSize = 0;
+
+    memset(pSizeInfo, 0, sizeof(*pSizeInfo));
+    pSizeInfo->Type     = Surf.Type;
+    pSizeInfo->Format   = Surf.Format;
+    pSizeInfo->TileMode = Surf.TileMode;
+
+    if(GMM_IS_PLANAR(Surf.Format))
+    {
+        GMM_GFX_SIZE_T LumaSize = (Surf.BaseWidth * Surf.BitsPerPixel >> 3) * Surf.BaseHeight;
+
+        Logical = (LumaSize + GmmGetPlanarChromaSize(Surf.Format, LumaSize)) * Slices;
+        Aligned = Logical;
+    }
+    else
+    {
+        bool     MipTail  = (Surf.Flags.Info.TiledYf || GMM_IS_64KB_TILE(Surf.Flags)) &&
+                            (Surf.Alignment.MipTailStartLod <= Surf.MaxLod);
+        uint32_t MaxLod   = (Surf.Type == RESOURCE_BUFFER) ? 0 : Surf.MaxLod;
+        uint32_t BytesPer = Surf.BitsPerPixel >> 3;
+
+        for(uint32_t Lod = 0; Lod <= MaxLod; Lod++)
+        {
+            GMM_GFX_SIZE_T Width  = GetMipWidth(Lod);
+            GMM_GFX_SIZE_T Height = GetMipHeight(Lod);
+            GMM_GFX_SIZE_T Depth  = (Surf.Type == RESOURCE_3D) ? GetMipDepth(Lod) : 1;
+            GMM_GFX_SIZE_T Size, AlignedSize;
+
+            Size = GFX_CEIL_DIV(Width, ElementW) * GFX_CEIL_DIV(Height, ElementH) *
+                   GFX_CEIL_DIV(Depth, ElementD) * BytesPer * Slices;
+            AlignedSize = GFX_CEIL_DIV(GFX_ALIGN_NP2(Width, GFX_MAX(Surf.Alignment.HAlign, 1)), ElementW) *
+                          GFX_CEIL_DIV(GFX_ALIGN_NP2(Height, GFX_MAX(Surf.Alignment.VAlign, 1)), ElementH) *
+                          GFX_CEIL_DIV(GFX_ALIGN_NP2(Depth, GFX_MAX(Surf.Alignment.DAlign, 1)), ElementD) * BytesPer * Slices;
+
+            Logical += Size;
+
+            // Mips in the tail are packed into the tail tile rather than aligned
+            if(MipTail && (Lod >= Surf.Alignment.MipTailStartLod))
+            {
+                Aligned += Size;
+                TailUsed += Size;
+            }
+            else
+            {
+                Aligned += AlignedSize;
+            }
+        }
+
+        if(MipTail)
+        {
+            // The tail gets one tile per slice (and per tile depth of a 3D surface)
+            const GMM_TILE_INFO &Tile      = Platform.TileInfo[Surf.TileMode];
+            uint32_t             TailDepth = (Surf.Type == RESOURCE_3D) ?
+                                             GFX_CEIL_DIV(GetMipDepth(Surf.Alignment.MipTailStartLod), GFX_MAX(Tile.LogicalTileDepth, 1)) :
+                                             1;
+
+            TailSize = (GMM_GFX_SIZE_T)Tile.LogicalSize * TailDepth * Slices;
+        }
+    }
+
+    pSizeInfo->MainSurfaceSize = Surf.Size;
+    pSizeInfo->LogicalSize     = GFX_MIN(Logical, Surf.Size);
+    pSizeInfo->AlignPadding    = GFX_MIN(Aligned - GFX_MIN(Logical, Aligned), Surf.Size - pSizeInfo->LogicalSize);
+    pSizeInfo->MipTailPadding  = GFX_MIN(TailSize - GFX_MIN(TailUsed, TailSize),
+                                        Surf.Size - pSizeInfo->LogicalSize - pSizeInfo->AlignPadding);
+    pSizeInfo->LayoutPadding   = Surf.Size - pSizeInfo->LogicalSize - pSizeInfo->AlignPadding - pSizeInfo->MipTailPadding;
+
+    GMM_GFX_SIZE_T AuxTotal = AuxSurf.Size + AuxSecSurf.Size;
+
+    pSizeInfo->ClearColorSize = GFX_MIN(AuxSurf.CCSize, AuxSurf.Size);
+    pSizeInfo->AuxSize        = AuxSurf.UnpaddedSize ?
+                                GFX_MIN(AuxSurf.UnpaddedSize, AuxSurf.Size - pSizeInfo->ClearColorSize) :
+                                (AuxSurf.Size - pSizeInfo->ClearColorSize);
+    pSizeInfo->AuxSize += AuxSecSurf.Size;
+    pSizeInfo->AuxPadding = AuxTotal - pSizeInfo->AuxSize - pSizeInfo->ClearColorSize;
+
+    pSizeInfo->AllocationSize  = GetSizeAllocation();
+    pSizeInfo->PageSizePadding = pSizeInfo->AllocationSize - (Surf.Size + AuxTotal);
+}
@@ -363,6 +363,167 @@ bool GmmLib::GmmResourceInfoCommon::CopyClientParams(GMM_RESCREATE_PARAMS &Creat
     return true;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+/// Picks the tiling for Flags.Info.OptimizeTilingForSize resources: lays the
+/// resource out with each legal candidate tiling and replaces the tiling flags
+/// in CreateParams with the candidate CreateParams.pTilingSearch->Policy selects
+/// (smallest allocation if no search info is given). Client tiling preferences
+/// are ignored. Resources whose tiling is dictated by their usage (display,
+/// depth/stencil, MSAA, compression, planar, tiled resources, ExistingSysMem)
+/// keep the normal selection and report no candidates.
+///
+/// @param[in]      GmmLibContext: Lib context the resource is created in
+/// @param[in/out]  CreateParams: Flags which specify what sort of resource to create
+/////////////////////////////////////////////////////////////////////////////////////
+void GmmLib::GmmResourceInfoCommon::SelectTilingForSize(Context &GmmLibContext, GMM_RESCREATE_PARAMS &CreateParams)
+{
+    const SKU_FEATURE_TABLE &SkuTable = GmmLibContext.GetSkuTable();
+    GMM_TILING_SEARCH        DefaultSearch = {};
+    GMM_TILING_SEARCH *      pSearch       = CreateParams.pTilingSearch ? CreateParams.pTilingSearch : &DefaultSearch;
+    GMM_RESOURCE_FLAG        Tilings[GMM_MAX_TILING_CANDIDATES];
+    GMM_RESOURCE_FLAG        Flags[GMM_MAX_TILING_CANDIDATES];
+    uint32_t                 NumTilings = 0, Smallest = 0, i;
+    uint32_t                 BitsPerPixel;
+    GFXCORE_FAMILY           RenderCore = GFX_GET_CURRENT_RENDERCORE(GmmLibContext.GetPlatformInfo().Platform);
+
+    CreateParams.Flags.Info.OptimizeTilingForSize = 0;
+    pSearch->NumCandidates                        = 0;
+    pSearch->Selected                             = 0;
+
+    if((CreateParams.Format <= GMM_FORMAT_INVALID) ||
+       (CreateParams.Format >= GMM_RESOURCE_FORMATS) ||
+       !((CreateParams.Type == RESOURCE_2D) ||
+         (CreateParams.Type == RESOURCE_CUBE) ||
+         (CreateParams.Type == RESOURCE_3D)) ||
+       (CreateParams.MSAA.NumSamples > 1) ||
+       CreateParams.Flags.Info.ExistingSysMem ||
+       CreateParams.Flags.Info.StdSwizzle ||
+       CreateParams.Flags.Info.RenderCompressed ||
+       CreateParams.Flags.Info.MediaCompressed ||
+       CreateParams.Flags.Gpu.Depth ||
+       CreateParams.Flags.Gpu.SeparateStencil ||
+       CreateParams.Flags.Gpu.HiZ ||
+       CreateParams.Flags.Gpu.CCS ||
+       CreateParams.Flags.Gpu.MCS ||
+       CreateParams.Flags.Gpu.UnifiedAuxSurface ||
+       CreateParams.Flags.Gpu.FlipChain ||
+       CreateParams.Flags.Gpu.Overlay ||
+       CreateParams.Flags.Gpu.Presentable ||
+       CreateParams.Flags.Gpu.TiledResource ||
+       GmmIsPlanar(CreateParams.Format) ||
+       GmmIsYUVPacked(CreateParams.Format))
+    {
+        return;
+    }
+
+    BitsPerPixel = GmmLibContext.GetPlatformInfo().FormatTable[CreateParams.Format].Element.BitsPer;
+
+    // Candidates in preference order, so equal sizes keep the faster tiling.
+    memset(Tilings, 0, sizeof(Tilings));
+    Tilings[NumTilings].Info.TiledY  = SkuTable.FtrTileY;
+    Tilings[NumTilings++].Info.Tile4 = !SkuTable.FtrTileY;
+
+    if(GMM_IS_SUPPORTED_BPP_ON_TILE_64_YF_YS(BitsPerPixel) &&
+       (!SkuTable.FtrTileY || (RenderCore >= IGFX_GEN9_CORE)))
+    {
+        Tilings[NumTilings].Info.TiledY   = SkuTable.FtrTileY;
+        Tilings[NumTilings].Info.TiledYs  = SkuTable.FtrTileY;
+        Tilings[NumTilings++].Info.Tile64 = !SkuTable.FtrTileY;
+
+        if(SkuTable.FtrTileY)
+        {
+            Tilings[NumTilings].Info.TiledY  = 1;
+            Tilings[NumTilings].Info.TiledYf = 1;
+            NumTilings++;
+        }
+    }
+
+    if(CreateParams.Type != RESOURCE_3D)
+    {
+        Tilings[NumTilings++].Info.TiledX = 1;
+    }
+
+    Tilings[NumTilings++].Info.Linear = 1;
+
+    for(i = 0; i < NumTilings; i++)
+    {
+        GmmLib::GmmResourceInfo Candidate;
+        GMM_RESCREATE_PARAMS    Params = CreateParams;
+        GMM_TILING_CANDIDATE *  pCandidate;
+        uint32_t                j;
+
+        Params.Flags.Info.Linear    = Tilings[i].Info.Linear;
+        Params.Flags.Info.TiledW    = 0;
+        Params.Flags.Info.TiledX    = Tilings[i].Info.TiledX;
+        Params.Flags.Info.TiledY    = Tilings[i].Info.TiledY;
+        Params.Flags.Info.TiledYf   = Tilings[i].Info.TiledYf;
+        Params.Flags.Info.TiledYs   = Tilings[i].Info.TiledYs;
+        Params.Flags.Info.Tile4     = Tilings[i].Info.Tile4;
+        Params.Flags.Info.Tile64    = Tilings[i].Info.Tile64;
+        Params.NoGfxMemory          = 1;
+        Params.pPreallocatedResInfo = NULL;
+        Params.pTilingSearch        = NULL;
+
+        Candidate.pClientContext = pClientContext;
+        if(Candidate.Create(GmmLibContext, Params) != GMM_SUCCESS)
+        {
+            continue;
+        }
+
+        // A tiling the platform can't honor falls back to one already listed.
+        for(j = 0; j < pSearch->NumCandidates; j++)
+        {
+            if(pSearch->Candidates[j].TileMode == Candidate.Surf.TileMode)
+            {
+                break;
+            }
+        }
+        if(j < pSearch->NumCandidates)
+        {
+            continue;
+        }
+
+        pCandidate                     = &pSearch->Candidates[pSearch->NumCandidates];
+        pCandidate->TileMode           = Candidate.Surf.TileMode;
+        pCandidate->Size               = Candidate.GetSizeAllocation();
+        pCandidate->Is64KBPageSuitable = Candidate.Is64KBPageSuitable();
+        Flags[pSearch->NumCandidates]  = Params.Flags;
+
+        if(pCandidate->Size < pSearch->Candidates[Smallest].Size)
+        {
+            Smallest = pSearch->NumCandidates;
+        }
+        pSearch->NumCandidates++;
+    }
+
+    if(pSearch->NumCandidates == 0)
+    {
+        return;
+    }
+
+    pSearch->Selected = Smallest;
+
+    if(pSearch->Policy == GMM_TILING_SEARCH_PREFER_64KB)
+    {
+        GMM_GFX_SIZE_T MaxSize = pSearch->Candidates[Smallest].Size +
+                                 (pSearch->Candidates[Smallest].Size / 100) * pSearch->MaxGrowthPercent;
+        bool           Found   = false;
+
+        for(i = 0; !pSearch->Candidates[Smallest].Is64KBPageSuitable && (i < pSearch->NumCandidates); i++)
+        {
+            if(pSearch->Candidates[i].Is64KBPageSuitable &&
+               (pSearch->Candidates[i].Size <= MaxSize) &&
+               (!Found || (pSearch->Candidates[i].Size < pSearch->Candidates[pSearch->Selected].Size)))
+            {
+                pSearch->Selected = i;
+                Found             = true;
+            }
+        }
+    }
+
+    CreateParams.Flags = Flags[pSearch->Selected];
+}
+
 
 /////////////////////////////////////////////////////////////////////////////////////
 /// Validates the parameters passed in by clients to make sure they do not
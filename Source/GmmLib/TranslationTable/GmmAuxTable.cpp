@@ -29,13 +29,86 @@ Description: AUX-Table management functions
 #include "Internal/Common/GmmLibInc.h"
 #include "../TranslationTable/GmmUmdTranslationTable.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__ARM_ARCH)
+#include <sse2neon.h>
+#else
+#include <x86intrin.h>
+#endif
+
 #if !defined(__GMM_KMD__)
 
+//=============================================================================
+//
+// Function: InitNullTables
+//
+// Desc: Allocates Null L2/L1 tables (shared by all null-ccs mapped L3e/L2e) on
+//       first use, and fills them with null-ccs entries. Tables are CPU-written,
+//       they aren't referenced by Aux Table until returned.
+//
+// Caller: MapNullCCS
+//
+// Returns:
+//      GMM_SUCCESS or GMM_OUT_OF_MEMORY
+//-----------------------------------------------------------------------------
+GMM_STATUS GmmLib::AuxTable::InitNullTables()
+{
+    EnterCriticalSection(&TTLock);
+    if(!NullL1Table || !NullL2Table)
+    {
+        AllocateDummyTables(&NullL2Table, &NullL1Table);
+        if(!NullL1Table || !NullL2Table)
+        {
+            //report error
+            LeaveCriticalSection(&TTLock);
+            return GMM_OUT_OF_MEMORY;
+        }
+        else
+        {
+            //Initialize dummy table entries (one-time)
+            GMM_GFX_ADDRESS TableAddr = NullL2Table->GetCPUAddress();
+            GMM_AUXTTL2e    L2e       = {0};
+            L2e.Valid                 = 1;
+            GMM_TO_AUX_L2e_L1GFXADDR_2((NullL1Table->GetPool()->GetGfxAddress() + PAGE_SIZE * NullL1Table->GetNodeIdx()), L2e, (!WA64K(GetGmmLibContext()) && !WA16K(GetGmmLibContext()))) // populate L2e.L1GfxAddr
+            for(int i = 0; i < GMM_AUX_L2_SIZE; i++)
+            {
+                //initialize L2e ie clear Valid bit for all entries
+                ((GMM_AUXTTL2e *)TableAddr)[i].Value = L2e.Value;
+            }
+
+            TableAddr = NullL1Table->GetCPUAddress();
+
+            GMM_AUXTTL1e L1e = {0};
+            L1e.Valid        = 1;
+            if(!WA64K(GetGmmLibContext()))
+            {
+                L1e.GfxAddress = (NullCCSTile >> 12); /*********** 4kb-aligned CCS adr *****/
+            }
+            else
+            {
+                L1e.Reserved4  = (NullCCSTile >> 8);  /*********** 4 lsbs of 256B-aligned CCS adr *****/
+                L1e.GfxAddress = (NullCCSTile >> 12); /*********** 4kb-aligned CCS adr *****/
+            }
+
+            for(int i = 0; i < GMM_AUX_L1_SIZE(GetGmmLibContext()); i++)
+            {
+                //initialize L1e with null ccs tile
+                ((GMM_AUXTTL1e *)TableAddr)[i].Value = L1e.Value;
+            }
+        }
+    }
+    LeaveCriticalSection(&TTLock);
+
+    return GMM_SUCCESS;
+}
+
 //=============================================================================
 //
 // Function: MapNullCCS
 //
 // Desc: Maps given resource, with dummy null-ccs chain, on Aux Table
+//       Caller brackets Gpu-update with pfPrologTranslationTable/pfEpilogTranslationTable
 //
 // Caller: UpdateAuxTable (map op for null-tiles)
 //
@@ -53,29 +126,24 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
     GMM_GFX_ADDRESS Addr         = 0;
     GMM_GFX_ADDRESS L3GfxAddress = 0;
     GMM_CLIENT      ClientType;
+    AUX_L1_WRITE_BATCH L1Batch;
 
     GET_GMM_CLIENT_TYPE(pClientContext, ClientType);
 
-    EnterCriticalSection(&TTLock);
+    L1Batch.NumEntries = 0;
 
     DoNotWait |= (!UmdContext || !UmdContext->pCommandQueueHandle);
 
+    //L3 table lives as long as AuxTable, L2/L1 tables are updated under their L3e lock
     if(TTL3.L3Handle)
     {
         L3GfxAddress = TTL3.GfxAddress;
     }
     else
     {
-        LeaveCriticalSection(&TTLock);
         return GMM_ERROR;
     }
 
-    if(!DoNotWait)
-    {
-        PageTableMgr->TTCb.pfPrologTranslationTable(
-        UmdContext->pCommandQueueHandle);
-    }
-
     // For each L1 table
     for(Addr = GFX_ALIGN_FLOOR(BaseAdr, L1TableSize); // Start at begining of L1 table
         Addr < BaseAdr + Size;
@@ -95,6 +163,8 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
             EndAddress = BaseAdr + Size;
         }
 
+        EnterL3eLock(GMM_L3_ENTRY_IDX(AUXTT, StartAddress));
+
         GetL1L2TableAddr(StartAddress,
                          &L1GfxAddress,
                          &L2GfxAddress);
@@ -111,48 +181,11 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
             uint32_t        TableEntryIdx   = (L2GfxAddress == GMM_NO_TABLE) ? static_cast<uint32_t>(GMM_L3_ENTRY_IDX(AUXTT, StartAddress)) : static_cast<uint32_t>(GMM_L2_ENTRY_IDX(AUXTT, StartAddress));
             L2CPUAddress                    = (L2GfxAddress == GMM_NO_TABLE) ? 0 : TableCPUAddress;
 
-            if(!NullL1Table || !NullL2Table)
+            //Dummy tables are shared by all L3e, allocated once
+            if(InitNullTables() != GMM_SUCCESS)
             {
-                AllocateDummyTables(&NullL2Table, &NullL1Table);
-                if(!NullL1Table || !NullL2Table)
-                {
-                    //report error
-                    LeaveCriticalSection(&TTLock);
-                    return GMM_OUT_OF_MEMORY;
-                }
-                else
-                {
-                    //Initialize dummy table entries (one-time)
-                    GMM_GFX_ADDRESS TableAddr = NullL2Table->GetCPUAddress();
-                    GMM_AUXTTL2e    L2e       = {0};
-                    L2e.Valid                 = 1;
-                    GMM_TO_AUX_L2e_L1GFXADDR_2((NullL1Table->GetPool()->GetGfxAddress() + PAGE_SIZE * NullL1Table->GetNodeIdx()), L2e, (!WA64K(GetGmmLibContext()) && !WA16K(GetGmmLibContext()))) // populate L2e.L1GfxAddr
-                    for(int i = 0; i < GMM_AUX_L2_SIZE; i++)
-                    {
-                        //initialize L2e ie clear Valid bit for all entries
-                        ((GMM_AUXTTL2e *)TableAddr)[i].Value = L2e.Value;
-                    }
-
-                    TableAddr = NullL1Table->GetCPUAddress();
-
-                    GMM_AUXTTL1e L1e = {0};
-                    L1e.Valid        = 1;
-                    if(!WA64K(GetGmmLibContext()))
-                    {
-                        L1e.GfxAddress = (NullCCSTile >> 12); /*********** 4kb-aligned CCS adr *****/
-                    }
-                    else
-                    {
-                        L1e.Reserved4  = (NullCCSTile >> 8);  /*********** 4 lsbs of 256B-aligned CCS adr *****/
-                        L1e.GfxAddress = (NullCCSTile >> 12); /*********** 4kb-aligned CCS adr *****/
-                    }
-
-		    for(int i = 0; i < GMM_AUX_L1_SIZE(GetGmmLibContext()); i++)
-                    {
-                        //initialize L1e with null ccs tile
-                        ((GMM_AUXTTL1e *)TableAddr)[i].Value = L1e.Value;
-                    }
-                }
+                LeaveL3eLock(GMM_L3_ENTRY_IDX(AUXTT, StartAddress));
+                return GMM_OUT_OF_MEMORY;
             }
 
             if(L2GfxAddress == GMM_NO_TABLE)
@@ -181,10 +214,11 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
                 {
                     pTTL2[GMM_L3_ENTRY_IDX(AUXTT, StartAddress)].UpdatePoolFence(UmdContext, false);
                 }
-                PageTableMgr->TTCb.pfWriteL2L3Entry(UmdContext->pCommandQueueHandle,
-                                                    TableGfxAddress + TableEntryIdx * GMM_AUX_L2e_SIZE,
-                                                    Data);
+                PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                               TableGfxAddress + TableEntryIdx * GMM_AUX_L2e_SIZE,
+                                               Data);
             }
+            LeaveL3eLock(GMM_L3_ENTRY_IDX(AUXTT, StartAddress));
             continue;
         }
         else
@@ -193,6 +227,60 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
             L2CPUAddress    = pTTL2[L3eIdx].GetCPUAddress();
 
             L2eIdx = GMM_L2_ENTRY_IDX(AUXTT, StartAddress);
+
+            //Whole L1 region null-mapped: single L2e write to shared Null L1 table replaces
+            //per-entry L1e writes, and private L1 table is released. Shared table only
+            //holds null-ccs tile, so only if PartialL1e adds no format/depth bits to it
+            bool WholeL1 = (StartAddress == Addr && EndAddress == Addr + L1TableSize);
+            if(WholeL1)
+            {
+                if(InitNullTables() != GMM_SUCCESS)
+                {
+                    LeaveL3eLock(L3eIdx);
+                    return GMM_OUT_OF_MEMORY;
+                }
+                WholeL1 = ((PartialL1e | NullCCSTile | __BIT(0)) == ((GMM_AUXTTL1e *)NullL1Table->GetCPUAddress())[0].Value);
+            }
+
+            if(WholeL1)
+            {
+                GmmLib::LastLevelTable *pL1Tbl = pTTL2[L3eIdx].GetL1Table(L2eIdx);
+                GMM_AUXTTL2e            L2e    = {0};
+
+                L2e.Valid = 1;
+                GMM_TO_AUX_L2e_L1GFXADDR_2((NullL1Table->GetPool()->GetGfxAddress() + PAGE_SIZE * NullL1Table->GetNodeIdx()), L2e, (!WA64K(GetGmmLibContext()) && !WA16K(GetGmmLibContext())))
+                if(DoNotWait)
+                {
+                    //Sync update on CPU
+                    ((GMM_AUXTTL2e *)L2CPUAddress)[L2eIdx].Value = L2e.Value;
+                }
+                else
+                {
+                    pTTL2[L3eIdx].UpdatePoolFence(UmdContext, false);
+                    PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                                   L2GfxAddress + L2eIdx * GMM_AUX_L2e_SIZE,
+                                                   L2e.Value);
+                }
+
+                //Update usage for PoolNode assigned to L1Table, and free L1Tbl
+                if(pL1Tbl)
+                {
+                    GmmLib::GMM_PAGETABLEPool *PoolElem = pL1Tbl->GetPool();
+                    if(PoolElem)
+                    {
+                        if(pL1Tbl->GetBBInfo().BBQueueHandle)
+                        {
+                            PoolElem->GetNodeBBInfoAtIndex(pL1Tbl->GetNodeIdx()) = pL1Tbl->GetBBInfo();
+                        }
+                        DEASSIGN_POOLNODE(PageTableMgr, UmdContext, PoolElem, pL1Tbl->GetNodeIdx(), AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetGmmLibContext()))
+                    }
+                    ReleaseL1Table(L3eIdx, L2eIdx);
+                }
+
+                LeaveL3eLock(L3eIdx);
+                continue;
+            }
+
             if(DoNotWait)
             {
                 //Sync update on CPU
@@ -207,7 +295,7 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
                 GMM_AUXTTL3e L3e = {0};
                 L3e.Valid        = 1;
                 L3e.L2GfxAddr    = L2GfxAddress >> 15;
-                PageTableMgr->TTCb.pfWriteL2L3Entry(
+                PageTableMgr->__WriteL2L3Entry(
                 UmdContext->pCommandQueueHandle,
                 L3GfxAddress + (L3eIdx * GMM_AUX_L3e_SIZE),
                 L3e.Value);
@@ -217,7 +305,7 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
                 GMM_AUXTTL2e L2e = {0};
                 L2e.Valid        = 1;
                 GMM_TO_AUX_L2e_L1GFXADDR_2(L1GfxAddress, L2e, (!WA64K(GetGmmLibContext()) && !WA16K(GetGmmLibContext())))
-		PageTableMgr->TTCb.pfWriteL2L3Entry(
+		PageTableMgr->__WriteL2L3Entry(
                 UmdContext->pCommandQueueHandle,
                 L2GfxAddress + (L2eIdx * GMM_AUX_L2e_SIZE),
                 L2e.Value);
@@ -233,7 +321,7 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
             GMM_GFX_SIZE_T          L1eIdx = GMM_L1_ENTRY_IDX(AUXTT, TileAddr, GetGmmLibContext());
             GmmLib::LastLevelTable *pL1Tbl = NULL;
 
-            pL1Tbl       = pTTL2[GMM_AUX_L3_ENTRY_IDX(TileAddr)].GetL1Table(L2eIdx, NULL);
+            pL1Tbl       = pTTL2[GMM_AUX_L3_ENTRY_IDX(TileAddr)].GetL1Table(L2eIdx);
             L1CPUAddress = pL1Tbl->GetCPUAddress();
             if(DoNotWait)
             {
@@ -245,24 +333,23 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
             {
                 pL1Tbl->UpdatePoolFence(UmdContext, false);
 
-                /*                PageTableMgr->TTCb.pfWriteL1Entries(
-                    UmdContext->pCommandQueueHandle,
-                    2,
-                    L1GfxAddress + (L1eIdx * GMM_AUX_L1e_SIZE),
-                    (uint32_t*)(&Data));*/ //**********REQUIRE UMD CHANGE TO UPDATE 64-bit ENTRY - both DWORDs must be updated atomically*******/
-                PageTableMgr->TTCb.pfWriteL2L3Entry(
-                UmdContext->pCommandQueueHandle,
-                L1GfxAddress + (L1eIdx * GMM_AUX_L1e_SIZE),
-                Data);
+                //Coalesce contiguous L1e, flushed by FlushL1Entries
+                WriteL1Entry(UmdContext, &L1Batch, L1GfxAddress + (L1eIdx * GMM_AUX_L1e_SIZE), Data);
             }
 
             if(pL1Tbl->TrackTableUsage(AUXTT, true, TileAddr, true, GetGmmLibContext()))
             { // L1 Table is not being used anymore
                 GMM_AUXTTL2e               L2e      = {0};
                 GmmLib::GMM_PAGETABLEPool *PoolElem = NULL;
-                GmmLib::LastLevelTable *   pL1Tbl = NULL, *Prev = NULL;
+                GmmLib::LastLevelTable *   pL1Tbl   = NULL;
+
+                //Pending L1e must land before L1 table is detached and its pool node released
+                if(!DoNotWait)
+                {
+                    FlushL1Entries(UmdContext, &L1Batch);
+                }
 
-                pL1Tbl = pTTL2[GMM_L3_ENTRY_IDX(AUXTT, TileAddr)].GetL1Table(L2eIdx, &Prev);
+                pL1Tbl = pTTL2[GMM_L3_ENTRY_IDX(AUXTT, TileAddr)].GetL1Table(L2eIdx);
                 // Map L2-entry to Null-L1Table
                 L2e.Valid = 1;
                 GMM_TO_AUX_L2e_L1GFXADDR_2((NullL1Table->GetPool()->GetGfxAddress() + PAGE_SIZE * NullL1Table->GetNodeIdx()), L2e, (!WA64K(GetGmmLibContext()) && !WA16K(GetGmmLibContext()))) // populate L2e.L1GfxAddress/Le2.Reserved2
@@ -274,9 +361,9 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
                 else
                 {
                     pTTL2[GMM_L3_ENTRY_IDX(AUXTT, TileAddr)].UpdatePoolFence(UmdContext, false);
-                    PageTableMgr->TTCb.pfWriteL2L3Entry(UmdContext->pCommandQueueHandle,
-                                                        L2GfxAddress + L2eIdx * GMM_AUX_L2e_SIZE,
-                                                        L2e.Value);
+                    PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                                   L2GfxAddress + L2eIdx * GMM_AUX_L2e_SIZE,
+                                                   L2e.Value);
                 }
                 //Update usage for PoolNode assigned to L1Table, and free L1Tbl
                 if(pL1Tbl)
@@ -290,7 +377,7 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
                         }
                         DEASSIGN_POOLNODE(PageTableMgr, UmdContext, PoolElem, pL1Tbl->GetNodeIdx(), AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetGmmLibContext()))
                     }
-                    pTTL2[GMM_L3_ENTRY_IDX(AUXTT, TileAddr)].DeleteFromList(pL1Tbl, Prev);
+                    ReleaseL1Table(GMM_L3_ENTRY_IDX(AUXTT, TileAddr), L2eIdx);
                 }
 
                 // The L1 table is unused -- meaning everything else in this table is
@@ -298,15 +385,13 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
                 break;
             }
         }
-    }
 
-    if(!DoNotWait)
-    {
-        PageTableMgr->TTCb.pfEpilogTranslationTable(
-        UmdContext->pCommandQueueHandle,
-        1); // ForceFlush
+        if(!DoNotWait)
+        {
+            FlushL1Entries(UmdContext, &L1Batch);
+        }
+        LeaveL3eLock(GMM_L3_ENTRY_IDX(AUXTT, StartAddress));
     }
-    LeaveCriticalSection(&TTLock);
 
     return Status;
 }
@@ -316,6 +401,7 @@ GMM_STATUS GmmLib::AuxTable::MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX
 // Function: InvalidateTable (InvalidateMappings)
 //
 // Desc: Unmaps given resource from Aux Table; and marks affected entries as invalid
+//       Caller brackets Gpu-update with pfPrologTranslationTable/pfEpilogTranslationTable
 //
 // Caller: UpdateAuxTable (unmap op)
 //
@@ -332,34 +418,29 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
     GMM_GFX_ADDRESS Addr         = 0;
     GMM_GFX_ADDRESS L3GfxAddress = 0;
     uint8_t         isTRVA       = 0; 
+    AUX_L1_WRITE_BATCH L1Batch;
 
     GMM_CLIENT ClientType;
 
     GET_GMM_CLIENT_TYPE(pClientContext, ClientType);
 
+    L1Batch.NumEntries = 0;
+
     //NullCCSTile isn't initialized, disable TRVA path
     isTRVA = (NullCCSTile ? isTRVA : 0);
 
-    EnterCriticalSection(&TTLock);
-
     DoNotWait |= (!UmdContext || !UmdContext->pCommandQueueHandle);
 
+    //L3 table lives as long as AuxTable, L2/L1 tables are updated under their L3e lock
     if(TTL3.L3Handle)
     {
         L3GfxAddress = TTL3.GfxAddress;
     }
     else
     {
-        LeaveCriticalSection(&TTLock);
         return GMM_ERROR;
     }
 
-    if(!DoNotWait)
-    {
-        PageTableMgr->TTCb.pfPrologTranslationTable(
-        UmdContext->pCommandQueueHandle);
-    }
-
     // For each L1 table
     for(Addr = GFX_ALIGN_FLOOR(BaseAdr, L1TableSize); // Start at begining of L1 table
         Addr < BaseAdr + Size;
@@ -379,6 +460,8 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
             EndAddress = BaseAdr + Size;
         }
 
+        EnterL3eLock(GMM_L3_ENTRY_IDX(AUXTT, StartAddress));
+
         GetL1L2TableAddr(StartAddress,
                          &L1GfxAddress,
                          &L2GfxAddress);
@@ -430,10 +513,11 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
                 {
                     pTTL2[GMM_L3_ENTRY_IDX(AUXTT, StartAddress)].UpdatePoolFence(UmdContext, false);
                 }
-                PageTableMgr->TTCb.pfWriteL2L3Entry(UmdContext->pCommandQueueHandle,
-                                                    TableGfxAddress + TableEntryIdx * GMM_AUX_L2e_SIZE,
-                                                    L2e.Value);
+                PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                               TableGfxAddress + TableEntryIdx * GMM_AUX_L2e_SIZE,
+                                               L2e.Value);
             }
+            LeaveL3eLock(GMM_L3_ENTRY_IDX(AUXTT, StartAddress));
             continue;
         }
         else
@@ -456,7 +540,7 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
                 GMM_AUXTTL3e L3e = {0};
                 L3e.Valid        = 1;
                 L3e.L2GfxAddr    = L2GfxAddress >> 15;
-                PageTableMgr->TTCb.pfWriteL2L3Entry(
+                PageTableMgr->__WriteL2L3Entry(
                 UmdContext->pCommandQueueHandle,
                 L3GfxAddress + (L3eIdx * GMM_AUX_L3e_SIZE),
                 L3e.Value);
@@ -466,7 +550,7 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
                 GMM_AUXTTL2e L2e = {0};
                 L2e.Valid        = 1;
                 GMM_TO_AUX_L2e_L1GFXADDR_2(L1GfxAddress, L2e, (!WA64K(GetGmmLibContext()) && !WA16K(GetGmmLibContext())))
-		PageTableMgr->TTCb.pfWriteL2L3Entry(
+		PageTableMgr->__WriteL2L3Entry(
                 UmdContext->pCommandQueueHandle,
                 L2GfxAddress + (L2eIdx * GMM_AUX_L2e_SIZE),
                 L2e.Value);
@@ -483,7 +567,7 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
             GMM_GFX_SIZE_T          L1eIdx = GMM_L1_ENTRY_IDX(AUXTT, TileAddr, GetGmmLibContext());
             GmmLib::LastLevelTable *pL1Tbl = NULL;
 
-            pL1Tbl       = pTTL2[GMM_AUX_L3_ENTRY_IDX(TileAddr)].GetL1Table(L2eIdx, NULL);
+            pL1Tbl       = pTTL2[GMM_AUX_L3_ENTRY_IDX(TileAddr)].GetL1Table(L2eIdx);
             L1CPUAddress = pL1Tbl->GetCPUAddress();
             if(DoNotWait)
             {
@@ -496,24 +580,22 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
             {
                 pL1Tbl->UpdatePoolFence(UmdContext, false);
 
-                /*                PageTableMgr->TTCb.pfWriteL1Entries(
-                    UmdContext->pCommandQueueHandle,
-                    2,
-                    (uint32_t*)(&Data));*/
-                //**********REQUIRE UMD CHANGE TO UPDATE 64-bit ENTRY - both DWORDs must be updated atomically*******/
-                PageTableMgr->TTCb.pfWriteL2L3Entry(
-                UmdContext->pCommandQueueHandle,
-                L1GfxAddress + (L1eIdx * GMM_AUX_L1e_SIZE),
-                Data);
+                //Coalesce contiguous L1e, flushed by FlushL1Entries (merged ranges invalidate long runs)
+                WriteL1Entry(UmdContext, &L1Batch, L1GfxAddress + (L1eIdx * GMM_AUX_L1e_SIZE), Data);
             }
 
             if(pL1Tbl->TrackTableUsage(AUXTT, true, TileAddr, true, GetGmmLibContext()))
             { // L1 Table is not being used anymore
+                if(!DoNotWait)
+                {
+                    FlushL1Entries(UmdContext, &L1Batch);
+                }
+
                 GMM_AUXTTL2e               L2e      = {0};
                 GmmLib::GMM_PAGETABLEPool *PoolElem = NULL;
-                GmmLib::LastLevelTable *   pL1Tbl = NULL, *Prev = NULL;
+                GmmLib::LastLevelTable *   pL1Tbl   = NULL;
 
-                pL1Tbl = pTTL2[GMM_L3_ENTRY_IDX(AUXTT, TileAddr)].GetL1Table(L2eIdx, &Prev);
+                pL1Tbl = pTTL2[GMM_L3_ENTRY_IDX(AUXTT, TileAddr)].GetL1Table(L2eIdx);
 
                 if(isTRVA && NullL1Table &&
                    ((TileAddr > GFX_ALIGN_FLOOR(BaseAdr, L1TableSize) && TileAddr < GFX_ALIGN_NP2(BaseAdr, L1TableSize)) ||
@@ -537,9 +619,9 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
                 else
                 {
                     pTTL2[GMM_L3_ENTRY_IDX(AUXTT, TileAddr)].UpdatePoolFence(UmdContext, false);
-                    PageTableMgr->TTCb.pfWriteL2L3Entry(UmdContext->pCommandQueueHandle,
-                                                        L2GfxAddress + L2eIdx * GMM_AUX_L2e_SIZE,
-                                                        L2e.Value);
+                    PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                                   L2GfxAddress + L2eIdx * GMM_AUX_L2e_SIZE,
+                                                   L2e.Value);
                 }
                 //Update usage for PoolNode assigned to L1Table, and free L1Tbl
                 if(pL1Tbl)
@@ -553,7 +635,7 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
                         }
                         DEASSIGN_POOLNODE(PageTableMgr, UmdContext, PoolElem, pL1Tbl->GetNodeIdx(), AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetGmmLibContext()))
 		    }
-                    pTTL2[GMM_L3_ENTRY_IDX(AUXTT, TileAddr)].DeleteFromList(pL1Tbl, Prev);
+                    ReleaseL1Table(GMM_L3_ENTRY_IDX(AUXTT, TileAddr), L2eIdx);
                 }
 
                 // The L1 table is unused -- meaning everything else in this table is
@@ -561,164 +643,758 @@ GMM_STATUS GmmLib::AuxTable::InvalidateTable(GMM_UMD_SYNCCONTEXT *UmdContext, GM
                 break;
             }
         }
+        if(!DoNotWait)
+        {
+            FlushL1Entries(UmdContext, &L1Batch);
+        }
+        LeaveL3eLock(GMM_L3_ENTRY_IDX(AUXTT, StartAddress));
+    }
+
+    return Status;
+}
+
+//=============================================================================
+//
+// Function: SetDeferredInvalidate
+//
+// Desc: Enables/disables deferred invalidation. While enabled, unmapped ranges
+//       are queued by QueueInvalidate and invalidated in bulk by FlushInvalidations.
+//       Ranges still pending when disabled stay queued until next flush.
+//
+// Caller: SetDeferredAuxInvalidation
+//
+// Parameters:
+//      Enable: true to queue unmapped ranges, false to invalidate on unmap
+//-----------------------------------------------------------------------------
+void GmmLib::AuxTable::SetDeferredInvalidate(bool Enable)
+{
+    EnterCriticalSection(&InvLock);
+    DeferInvalidate = Enable;
+    LeaveCriticalSection(&InvLock);
+}
+
+//=============================================================================
+//
+// Function: __FindPendingInvalidate
+//
+// Desc: Binary-searches pending ranges, caller must hold InvLock
+//
+// Parameters:
+//      Adr: Gfx address
+//
+// Returns:
+//      Index of first pending range ending at or after Adr, NumPendingInv if none
+//-----------------------------------------------------------------------------
+uint32_t GmmLib::AuxTable::__FindPendingInvalidate(GMM_GFX_ADDRESS Adr)
+{
+    uint32_t Lo = 0, Hi = NumPendingInv;
+
+    while(Lo < Hi)
+    {
+        uint32_t Mid = Lo + (Hi - Lo) / 2;
+        if(pPendingInv[Mid].End < Adr)
+        {
+            Lo = Mid + 1;
+        }
+        else
+        {
+            Hi = Mid;
+        }
     }
+    return Lo;
+}
+
+//=============================================================================
+//
+// Function: __GrowPendingInvalidate
+//
+// Desc: Doubles capacity of pending range list, caller must hold InvLock
+//
+// Returns:
+//      true on success, false if out of memory
+//-----------------------------------------------------------------------------
+bool GmmLib::AuxTable::__GrowPendingInvalidate()
+{
+    uint32_t              NewMax = MaxPendingInv ? 2 * MaxPendingInv : AUX_INVALIDATE_RANGE_MIN_COUNT;
+    AUX_INVALIDATE_RANGE *pNew   = NewArray<AUX_INVALIDATE_RANGE>(pClientContext->GetAllocatorCb(), NewMax, GMM_HEAP_PAGETABLE);
 
-    if(!DoNotWait)
+    if(!pNew)
     {
-        PageTableMgr->TTCb.pfEpilogTranslationTable(
-        UmdContext->pCommandQueueHandle,
-        1); // ForceFlush
+        return false;
     }
 
-    LeaveCriticalSection(&TTLock);
+    if(NumPendingInv)
+    {
+        memcpy(pNew, pPendingInv, NumPendingInv * sizeof(AUX_INVALIDATE_RANGE));
+    }
+    DeleteArray(pPendingInv);
 
-    return Status;
+    pPendingInv   = pNew;
+    MaxPendingInv = NewMax;
+    return true;
 }
 
 //=============================================================================
 //
-// Function: MapValidEntry
+// Function: QueueInvalidate
 //
-// Desc: Maps given main-surface, on Aux-Table, to get the exact CCS cacheline tied to
-//       different 4x4K pages of main-surface
+// Desc: Queues unmapped range for deferred invalidation, merging it with
+//       overlapping/adjacent pending ranges so each is walked once on flush
 //
-// Caller: UpdateAuxTable (map op)
+// Caller: UpdateAuxTable (unmap op)
 //
 // Parameters:
-//      UmdContext: ptr to thread-data
-//      BaseAdr: Start adr of main-surface
-//      BaseSize:   main-surface Size in bytes
-//      BaseResInfo: main surface ResInfo
-//      AuxVA: Start adr of Aux-surface
-//      AuxResInfo: Aux surface ResInfo
-//      PartialData: Aux L1 partial data (ie w/o address)
-//      DoNotWait: true for CPU update, false for async(Gpu) update
+//      BaseAdr: Start adr of main surface
+//      Size:   Main-surface size in bytes
+//
+// Returns:
+//      true if queued, false if deferred invalidation is disabled or list can't
+//      grow -caller must invalidate the range immediately
 //-----------------------------------------------------------------------------
-GMM_STATUS GmmLib::AuxTable::MapValidEntry(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX_ADDRESS BaseAdr, GMM_GFX_SIZE_T BaseSize,
-                                           GMM_RESOURCE_INFO *BaseResInfo, GMM_GFX_ADDRESS AuxVA, GMM_RESOURCE_INFO *AuxResInfo, uint64_t PartialData, uint8_t DoNotWait)
+bool GmmLib::AuxTable::QueueInvalidate(GMM_GFX_ADDRESS BaseAdr, GMM_GFX_SIZE_T Size)
 {
-    GMM_STATUS      Status = GMM_SUCCESS;
-    GMM_GFX_ADDRESS Addr = 0, L3TableAdr = GMM_NO_TABLE;
-    GMM_GFX_SIZE_T  L1TableSize = GMM_AUX_L1_SIZE(GetGmmLibContext()) * (WA16K(GetGmmLibContext()) ? GMM_KBYTE(16) : GMM_KBYTE(64)); // L1TableSize maps to 16MB address space for TGL and above: 256x64k | 16x1MB
-    GMM_GFX_SIZE_T  CCS$Adr     = AuxVA;
-    uint8_t         isTRVA    =0  ;
-
-    GMM_CLIENT ClientType;
-
-    GET_GMM_CLIENT_TYPE(pClientContext, ClientType);
+    GMM_GFX_ADDRESS Start = BaseAdr;
+    GMM_GFX_ADDRESS End   = BaseAdr + Size;
+    uint32_t        First = 0, Last = 0;
 
-    //NullCCSTile isn't initialized, disable TRVA path
-    isTRVA = (NullCCSTile ? isTRVA : 0);
+    EnterCriticalSection(&InvLock);
 
-    EnterCriticalSection(&TTLock);
-    if(!TTL3.L3Handle || (!DoNotWait && !UmdContext))
+    if(!DeferInvalidate || !Size)
     {
-        Status = GMM_ERROR;
+        LeaveCriticalSection(&InvLock);
+        return false;
     }
-    else
+
+    // Absorb every pending range overlapping or adjacent to [Start, End)
+    First = Last = __FindPendingInvalidate(Start);
+    while(Last < NumPendingInv && pPendingInv[Last].Start <= End)
     {
-        L3TableAdr = TTL3.GfxAddress;
+        Start = GFX_MIN(Start, pPendingInv[Last].Start);
+        End   = GFX_MAX(End, pPendingInv[Last].End);
+        Last++;
+    }
 
-        if(!DoNotWait)
+    if(First == Last)
+    {
+        if(NumPendingInv == MaxPendingInv && !__GrowPendingInvalidate())
         {
-            PageTableMgr->TTCb.pfPrologTranslationTable(UmdContext->pCommandQueueHandle);
+            LeaveCriticalSection(&InvLock);
+            return false;
         }
+        memmove(&pPendingInv[First + 1], &pPendingInv[First], (NumPendingInv - First) * sizeof(AUX_INVALIDATE_RANGE));
+        NumPendingInv++;
+    }
+    else if(Last - First > 1)
+    {
+        memmove(&pPendingInv[First + 1], &pPendingInv[Last], (NumPendingInv - Last) * sizeof(AUX_INVALIDATE_RANGE));
+        NumPendingInv -= Last - First - 1;
+    }
 
-        // GMM_DPF(GFXDBG_CRITICAL, "Mapping surface: GPUVA=0x%016llX Size=0x%08X Aux_GPUVA=0x%016llX\n", BaseAdr, BaseSize, AuxVA);
-        for(Addr = GFX_ALIGN_FLOOR(BaseAdr, L1TableSize); Addr < BaseAdr + BaseSize; Addr += L1TableSize)
-        {
-            GMM_GFX_ADDRESS StartAdr, EndAdr, TileAdr;
-            GMM_GFX_ADDRESS L1TableAdr = GMM_NO_TABLE, L2TableAdr = GMM_NO_TABLE;
-            GMM_GFX_ADDRESS L1TableCPUAdr = GMM_NO_TABLE, L2TableCPUAdr = GMM_NO_TABLE;
-            GMM_GFX_SIZE_T  L2eIdx     = 0;
-            GMM_GFX_SIZE_T  L3eIdx     = 0;
-            bool            AllocateL1 = false, AllocateL2 = false;
+    pPendingInv[First].Start = Start;
+    pPendingInv[First].End   = End;
 
-            EndAdr   = Addr + L1TableSize;
-            EndAdr   = EndAdr > BaseAdr + BaseSize ? BaseAdr + BaseSize : EndAdr;
-            StartAdr = Addr < BaseAdr ? BaseAdr : Addr;
+    LeaveCriticalSection(&InvLock);
+    return true;
+}
 
-            L2eIdx = GMM_L2_ENTRY_IDX(AUXTT, StartAdr);
-            L3eIdx = GMM_L3_ENTRY_IDX(AUXTT, StartAdr);
+//=============================================================================
+//
+// Function: InvalidatePendingOverlap
+//
+// Desc: Invalidates now, and dequeues, pending ranges overlapping given range.
+//       Must precede mapping the range, else later flush would invalidate the
+//       new mappings.
+//       Caller brackets Gpu-update with pfPrologTranslationTable/pfEpilogTranslationTable
+//
+// Caller: UpdateAuxTable (map op)
+//
+// Parameters:
+//      UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+//      BaseAdr: Start adr of main surface being mapped
+//      Size:   Main-surface size in bytes
+//      DoNotWait: 1 for CPU update, 0 for async(Gpu) update
+//-----------------------------------------------------------------------------
+GMM_STATUS GmmLib::AuxTable::InvalidatePendingOverlap(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX_ADDRESS BaseAdr, GMM_GFX_SIZE_T Size, uint8_t DoNotWait)
+{
+    GMM_STATUS Status = GMM_SUCCESS;
+    uint32_t   First = 0, Last = 0;
 
-            //Allocate L2/L1 Table -- get L2 Table Adr for <StartAdr,EndAdr>
-            GetL1L2TableAddr(Addr, &L1TableAdr, &L2TableAdr);
-            if(L2TableAdr == GMM_NO_TABLE || L1TableAdr == GMM_NO_TABLE)
-            {
-                AllocateL1 = GMM_NO_TABLE == L1TableAdr;
-                AllocateL2 = GMM_NO_TABLE == L2TableAdr;
-                AllocateL1L2Table(Addr, &L1TableAdr, &L2TableAdr);
+    EnterCriticalSection(&InvLock);
 
-                if(L2TableAdr == GMM_NO_TABLE || L1TableAdr == GMM_NO_TABLE)
-                {
-                    LeaveCriticalSection(&TTLock);
-                    return GMM_OUT_OF_MEMORY;
-                }
+    // Ranges merely adjacent to [BaseAdr, BaseAdr + Size) stay queued
+    First = Last = __FindPendingInvalidate(BaseAdr + 1);
+    while(Last < NumPendingInv && pPendingInv[Last].Start < BaseAdr + Size)
+    {
+        GMM_STATUS RangeStatus = InvalidateTable(UmdContext, pPendingInv[Last].Start,
+                                                 pPendingInv[Last].End - pPendingInv[Last].Start, DoNotWait);
+        Status = (Status == GMM_SUCCESS) ? RangeStatus : Status;
+        Last++;
+    }
 
-                if(AllocateL2)
-                {
-                    uint32_t     i = 0;
-                    GMM_AUXTTL2e InvalidEntry;
-                    InvalidEntry.Value = 0;
-                    if(isTRVA && NullL1Table)
-                    {
-                        InvalidEntry.Valid = 1;
-                        GMM_TO_AUX_L2e_L1GFXADDR_2((NullL1Table->GetPool()->GetGfxAddress() + PAGE_SIZE * NullL1Table->GetNodeIdx()), InvalidEntry, (!WA16K(GetGmmLibContext()) && !WA64K(GetGmmLibContext())))
-		    }
+    if(Last > First)
+    {
+        memmove(&pPendingInv[First], &pPendingInv[Last], (NumPendingInv - Last) * sizeof(AUX_INVALIDATE_RANGE));
+        NumPendingInv -= Last - First;
+    }
 
-                    if(DoNotWait)
-                    {
-                        L2TableCPUAdr = pTTL2[L3eIdx].GetCPUAddress();
+    LeaveCriticalSection(&InvLock);
+    return Status;
+}
 
-                        ((GMM_AUXTTL3e *)(TTL3.CPUAddress))[L3eIdx].Value     = 0;
-                        ((GMM_AUXTTL3e *)(TTL3.CPUAddress))[L3eIdx].L2GfxAddr = L2TableAdr >> 15;
-                        ((GMM_AUXTTL3e *)(TTL3.CPUAddress))[L3eIdx].Valid     = 1;
-                        for(i = 0; i < GMM_AUX_L2_SIZE; i++)
-                        {
-                            //initialize L2e ie clear Valid bit for all entries
-                            ((GMM_AUXTTL2e *)L2TableCPUAdr)[i].Value = InvalidEntry.Value;
-                        }
+//=============================================================================
+//
+// Function: FlushInvalidations
+//
+// Desc: Invalidates all pending ranges, in VA order. Released tables' pool nodes
+//       are reused/freed once their last Gpu-update retires (node/pool BBInfo).
+//       Caller brackets Gpu-update with pfPrologTranslationTable/pfEpilogTranslationTable
+//
+// Caller: FlushAuxTableInvalidations
+//
+// Parameters:
+//      UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+//      DoNotWait: 1 for CPU update, 0 for async(Gpu) update
+//-----------------------------------------------------------------------------
+GMM_STATUS GmmLib::AuxTable::FlushInvalidations(GMM_UMD_SYNCCONTEXT *UmdContext, uint8_t DoNotWait)
+{
+    GMM_STATUS Status = GMM_SUCCESS;
+
+    EnterCriticalSection(&InvLock);
+
+    for(uint32_t i = 0; i < NumPendingInv; i++)
+    {
+        GMM_STATUS RangeStatus = InvalidateTable(UmdContext, pPendingInv[i].Start,
+                                                 pPendingInv[i].End - pPendingInv[i].Start, DoNotWait);
+        Status = (Status == GMM_SUCCESS) ? RangeStatus : Status;
+    }
+    NumPendingInv = 0;
+
+    LeaveCriticalSection(&InvLock);
+    return Status;
+}
+
+//=============================================================================
+//
+// Function: RelocateTables
+//
+// Desc: Moves L2/L1 tables out of pools being evacuated (compaction) into other
+//       pools, and re-points parent L3e/L2e at the copy. Tables whose Gpu-updates
+//       haven't completed are left in place, their CPU-visible contents may be
+//       stale. A destination node whose previous use still has Gpu-updates in
+//       flight is Gpu-updated behind them, or left unused on CPU update.
+//       Hw may walk the old node until the next BB lands, so it is released
+//       with that fence. Null L2/L1 tables aren't moved.
+//       Caller brackets Gpu-update with pfPrologTranslationTable/pfEpilogTranslationTable
+//
+// Caller: GmmPageTableMgr::CompactPools
+//
+// Parameters:
+//      UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+//      DoNotWait: 1 for CPU update, 0 for async(Gpu) update
+//      BBQueueHandle: BB fence object CompletedFence belongs to
+//      CompletedFence: last fence observed complete on BBQueueHandle
+//
+// Returns:
+//      Number of tables moved
+//-----------------------------------------------------------------------------
+uint32_t GmmLib::AuxTable::RelocateTables(GMM_UMD_SYNCCONTEXT *UmdContext, uint8_t DoNotWait, HANDLE BBQueueHandle, uint64_t CompletedFence)
+{
+    uint32_t           NumMoved      = 0;
+    uint32_t           L1TableNodes  = AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetGmmLibContext());
+    bool               L1eAdr4KAlign = (!WA64K(GetGmmLibContext()) && !WA16K(GetGmmLibContext()));
+    AUX_L1_WRITE_BATCH L1Batch;
+    AUX_HELD_NODES     Held;
+
+    L1Batch.NumEntries = 0;
+    Held.NumNodes      = 0;
+
+    for(uint32_t L3eIdx = 0; L3eIdx < GMM_AUX_L3_SIZE; L3eIdx++)
+    {
+        MidLevelTable *pL2Tbl = &pTTL2[L3eIdx];
+
+        EnterL3eLock(L3eIdx);
+        if(!pL2Tbl->GetPool())
+        {
+            LeaveL3eLock(L3eIdx);
+            continue;
+        }
+
+        if(pL2Tbl->GetPool()->IsEvacuating() &&
+           IsBBInfoComplete(pL2Tbl->GetBBInfo(), BBQueueHandle, CompletedFence))
+        {
+            GMM_PAGETABLEPool *OldPool = pL2Tbl->GetPool();
+            int                OldIdx  = pL2Tbl->GetNodeIdx();
+            uint32_t           NodeIdx = 0;
+            bool               NodePending = false;
+            GMM_PAGETABLEPool *Pool = AssignRelocationNode(&NodeIdx, POOL_TYPE_AUXTTL2, &Held, DoNotWait, BBQueueHandle, CompletedFence, &NodePending);
+
+            if(Pool)
+            {
+                GMM_AUXTTL3e    L3e       = {0};
+                GMM_GFX_ADDRESS SrcCPUAdr = pL2Tbl->GetCPUAddress();
+
+                pL2Tbl->Relocate(Pool, NodeIdx);
+                CopyTableEntries(UmdContext, &L1Batch, pL2Tbl, SrcCPUAdr, false, NodePending);
+
+                L3e.Valid     = 1;
+                L3e.L2GfxAddr = (Pool->GetGfxAddress() + PAGE_SIZE * NodeIdx) >> 15;
+                if(DoNotWait)
+                {
+                    ((GMM_AUXTTL3e *)(TTL3.CPUAddress))[L3eIdx].Value = L3e.Value;
+                }
+                else
+                {
+                    pL2Tbl->UpdatePoolFence(UmdContext, false);
+                    PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                                   TTL3.GfxAddress + L3eIdx * GMM_AUX_L3e_SIZE,
+                                                   L3e.Value);
+                }
+
+                if(UmdContext)
+                {
+                    OldPool->GetNodeBBInfoAtIndex(OldIdx) = SyncInfo(UmdContext->BBFenceObj, UmdContext->BBLastFence + 1);
+                }
+                DEASSIGN_POOLNODE(PageTableMgr, UmdContext, OldPool, OldIdx, AUX_L2TABLE_SIZE_IN_POOLNODES)
+                NumMoved++;
+            }
+        }
+
+        for(uint32_t L2eIdx = 0; L2eIdx < GMM_AUX_L2_SIZE; L2eIdx++)
+        {
+            LastLevelTable *pL1Tbl = pL2Tbl->GetL1Table(L2eIdx);
+
+            if(!pL1Tbl || !pL1Tbl->GetPool()->IsEvacuating() ||
+               !IsBBInfoComplete(pL1Tbl->GetBBInfo(), BBQueueHandle, CompletedFence))
+            {
+                continue;
+            }
+
+            GMM_PAGETABLEPool *OldPool = pL1Tbl->GetPool();
+            int                OldIdx  = pL1Tbl->GetNodeIdx();
+            uint32_t           NodeIdx = 0;
+            bool               NodePending = false;
+            GMM_PAGETABLEPool *Pool = AssignRelocationNode(&NodeIdx, POOL_TYPE_AUXTTL1, &Held, DoNotWait, BBQueueHandle, CompletedFence, &NodePending);
+
+            if(!Pool)
+            {
+                break;
+            }
+
+            GMM_AUXTTL2e    L2e          = {0};
+            GMM_GFX_ADDRESS L1GfxAddress = Pool->GetGfxAddress() + PAGE_SIZE * NodeIdx;
+            GMM_GFX_ADDRESS SrcCPUAdr    = pL1Tbl->GetCPUAddress();
+
+            pL1Tbl->Relocate(Pool, NodeIdx);
+            CopyTableEntries(UmdContext, &L1Batch, pL1Tbl, SrcCPUAdr, true, NodePending);
+
+            L2e.Valid = 1;
+            GMM_TO_AUX_L2e_L1GFXADDR_2(L1GfxAddress, L2e, L1eAdr4KAlign)
+            if(DoNotWait)
+            {
+                ((GMM_AUXTTL2e *)pL2Tbl->GetCPUAddress())[L2eIdx].Value = L2e.Value;
+            }
+            else
+            {
+                pL2Tbl->UpdatePoolFence(UmdContext, false);
+                pL1Tbl->UpdatePoolFence(UmdContext, false);
+                PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                               pL2Tbl->GetPool()->GetGfxAddress() + PAGE_SIZE * pL2Tbl->GetNodeIdx() + L2eIdx * GMM_AUX_L2e_SIZE,
+                                               L2e.Value);
+            }
+
+            if(UmdContext)
+            {
+                OldPool->GetNodeBBInfoAtIndex(OldIdx) = SyncInfo(UmdContext->BBFenceObj, UmdContext->BBLastFence + 1);
+            }
+            DEASSIGN_POOLNODE(PageTableMgr, UmdContext, OldPool, OldIdx, L1TableNodes)
+            NumMoved++;
+        }
+        LeaveL3eLock(L3eIdx);
+    }
+
+    //Skipped nodes are free again, with their pending Gpu-use
+    for(uint32_t i = 0; i < Held.NumNodes; i++)
+    {
+        GMM_PAGETABLEPool *Pool = Held.Node[i].Pool;
+
+        Pool->GetNodeBBInfoAtIndex(Held.Node[i].NodeIdx) = Held.Node[i].BBInfo;
+        DEASSIGN_POOLNODE(PageTableMgr, UmdContext, Pool, Held.Node[i].NodeIdx, Pool->GetTableNodes())
+    }
+
+    return NumMoved;
+}
+
+//=============================================================================
+//
+// Function: AssignRelocationNode
+//
+// Desc: Assigns destination pool node for table being relocated. On CPU update,
+//       nodes whose previous use may still have Gpu-updates in flight are skipped,
+//       as those would land over the CPU copy. Skipped nodes are held (so next
+//       free node gets picked) until caller releases them.
+//
+// Caller: RelocateTables
+//
+// Parameters:
+//      NodeIdx: returns assigned node index
+//      PoolType: AuxTT_L1/L2 pool
+//      Held: nodes skipped so far
+//      DoNotWait: 1 for CPU update, 0 for async(Gpu) update
+//      BBQueueHandle: BB fence object CompletedFence belongs to
+//      CompletedFence: last fence observed complete on BBQueueHandle
+//      NodePending: returns true if node's previous use hasn't completed (Gpu-update only)
+//
+// Returns:
+//      Pool containing assigned node, NULL if none available
+//-----------------------------------------------------------------------------
+GmmLib::GMM_PAGETABLEPool *GmmLib::AuxTable::AssignRelocationNode(uint32_t *NodeIdx, POOL_TYPE PoolType, AUX_HELD_NODES *Held, uint8_t DoNotWait,
+                                                                  HANDLE BBQueueHandle, uint64_t CompletedFence, bool *NodePending)
+{
+    for(;;)
+    {
+        SyncInfo           NodeBBInfo;
+        GMM_PAGETABLEPool *Pool = PageTableMgr->__AssignFreePoolNode(NodeIdx, PoolType, &NodeBBInfo);
+
+        if(!Pool)
+        {
+            return NULL;
+        }
+
+        *NodePending = !IsBBInfoComplete(NodeBBInfo, BBQueueHandle, CompletedFence);
+        if(!*NodePending || !DoNotWait)
+        {
+            return Pool;
+        }
+
+        if(Held->NumNodes == AUX_RELOCATE_MAX_HELD_NODES)
+        {
+            Pool->GetNodeBBInfoAtIndex(*NodeIdx) = NodeBBInfo;
+            DEASSIGN_POOLNODE(PageTableMgr, NULL, Pool, *NodeIdx, Pool->GetTableNodes())
+            return NULL;
+        }
+
+        Held->Node[Held->NumNodes].Pool    = Pool;
+        Held->Node[Held->NumNodes].NodeIdx = *NodeIdx;
+        Held->Node[Held->NumNodes].BBInfo  = NodeBBInfo;
+        Held->NumNodes++;
+    }
+}
+
+//=============================================================================
+//
+// Function: CopyTableEntries
+//
+// Desc: Fills relocated L2/L1 table's new pool node with contents of its old
+//       node. Filled on CPU, unless the new node may still have Gpu-updates in
+//       flight from a previous use, which would land over the copy. Then entries
+//       are Gpu-updated behind the in-flight ones, as in InitTableEntries.
+//
+// Caller: RelocateTables
+//
+// Parameters:
+//      UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+//      Batch: Pending run of L1 entries
+//      pTable: Relocated L2/L1 table
+//      SrcCPUAdr: CPU address of table's old node
+//      IsL1: true for L1 table, false for L2 table
+//      NodePending: new node's previous use hasn't completed (requires Gpu-update)
+//-----------------------------------------------------------------------------
+void GmmLib::AuxTable::CopyTableEntries(GMM_UMD_SYNCCONTEXT *UmdContext, AUX_L1_WRITE_BATCH *Batch, GmmLib::Table *pTable,
+                                        GMM_GFX_ADDRESS SrcCPUAdr, bool IsL1, bool NodePending)
+{
+    uint32_t        NumEntries  = IsL1 ? (uint32_t)GMM_AUX_L1_SIZE(GetGmmLibContext()) : (uint32_t)GMM_AUX_L2_SIZE;
+    uint64_t *      Src         = (uint64_t *)SrcCPUAdr;
+    GMM_GFX_ADDRESS TableGfxAdr = pTable->GetPool()->GetGfxAddress() + PAGE_SIZE * pTable->GetNodeIdx();
+    uint32_t        i           = 0;
+
+    if(!NodePending)
+    {
+        memcpy((void *)pTable->GetCPUAddress(), (void *)Src, IsL1 ? L1Size : AUX_L2TABLE_SIZE_IN_POOLNODES * PAGE_SIZE);
+        return;
+    }
+
+    pTable->UpdatePoolFence(UmdContext, false);
+    for(i = 0; i < NumEntries; i++)
+    {
+        if(IsL1)
+        {
+            WriteL1Entry(UmdContext, Batch, TableGfxAdr + i * GMM_AUX_L1e_SIZE, Src[i]);
+        }
+        else
+        {
+            PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                           TableGfxAdr + i * GMM_AUX_L2e_SIZE,
+                                           Src[i]);
+        }
+    }
+    FlushL1Entries(UmdContext, Batch);
+}
+
+//=============================================================================
+//
+// Function: GetNumPendingInvalidations
+//
+// Returns:
+//      Number of (merged) ranges pending invalidation
+//-----------------------------------------------------------------------------
+uint32_t GmmLib::AuxTable::GetNumPendingInvalidations()
+{
+    uint32_t Num;
+
+    EnterCriticalSection(&InvLock);
+    Num = NumPendingInv;
+    LeaveCriticalSection(&InvLock);
+
+    return Num;
+}
+
+//=============================================================================
+//
+// Function: GetMapStats
+//
+// Desc: Reports L1e Gpu-updated and skipped (unchanged re-map) by MapValidEntry
+//
+// Parameters:
+//      pStats: page-table statistics, map update counts are filled in
+//-----------------------------------------------------------------------------
+void GmmLib::AuxTable::GetMapStats(GMM_PAGETABLE_MGR_STATS *pStats)
+{
+    pStats->NumL1eWritten     = NumMapL1eWritten;
+    pStats->NumL1eSkipped     = NumMapL1eSkipped;
+    pStats->SkippedEntryBytes = pStats->NumL1eSkipped * GMM_AUX_L1e_SIZE;
+}
+
+//=============================================================================
+//
+// Function: GetTableStats
+//
+// Desc: Counts live L2/L1 tables and main-surface bytes they map, taking each
+//       L3e lock in turn (snapshot may mix concurrent updates)
+//
+// Parameters:
+//      pNumL2Tables: Live L2 tables
+//      pNumL1Tables: Live L1 tables
+//      pMappedSize: Main-surface bytes with valid (non-null) L1e
+//-----------------------------------------------------------------------------
+void GmmLib::AuxTable::GetTableStats(uint32_t *pNumL2Tables, uint32_t *pNumL1Tables, GMM_GFX_SIZE_T *pMappedSize)
+{
+    GMM_GFX_SIZE_T L1eSize     = WA16K(GetGmmLibContext()) ? GMM_KBYTE(16) : WA64K(GetGmmLibContext()) ? GMM_KBYTE(64) : GMM_MBYTE(1);
+    int            TableDWSize = static_cast<int>(GMM_AUX_L1_SIZE_DWORD(GetGmmLibContext()));
+
+    for(uint32_t L3eIdx = 0; L3eIdx < GMM_AUX_L3_SIZE; L3eIdx++)
+    {
+        EnterL3eLock(L3eIdx);
+        if(pTTL2[L3eIdx].GetPool())
+        {
+            (*pNumL2Tables)++;
+            for(uint32_t L2eIdx = 0; L2eIdx < GMM_AUX_L2_SIZE; L2eIdx++)
+            {
+                LastLevelTable *pL1Tbl = pTTL2[L3eIdx].GetL1Table(L2eIdx);
+                if(pL1Tbl)
+                {
+                    (*pNumL1Tables)++;
+                    *pMappedSize += pL1Tbl->GetNumUsedEntries(TableDWSize) * L1eSize;
+                }
+            }
+        }
+        LeaveL3eLock(L3eIdx);
+    }
+}
+
+//=============================================================================
+//
+// Function: DumpTables
+//
+// Desc: Appends Aux Table tree to page-table dump, one line per L3/L2/L1 table
+//       with its Gfx address, pool node and (L1) number of used entries
+//
+// Caller: GmmPageTableMgr::DumpPageTables
+//
+// Parameters:
+//      pBuffer: dump buffer (may be NULL to query size)
+//      BufferSize: buffer size in bytes
+//      Len: current dump length
+//
+// Returns:
+//      New dump length, excluding terminating null
+//-----------------------------------------------------------------------------
+uint32_t GmmLib::AuxTable::DumpTables(char *pBuffer, uint32_t BufferSize, uint32_t Len)
+{
+    int TableDWSize = static_cast<int>(GMM_AUX_L1_SIZE_DWORD(GetGmmLibContext()));
+
+    Len = __GmmTTDumpPrintf(pBuffer, BufferSize, Len, "AuxTT L3 gfx=0x%llx\n", (unsigned long long)TTL3.GfxAddress);
+
+    EnterCriticalSection(&TTLock);
+    if(NullL2Table && NullL1Table)
+    {
+        Len = __GmmTTDumpPrintf(pBuffer, BufferSize, Len, " Null L2 gfx=0x%llx L1 gfx=0x%llx\n",
+                                (unsigned long long)(NullL2Table->GetPool()->GetGfxAddress() + PAGE_SIZE * NullL2Table->GetNodeIdx()),
+                                (unsigned long long)(NullL1Table->GetPool()->GetGfxAddress() + PAGE_SIZE * NullL1Table->GetNodeIdx()));
+    }
+    LeaveCriticalSection(&TTLock);
+
+    for(uint32_t L3eIdx = 0; L3eIdx < GMM_AUX_L3_SIZE; L3eIdx++)
+    {
+        MidLevelTable *pL2Tbl = &pTTL2[L3eIdx];
+
+        EnterL3eLock(L3eIdx);
+        if(pL2Tbl->GetPool())
+        {
+            Len = __GmmTTDumpPrintf(pBuffer, BufferSize, Len, " L3e[%u] L2 gfx=0x%llx node=%d\n", L3eIdx,
+                                    (unsigned long long)(pL2Tbl->GetPool()->GetGfxAddress() + PAGE_SIZE * pL2Tbl->GetNodeIdx()),
+                                    pL2Tbl->GetNodeIdx());
+
+            for(uint32_t L2eIdx = 0; L2eIdx < GMM_AUX_L2_SIZE; L2eIdx++)
+            {
+                LastLevelTable *pL1Tbl = pL2Tbl->GetL1Table(L2eIdx);
+                if(pL1Tbl)
+                {
+                    Len = __GmmTTDumpPrintf(pBuffer, BufferSize, Len, "  L2e[%u] L1 gfx=0x%llx node=%d used=%u\n", L2eIdx,
+                                            (unsigned long long)(pL1Tbl->GetPool()->GetGfxAddress() + PAGE_SIZE * pL1Tbl->GetNodeIdx()),
+                                            pL1Tbl->GetNodeIdx(), pL1Tbl->GetNumUsedEntries(TableDWSize));
+                }
+            }
+        }
+        LeaveL3eLock(L3eIdx);
+    }
+
+    return Len;
+}
+
+//=============================================================================
+//
+// Function: MapValidEntry
+//
+// Desc: Maps given main-surface, on Aux-Table, to get the exact CCS cacheline tied to
+//       different 4x4K pages of main-surface
+//       Caller brackets Gpu-update with pfPrologTranslationTable/pfEpilogTranslationTable
+//
+// Caller: UpdateAuxTable (map op)
+//
+// Parameters:
+//      UmdContext: ptr to thread-data
+//      BaseAdr: Start adr of main-surface
+//      BaseSize:   main-surface Size in bytes
+//      BaseResInfo: main surface ResInfo
+//      AuxVA: Start adr of Aux-surface
+//      AuxResInfo: Aux surface ResInfo
+//      PartialData: Aux L1 partial data (ie w/o address)
+//      DoNotWait: true for CPU update, false for async(Gpu) update
+//-----------------------------------------------------------------------------
+GMM_STATUS GmmLib::AuxTable::MapValidEntry(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX_ADDRESS BaseAdr, GMM_GFX_SIZE_T BaseSize,
+                                           GMM_RESOURCE_INFO *BaseResInfo, GMM_GFX_ADDRESS AuxVA, GMM_RESOURCE_INFO *AuxResInfo, uint64_t PartialData, uint8_t DoNotWait)
+{
+    GMM_STATUS      Status = GMM_SUCCESS;
+    GMM_GFX_ADDRESS Addr = 0, L3TableAdr = GMM_NO_TABLE;
+    GMM_GFX_SIZE_T  L1TableSize = GMM_AUX_L1_SIZE(GetGmmLibContext()) * (WA16K(GetGmmLibContext()) ? GMM_KBYTE(16) : GMM_KBYTE(64)); // L1TableSize maps to 16MB address space for TGL and above: 256x64k | 16x1MB
+    GMM_GFX_SIZE_T  CCS$Adr     = AuxVA;
+    uint8_t         isTRVA    =0  ;
+    uint64_t        NumL1eWritten = 0, NumL1eSkipped = 0;
+    AUX_L1_WRITE_BATCH L1Batch;
+    AUX_CCS_ITERATOR   CCSIter;
+
+    GMM_CLIENT ClientType;
+
+    GET_GMM_CLIENT_TYPE(pClientContext, ClientType);
+
+    L1Batch.NumEntries = 0;
+
+    if(!pClientContext->GetLibContext()->GetSkuTable().FtrLinearCCS)
+    {
+        InitCCSIterator(&CCSIter, BaseResInfo, AuxResInfo, AuxVA, 0);
+    }
+
+    //NullCCSTile isn't initialized, disable TRVA path
+    isTRVA = (NullCCSTile ? isTRVA : 0);
+
+    //L3 table lives as long as AuxTable, L2/L1 tables are updated under their L3e lock
+    if(!TTL3.L3Handle || (!DoNotWait && !UmdContext))
+    {
+        Status = GMM_ERROR;
+    }
+    else
+    {
+        L3TableAdr = TTL3.GfxAddress;
+
+        // GMM_DPF(GFXDBG_CRITICAL, "Mapping surface: GPUVA=0x%016llX Size=0x%08X Aux_GPUVA=0x%016llX\n", BaseAdr, BaseSize, AuxVA);
+        for(Addr = GFX_ALIGN_FLOOR(BaseAdr, L1TableSize); Addr < BaseAdr + BaseSize; Addr += L1TableSize)
+        {
+            GMM_GFX_ADDRESS StartAdr, EndAdr, TileAdr;
+            GMM_GFX_ADDRESS L1TableAdr = GMM_NO_TABLE, L2TableAdr = GMM_NO_TABLE;
+            GMM_GFX_ADDRESS L1TableCPUAdr = GMM_NO_TABLE, L2TableCPUAdr = GMM_NO_TABLE;
+            GMM_GFX_SIZE_T  L2eIdx     = 0;
+            GMM_GFX_SIZE_T  L3eIdx     = 0;
+            bool            AllocateL1 = false, AllocateL2 = false;
+
+            EndAdr   = Addr + L1TableSize;
+            EndAdr   = EndAdr > BaseAdr + BaseSize ? BaseAdr + BaseSize : EndAdr;
+            StartAdr = Addr < BaseAdr ? BaseAdr : Addr;
+
+            L2eIdx = GMM_L2_ENTRY_IDX(AUXTT, StartAdr);
+            L3eIdx = GMM_L3_ENTRY_IDX(AUXTT, StartAdr);
+
+            EnterL3eLock(L3eIdx);
+
+            //Allocate L2/L1 Table -- get L2 Table Adr for <StartAdr,EndAdr>
+            GetL1L2TableAddr(Addr, &L1TableAdr, &L2TableAdr);
+            if(L2TableAdr == GMM_NO_TABLE || L1TableAdr == GMM_NO_TABLE)
+            {
+                AllocateL1 = GMM_NO_TABLE == L1TableAdr;
+                AllocateL2 = GMM_NO_TABLE == L2TableAdr;
+                AllocateL1L2Table(Addr, &L1TableAdr, &L2TableAdr);
+
+                if(L2TableAdr == GMM_NO_TABLE || L1TableAdr == GMM_NO_TABLE)
+                {
+                    LeaveL3eLock(L3eIdx);
+                    return GMM_OUT_OF_MEMORY;
+                }
+
+                if(AllocateL2)
+                {
+                    GMM_AUXTTL2e InvalidEntry;
+                    InvalidEntry.Value = 0;
+                    if(isTRVA && NullL1Table)
+                    {
+                        InvalidEntry.Valid = 1;
+                        GMM_TO_AUX_L2e_L1GFXADDR_2((NullL1Table->GetPool()->GetGfxAddress() + PAGE_SIZE * NullL1Table->GetNodeIdx()), InvalidEntry, (!WA16K(GetGmmLibContext()) && !WA64K(GetGmmLibContext())))
+		    }
+
+                    //initialize L2e ie clear Valid bit for all entries, before L3e makes L2 table visible
+                    InitTableEntries(UmdContext, &L1Batch, &pTTL2[L3eIdx], L2TableAdr, false, InvalidEntry.Value, DoNotWait);
+
+                    if(DoNotWait)
+                    {
+                        ((GMM_AUXTTL3e *)(TTL3.CPUAddress))[L3eIdx].Value     = 0;
+                        ((GMM_AUXTTL3e *)(TTL3.CPUAddress))[L3eIdx].L2GfxAddr = L2TableAdr >> 15;
+                        ((GMM_AUXTTL3e *)(TTL3.CPUAddress))[L3eIdx].Valid     = 1;
                     }
                     else
                     {
                         GMM_AUXTTL3e L3e = {0};
                         L3e.Valid        = 1;
                         L3e.L2GfxAddr    = L2TableAdr >> 15;
-                        PageTableMgr->TTCb.pfWriteL2L3Entry(UmdContext->pCommandQueueHandle,
-                                                            L3TableAdr + L3eIdx * GMM_AUX_L3e_SIZE,
-                                                            L3e.Value);
-
-                        //initialize L2e ie clear valid bit for all entries
-                        for(i = 0; i < GMM_AUX_L2_SIZE; i++)
-                        {
-                            PageTableMgr->TTCb.pfWriteL2L3Entry(UmdContext->pCommandQueueHandle,
-                                                                L2TableAdr + i * GMM_AUX_L2e_SIZE,
-                                                                InvalidEntry.Value);
-                        }
+                        PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                                       L3TableAdr + L3eIdx * GMM_AUX_L3e_SIZE,
+                                                       L3e.Value);
                     }
                 }
 
                 if(AllocateL1)
                 {
-                    uint64_t InvalidEntry = (!isTRVA) ? GMM_INVALID_AUX_ENTRY : (NullCCSTile | __BIT(0));
-                    uint32_t i            = 0;
+                    uint64_t                InvalidEntry = (!isTRVA) ? GMM_INVALID_AUX_ENTRY : (NullCCSTile | __BIT(0));
+                    GmmLib::LastLevelTable *pL1Tbl       = pTTL2[L3eIdx].GetL1Table(L2eIdx);
+
+                    //initialize L1e ie mark all entries with Null tile value, before L2e makes L1 table visible
+                    InitTableEntries(UmdContext, &L1Batch, pL1Tbl, L1TableAdr, true, InvalidEntry, DoNotWait);
 
                     if(DoNotWait)
                     {
-                        GmmLib::LastLevelTable *pL1Tbl = NULL;
-                        pL1Tbl                         = pTTL2[L3eIdx].GetL1Table(L2eIdx, NULL);
                         L2TableCPUAdr = pTTL2[L3eIdx].GetCPUAddress();
-                        L1TableCPUAdr = pL1Tbl->GetCPUAddress();
                         //Sync update on CPU
                         ((GMM_AUXTTL2e *)L2TableCPUAdr)[L2eIdx].Value = 0;
                         GMM_TO_AUX_L2e_L1GFXADDR_2(L1TableAdr, ((GMM_AUXTTL2e *)L2TableCPUAdr)[L2eIdx], (!WA64K(GetGmmLibContext()) && !WA16K(GetGmmLibContext()))) // populate L2e.L1GfxAddr
                         ((GMM_AUXTTL2e *)L2TableCPUAdr)[L2eIdx]
                         .Valid = 1;
-                        for(i = 0; i < (uint32_t)GMM_AUX_L1_SIZE(GetGmmLibContext()); i++)
-                        {
-                            //initialize L1e ie mark all entries with Null tile value
-                            ((GMM_AUXTTL1e *)L1TableCPUAdr)[i].Value = InvalidEntry;
-                        }
                     }
                     else
                     {
@@ -727,21 +1403,43 @@ GMM_STATUS GmmLib::AuxTable::MapValidEntry(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_
                         GMM_TO_AUX_L2e_L1GFXADDR_2(L1TableAdr, L2e, (!WA64K(GetGmmLibContext()) && !WA16K(GetGmmLibContext())))
                         pTTL2[L3eIdx]
                         .UpdatePoolFence(UmdContext, false);
-                        PageTableMgr->TTCb.pfWriteL2L3Entry(UmdContext->pCommandQueueHandle,
-                                                            L2TableAdr + L2eIdx * GMM_AUX_L2e_SIZE,
-                                                            L2e.Value);
-
-                        //initialize all L1e with invalid entries
-                        for(i = 0; i < (uint32_t)GMM_AUX_L1_SIZE(GetGmmLibContext()); i++)
-                        {
-                            PageTableMgr->TTCb.pfWriteL2L3Entry(UmdContext->pCommandQueueHandle,
-                                                                L1TableAdr + i * sizeof(uint64_t),
-                                                                InvalidEntry);
-                        }
+                        PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                                       L2TableAdr + L2eIdx * GMM_AUX_L2e_SIZE,
+                                                       L2e.Value);
                     }
                 }
             }
    
+            if(DoNotWait && pClientContext->GetLibContext()->GetSkuTable().FtrLinearCCS)
+            {
+                //Linear CCS: L1e of consecutive tiles differ only in CCS adr, by fixed step -fill run in bulk
+                GMM_GFX_SIZE_T TileSize = WA16K(GetGmmLibContext()) ? GMM_KBYTE(16) : WA64K(GetGmmLibContext()) ? GMM_KBYTE(64) : GMM_MBYTE(1);
+                uint64_t       CCSStep  = WA16K(GetGmmLibContext()) ? GMM_BYTES(64) : WA64K(GetGmmLibContext()) ? GMM_BYTES(256) : GMM_KBYTE(4);
+                uint64_t       AdrMask  = WA16K(GetGmmLibContext()) ? 0x0000ffffffffffc0 : WA64K(GetGmmLibContext()) ? 0x0000ffffffffff00 : 0x0000fffffffff000; //Reserved2/Reserved4/GfxAddress
+                uint32_t       L1eIdx   = static_cast<uint32_t>(GMM_L1_ENTRY_IDX(AUXTT, StartAdr, GetGmmLibContext()));
+                uint32_t       NumL1e   = static_cast<uint32_t>((EndAdr - StartAdr + TileSize - 1) / TileSize);
+                GMM_AUXTTL1e   L1e      = {0};
+
+                GmmLib::LastLevelTable *pL1Tbl = pTTL2[L3eIdx].GetL1Table(L2eIdx);
+
+                __GMM_ASSERT(GFX_IS_ALIGNED(CCS$Adr, CCSStep));
+                __GMM_ASSERT(GFX_IS_ALIGNED(StartAdr, TileSize));
+
+                L1e.Value = PartialData;
+                L1e.Valid = 1;
+                FillLinearL1Entries((uint64_t *)pL1Tbl->GetCPUAddress() + L1eIdx, NumL1e,
+                                    (L1e.Value & ~AdrMask) | (CCS$Adr & AdrMask), CCSStep);
+                pL1Tbl->ShadowEntries(L1eIdx, (uint64_t *)pL1Tbl->GetCPUAddress() + L1eIdx, NumL1e);
+
+                // Since we are mapping non-null entries, no need to check whether
+                // L1 table is unused.
+                pL1Tbl->SetTableUsage(L1eIdx, NumL1e);
+
+                CCS$Adr += NumL1e * CCSStep;
+                LeaveL3eLock(L3eIdx);
+                continue;
+            }
+
 	    //GMM_DPF(GFXDBG_NORMAL, "Mapping surface: GPUVA=0x%016llx Size=0x%08x Aux_GPUVA=0x%016llx", StartAdr, BaseSize, CCS$Adr);
             for(TileAdr = StartAdr; TileAdr < EndAdr; TileAdr += (WA16K(GetGmmLibContext()) ? GMM_KBYTE(16) : WA64K(GetGmmLibContext()) ? GMM_KBYTE(64) : GMM_MBYTE(1)),
             CCS$Adr += (pClientContext->GetLibContext()->GetSkuTable().FtrLinearCCS ?
@@ -759,7 +1457,9 @@ GMM_STATUS GmmLib::AuxTable::MapValidEntry(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_
                 }
 		
                 CCS$Adr = (pClientContext->GetLibContext()->GetSkuTable().FtrLinearCCS ? CCS$Adr :
-				__GetCCSCacheline(BaseResInfo, BaseAdr, AuxResInfo, AuxVA, TileAdr - BaseAdr));
+                           StepCCSIterator(&CCSIter, TileAdr - BaseAdr));
+                __GMM_ASSERT(pClientContext->GetLibContext()->GetSkuTable().FtrLinearCCS ||
+                             CCS$Adr == __GetCCSCacheline(BaseResInfo, BaseAdr, AuxResInfo, AuxVA, TileAdr - BaseAdr));
 
                 if(WA16K(GetGmmLibContext()))
                 {
@@ -788,20 +1488,31 @@ GMM_STATUS GmmLib::AuxTable::MapValidEntry(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_
 
                 GmmLib::LastLevelTable *pL1Tbl = NULL;
 
-                pL1Tbl        = pTTL2[L3eIdx].GetL1Table(L2eIdx, NULL);
+                pL1Tbl        = pTTL2[L3eIdx].GetL1Table(L2eIdx);
                 L1TableCPUAdr = pL1Tbl->GetCPUAddress();
                 if(DoNotWait)
                 {
                     //Sync update on CPU
                     ((GMM_AUXTTL1e *)L1TableCPUAdr)[L1eIdx].Value = L1e.Value;
-
+                    pL1Tbl->ShadowEntries(static_cast<uint32_t>(L1eIdx), &L1e.Value, 1);
+                }
+                else if(pL1Tbl->IsEntryMapped(static_cast<uint32_t>(L1eIdx), L1e.Value))
+                {
+                    //Re-map to same CCS (eg re-bind after eviction), entry already written
+                    NumL1eSkipped++;
                 }
                 else
                 {
                     pL1Tbl->UpdatePoolFence(UmdContext, false);
-                    PageTableMgr->TTCb.pfWriteL2L3Entry(UmdContext->pCommandQueueHandle,
-                                                        L1TableAdr + L1eIdx * GMM_AUX_L1e_SIZE,
-                                                        L1e.Value);
+
+                    //Coalesce contiguous L1e, flushed by FlushL1Entries
+                    WriteL1Entry(UmdContext, &L1Batch, L1TableAdr + L1eIdx * GMM_AUX_L1e_SIZE, L1e.Value);
+
+                    if(pL1Tbl->AllocateShadow(GMM_AUX_L1_SIZE(GetGmmLibContext())))
+                    {
+                        pL1Tbl->ShadowEntries(static_cast<uint32_t>(L1eIdx), &L1e.Value, 1);
+                    }
+                    NumL1eWritten++;
                 }
                 GMM_DPF(GFXDBG_NORMAL, "Map | L3 Table Entry: L3AddressBase[0x%llX] :: L3.L2GfxAddr[0x%llX] :: L3Valid[0x%llX] \n", (GMM_AUXTTL3e *)(TTL3.CPUAddress), ((GMM_AUXTTL3e *)(TTL3.CPUAddress))[L3eIdx].L2GfxAddr, ((GMM_AUXTTL3e *)(TTL3.CPUAddress))[L3eIdx].Valid);
                 GMM_DPF(GFXDBG_NORMAL, "Map | L2 Table Entry: L2addressBase[0x%llX] :: L2.L1GfxAddr[0x%llX] :: L2Valid[0x%llX] \n", ((GMM_AUXTTL2e *)pTTL2[L3eIdx].GetCPUAddress()), ((GMM_AUXTTL2e *)pTTL2[L3eIdx].GetCPUAddress())[L2eIdx].L1GfxAddr, ((GMM_AUXTTL2e *)pTTL2[L3eIdx].GetCPUAddress())[L2eIdx].Valid);
@@ -812,18 +1523,205 @@ GMM_STATUS GmmLib::AuxTable::MapValidEntry(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_
                 // L1 table is unused.
                 pL1Tbl->TrackTableUsage(AUXTT, true, TileAdr, false, GetGmmLibContext());
             }
+
+            if(!DoNotWait)
+            {
+                FlushL1Entries(UmdContext, &L1Batch);
+            }
+            LeaveL3eLock(L3eIdx);
         }
-        if(!DoNotWait)
+    }
+
+    if(NumL1eWritten || NumL1eSkipped)
+    {
+        GMM_TT_ATOMIC_ADD64(&NumMapL1eWritten, NumL1eWritten);
+        GMM_TT_ATOMIC_ADD64(&NumMapL1eSkipped, NumL1eSkipped);
+    }
+
+    return Status;
+}
+
+//=============================================================================
+//
+// Function: InitTableEntries
+//
+// Desc: Initializes all entries of newly allocated L2/L1 table with given value.
+//       Table is not Gpu-visible until the L3e/L2e pointing to it is written,
+//       so unless its pool node may still have Gpu-updates in flight from a
+//       previous use, the page is filled on CPU and no commands are emitted.
+//       Otherwise entries are Gpu-updated behind the in-flight ones, L1e in
+//       coalesced pfWriteL1Entries runs. Pending runs are flushed on return.
+//
+// Caller: MapValidEntry
+//
+// Parameters:
+//      UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+//      Batch: Pending run of L1 entries
+//      pTable: Newly allocated L2/L1 table
+//      TableGfxAdr: Gfx address of table
+//      IsL1: true for L1 table, false for L2 table
+//      Data: Entry value to fill
+//      DoNotWait: 1 for CPU update, 0 for async(Gpu) update
+//-----------------------------------------------------------------------------
+void GmmLib::AuxTable::InitTableEntries(GMM_UMD_SYNCCONTEXT *UmdContext, AUX_L1_WRITE_BATCH *Batch, GmmLib::Table *pTable,
+                                        GMM_GFX_ADDRESS TableGfxAdr, bool IsL1, uint64_t Data, uint8_t DoNotWait)
+{
+    uint32_t NumEntries = IsL1 ? (uint32_t)GMM_AUX_L1_SIZE(GetGmmLibContext()) : (uint32_t)GMM_AUX_L2_SIZE;
+    uint32_t i          = 0;
+
+    //Table object inherits pool node's BBInfo from its last Gpu-update, if any
+    if(DoNotWait ||
+       (!pTable->GetBBInfo().BBQueueHandle && !pTable->GetBBInfo().BBFence))
+    {
+        uint64_t *TableCPUAdr = (uint64_t *)pTable->GetCPUAddress();
+        for(i = 0; i < NumEntries; i++)
         {
-            PageTableMgr->TTCb.pfEpilogTranslationTable(
-            UmdContext->pCommandQueueHandle,
-            1);
+            TableCPUAdr[i] = Data;
         }
+        return;
     }
 
-    LeaveCriticalSection(&TTLock);
+    pTable->UpdatePoolFence(UmdContext, false);
+    for(i = 0; i < NumEntries; i++)
+    {
+        if(IsL1)
+        {
+            WriteL1Entry(UmdContext, Batch, TableGfxAdr + i * GMM_AUX_L1e_SIZE, Data);
+        }
+        else
+        {
+            PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                           TableGfxAdr + i * GMM_AUX_L2e_SIZE,
+                                           Data);
+        }
+    }
+    FlushL1Entries(UmdContext, Batch);
+}
 
-    return Status;
+//=============================================================================
+//
+// Function: WriteL1Entry
+//
+// Desc: Queues L1 entry update for async(Gpu) update. Entries contiguous with
+//       the pending run are coalesced; otherwise the pending run is flushed
+//       first, so updates are emitted in the order they were queued.
+//
+// Caller: MapValidEntry, MapNullCCS, InvalidateTable, InitTableEntries
+//
+// Parameters:
+//      UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+//      Batch: Pending run of L1 entries
+//      GfxAddress: Gfx address of L1 entry
+//      Data: L1 entry value
+//-----------------------------------------------------------------------------
+void GmmLib::AuxTable::WriteL1Entry(GMM_UMD_SYNCCONTEXT *UmdContext, AUX_L1_WRITE_BATCH *Batch, GMM_GFX_ADDRESS GfxAddress, uint64_t Data)
+{
+    if(Batch->NumEntries &&
+       (Batch->NumEntries == AUX_L1_WRITE_BATCH_MAX_ENTRIES ||
+        GfxAddress != Batch->GfxAddress + Batch->NumEntries * GMM_AUX_L1e_SIZE))
+    {
+        FlushL1Entries(UmdContext, Batch);
+    }
+
+    if(!Batch->NumEntries)
+    {
+        Batch->GfxAddress = GfxAddress;
+    }
+    Batch->Data[Batch->NumEntries++] = Data;
+}
+
+//=============================================================================
+//
+// Function: FlushL1Entries
+//
+// Desc: Emits pending run of L1 entries with single pfWriteL1Entries callback.
+//       NumEntries passed to callback is in DWORDs, each 64-bit L1e being
+//       written as a DWORD pair within same command. Only done if client
+//       declared those writes QWORD-atomic (SetAtomicL1EntriesWrite), L1e
+//       update could tear otherwise. Falls back to per-entry 64-bit
+//       pfWriteL2L3Entry by default or if client didn't provide pfWriteL1Entries.
+//
+// Caller: MapValidEntry, MapNullCCS, InvalidateTable, WriteL1Entry
+//
+// Parameters:
+//      UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+//      Batch: Pending run of L1 entries, emptied on return
+//-----------------------------------------------------------------------------
+void GmmLib::AuxTable::FlushL1Entries(GMM_UMD_SYNCCONTEXT *UmdContext, AUX_L1_WRITE_BATCH *Batch)
+{
+    if(!Batch->NumEntries)
+    {
+        return;
+    }
+
+    if(PageTableMgr->TTCb.pfWriteL1Entries && PageTableMgr->__IsAtomicL1EntriesWrite())
+    {
+        PageTableMgr->__CountCallback(GMM_PAGETABLE_CB_WRITE_L1_ENTRIES);
+        PageTableMgr->TTCb.pfWriteL1Entries(UmdContext->pCommandQueueHandle,
+                                            Batch->NumEntries * (GMM_AUX_L1e_SIZE / sizeof(uint32_t)),
+                                            Batch->GfxAddress,
+                                            (uint32_t *)Batch->Data);
+    }
+    else
+    {
+        for(uint32_t i = 0; i < Batch->NumEntries; i++)
+        {
+            PageTableMgr->__WriteL2L3Entry(UmdContext->pCommandQueueHandle,
+                                           Batch->GfxAddress + i * GMM_AUX_L1e_SIZE,
+                                           Batch->Data[i]);
+        }
+    }
+
+    Batch->NumEntries = 0;
+}
+
+//=============================================================================
+//
+// Function: FillLinearL1Entries
+//
+// Desc: Fills run of L1 entries forming arithmetic sequence (linear CCS, where
+//       consecutive entries differ only in CCS adr), two entries per SSE2 store.
+//       Caller ensures CCS adr doesn't carry beyond L1e GfxAddress field.
+//
+// Caller: MapValidEntry (CPU update)
+//
+// Parameters:
+//      L1CPUAdr: CPU adr of first L1 entry
+//      NumEntries: Number of entries to fill
+//      FirstEntry: Value of first entry
+//      Step: Value increment between consecutive entries
+//-----------------------------------------------------------------------------
+void GmmLib::AuxTable::FillLinearL1Entries(uint64_t *L1CPUAdr, uint32_t NumEntries, uint64_t FirstEntry, uint64_t Step)
+{
+    uint32_t i = 0;
+
+    if(NumEntries >= 8)
+    {
+        __m128i Inc = _mm_set1_epi64x((long long)(2 * Step));
+        __m128i E0  = _mm_set_epi64x((long long)(FirstEntry + Step), (long long)FirstEntry);
+        __m128i E1  = _mm_add_epi64(E0, Inc);
+        __m128i E2  = _mm_add_epi64(E1, Inc);
+        __m128i E3  = _mm_add_epi64(E2, Inc);
+
+        Inc = _mm_set1_epi64x((long long)(8 * Step));
+        for(; i + 8 <= NumEntries; i += 8)
+        {
+            _mm_storeu_si128((__m128i *)&L1CPUAdr[i], E0);
+            _mm_storeu_si128((__m128i *)&L1CPUAdr[i + 2], E1);
+            _mm_storeu_si128((__m128i *)&L1CPUAdr[i + 4], E2);
+            _mm_storeu_si128((__m128i *)&L1CPUAdr[i + 6], E3);
+
+            E0 = _mm_add_epi64(E0, Inc);
+            E1 = _mm_add_epi64(E1, Inc);
+            E2 = _mm_add_epi64(E2, Inc);
+            E3 = _mm_add_epi64(E3, Inc);
+        }
+    }
+
+    for(; i < NumEntries; i++)
+    {
+        L1CPUAdr[i] = FirstEntry + i * Step;
+    }
 }
 
 GMM_AUXTTL1e GmmLib::AuxTable::CreateAuxL1Data(GMM_RESOURCE_INFO *BaseResInfo)
@@ -916,6 +1814,106 @@ GMM_AUXTTL1e GmmLib::AuxTable::CreateAuxL1Data(GMM_RESOURCE_INFO *BaseResInfo)
     return L1ePartial;
 }
 
+//=============================================================================
+//
+// Function: InitCCSIterator
+//
+// Desc: Positions CCS iterator at main-surface 16K chunk containing AdrOffset,
+//       deriving tile id once as __GetCCSCacheline does for each chunk
+//
+// Caller: MapValidEntry (non-linear CCS)
+//
+// Parameters:
+//      Iter: CCS iterator
+//      BaseResInfo: main surface ResInfo
+//      AuxResInfo: Aux surface ResInfo, NULL for unified Aux
+//      AuxVA: Start adr of Aux-surface
+//      AdrOffset: main-surface offset
+//-----------------------------------------------------------------------------
+void GmmLib::AuxTable::InitCCSIterator(AUX_CCS_ITERATOR *Iter, GMM_RESOURCE_INFO *BaseResInfo, GMM_RESOURCE_INFO *AuxResInfo,
+                                       GMM_GFX_ADDRESS AuxVA, GMM_GFX_SIZE_T AdrOffset)
+{
+    uint32_t BasePitchInTiles = BaseResInfo->GetRenderPitchTiles();
+
+    Iter->AuxVA           = AuxVA;
+    Iter->AuxPitchInTiles = AuxResInfo ? AuxResInfo->GetRenderPitchTiles() : BaseResInfo->GetRenderAuxPitchTiles();
+    Iter->IsYF            = BaseResInfo->GetResFlags().Info.TiledYf ? true : false;
+    Iter->Pitch           = Iter->IsYF ? BasePitchInTiles / 4 : BasePitchInTiles; //Base Pitch is physically padded to 4x1 YF width
+    Iter->Chunk           = AdrOffset >> 14;
+    Iter->x = Iter->y = Iter->SubTile = 0;
+
+    if(Iter->Pitch)
+    {
+        GMM_GFX_SIZE_T Units = Iter->IsYF ? Iter->Chunk : static_cast<uint32_t>(Iter->Chunk >> 2); //4YF-unit or YS-tile count
+
+        Iter->x       = static_cast<uint32_t>(Units % Iter->Pitch);
+        Iter->y       = static_cast<uint32_t>(Units / Iter->Pitch);
+        Iter->SubTile = Iter->IsYF ? 0 : static_cast<uint32_t>(Iter->Chunk % 4);
+    }
+}
+
+//=============================================================================
+//
+// Function: StepCCSIterator
+//
+// Desc: Advances CCS iterator to main-surface 16K chunk containing AdrOffset,
+//       stepping tile id (divides only on row wrap), and computes CCS cacheline
+//       address same as __GetCCSCacheline
+//
+// Caller: MapValidEntry (non-linear CCS)
+//
+// Parameters:
+//      Iter: CCS iterator
+//      AdrOffset: main-surface offset, not below iterator's current chunk
+//
+// Returns:
+//      CCS cacheline address for chunk
+//-----------------------------------------------------------------------------
+GMM_GFX_ADDRESS GmmLib::AuxTable::StepCCSIterator(AUX_CCS_ITERATOR *Iter, GMM_GFX_SIZE_T AdrOffset)
+{
+    GMM_GFX_SIZE_T Step = (AdrOffset >> 14) - Iter->Chunk;
+    uint32_t       i = 0, j = 0;
+    uint32_t       CCSXTile = 0, CCSYTile = 0;
+
+    __GMM_ASSERT((AdrOffset >> 14) >= Iter->Chunk);
+    Iter->Chunk += Step;
+
+    if(Iter->Pitch && Step)
+    {
+        GMM_GFX_SIZE_T x = Iter->x;
+
+        if(Iter->IsYF)
+        {
+            x += Step;
+        }
+        else
+        {
+            Step += Iter->SubTile;
+            Iter->SubTile = static_cast<uint32_t>(Step % 4);
+            x += Step / 4;
+        }
+
+        if(x >= Iter->Pitch)
+        {
+            Iter->y += static_cast<uint32_t>(x / Iter->Pitch);
+            x %= Iter->Pitch;
+        }
+        Iter->x = static_cast<uint32_t>(x);
+    }
+
+    //YS : XYXY [XYXY YF] ie 2x2 16K-units in Y-major
+    i = Iter->IsYF ? Iter->x : 2 * Iter->x + (Iter->SubTile >> 1);
+    j = Iter->IsYF ? Iter->y : 2 * Iter->y + (Iter->SubTile & 1);
+
+    //Compute CCS$ address for <i,j>
+    CCSXTile = i / 8; //8x8 CLs make one CCS Tile; get TileOffset
+    CCSYTile = j / 8;
+    i %= 8;
+    j %= 8;
+
+    return Iter->AuxVA + ((CCSXTile + CCSYTile * Iter->AuxPitchInTiles) * GMM_KBYTE(4)) + (8 * GMM_BYTES(64) * i) + (GMM_BYTES(64) * j);
+}
+
 GMM_GFX_ADDRESS GMM_INLINE GmmLib::AuxTable::__GetCCSCacheline(GMM_RESOURCE_INFO *BaseResInfo, GMM_GFX_ADDRESS BaseAdr,
                                                                GMM_RESOURCE_INFO *AuxResInfo, GMM_GFX_ADDRESS AuxVA, GMM_GFX_SIZE_T AdrOffset)
 {
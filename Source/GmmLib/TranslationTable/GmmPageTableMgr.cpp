@@ -24,6 +24,7 @@ Description: UMD-TT manager (manages both TR-TT and AUX-TT in user mode space)
 ============================================================================*/
 
 #include "Internal/Common/GmmLibInc.h"
+#include <algorithm>
 #include "External/Common/GmmPageTableMgr.h"
 #include "../TranslationTable/GmmUmdTranslationTable.h"
 #include "External/Common/GmmClientContext.h"
@@ -103,6 +104,8 @@ GMM_STATUS GmmLib::__GmmDeviceDealloc(GMM_CLIENT                ClientType,
 // Function: __AllocateNodePool
 //
 // Desc: Allocates (always resident SVM) memory for new Pool node, and updates PageTableMgr object
+//       First pool of each PoolType is PAGETABLE_POOL_MIN_NODES in size, each later one
+//       doubles up to PAGETABLE_POOL_MAX_NODES, so light clients don't pin 2MB pools
 //
 // Parameters:
 //      AddrAlignment: Pool allocation address alignment
@@ -117,17 +120,27 @@ GmmLib::GMM_PAGETABLEPool *GmmLib::GmmPageTableMgr::__AllocateNodePool(uint32_t
     GMM_PAGETABLEPool *pTTPool     = NULL;
     HANDLE             PoolHnd     = 0;
     GMM_CLIENT         ClientType;
-    GMM_DEVICE_ALLOC   Alloc = {0};
+    GMM_DEVICE_ALLOC   Alloc    = {0};
+    int                NumNodes = PAGETABLE_POOL_MIN_NODES;
 
     ENTER_CRITICAL_SECTION
 
-    //Allocate pool, sized PAGETABLE_POOL_MAX_NODES pages, assignable to TR/Aux L1/L2 tables
+    for(GMM_PAGETABLEPool *Pool = pPool; Pool && NumNodes < PAGETABLE_POOL_MAX_NODES; Pool = Pool->GetNextPool())
+    {
+        if(Pool->GetPoolType() == Type)
+        {
+            NumNodes <<= 1;
+        }
+    }
+
+    //Allocate pool, sized NumNodes pages, assignable to TR/Aux L1/L2 tables
     //SVM allocation, always resident
-    Alloc.Size      = PAGETABLE_POOL_SIZE;
+    Alloc.Size      = (GMM_GFX_SIZE_T)NumNodes * PAGE_SIZE;
     Alloc.Alignment = AddrAlignment;
     Alloc.hCsr      = hCsr;
 
     Status = __GmmDeviceAlloc(pClientContext, &DeviceCbInt, &Alloc);
+    __CountCallback(GMM_PAGETABLE_CB_ALLOCATE);
 
     if(Status != GMM_SUCCESS)
     {
@@ -139,14 +152,13 @@ GmmLib::GMM_PAGETABLEPool *GmmLib::GmmPageTableMgr::__AllocateNodePool(uint32_t
     PoolHnd     = Alloc.Handle;
     pGmmResInfo = (GMM_RESOURCE_INFO *)Alloc.Priv;
 
-    pTTPool = new GMM_PAGETABLEPool(PoolHnd, pGmmResInfo, Alloc.GfxVA, Alloc.CPUVA, Type);
+    pTTPool = new(pClientContext->GetAllocatorCb(), GMM_HEAP_PAGETABLE) GMM_PAGETABLEPool(PoolHnd, pGmmResInfo, Alloc.GfxVA, Alloc.CPUVA, Type, NumNodes);
 
 
     if(pTTPool)
     {
         if(pPool)
         {
-            NumNodePoolElements++;
             if(Type == POOL_TYPE_TRTTL2) // TRTT-L2 not 1st node in Pool LinkedList, place it at beginning
             {
                 pPool = pPool->InsertInListAtBegin(pTTPool);
@@ -155,12 +167,14 @@ GmmLib::GMM_PAGETABLEPool *GmmLib::GmmPageTableMgr::__AllocateNodePool(uint32_t
             {
                 pTTPool = pPool->InsertInList(pTTPool);
             }
+            GMM_TT_STORE_RELEASE(&NumNodePoolElements, NumNodePoolElements + 1);
         }
         else
         {
-            NumNodePoolElements = 1;
-            pPool               = pTTPool;
+            pPool = pTTPool;
+            GMM_TT_STORE_RELEASE(&NumNodePoolElements, 1);
         }
+        __LogBOListChange(PoolHnd, true);
     }
     else
     {
@@ -176,7 +190,9 @@ GmmLib::GMM_PAGETABLEPool *GmmLib::GmmPageTableMgr::__AllocateNodePool(uint32_t
 //
 // Function: __ReleaseUnusedPool
 //
-// Desc: Frees up unused PageTablePools once residency limit is hit
+// Desc: Retires unused PageTablePools once residency limit is hit. Retired pools
+//       are unlinked from pool list (and BO list) without waiting for Gpu, and
+//       freed by ReclaimPools once their last BB fence is complete
 //
 // Parameters:
 //      UmdContext: pointer to caller thread's context (containing BBHandle/Fence info)
@@ -184,58 +200,214 @@ GmmLib::GMM_PAGETABLEPool *GmmLib::GmmPageTableMgr::__AllocateNodePool(uint32_t
 //-----------------------------------------------------------------------------
 void GmmLib::GmmPageTableMgr::__ReleaseUnusedPool(GMM_UMD_SYNCCONTEXT *UmdContext)
 {
-    GMM_STATUS                 Status         = GMM_SUCCESS;
     GMM_GFX_SIZE_T             PoolSizeToFree = {0};
-    GMM_GFX_SIZE_T             FreedSize      = {0};
+    GMM_GFX_SIZE_T             RetiredSize    = {0};
     GmmLib::GMM_PAGETABLEPool *Pool = NULL, *PrevPool = NULL;
     uint32_t                   i = 0;
-    GMM_CLIENT                 ClientType;
-    GMM_DEVICE_DEALLOC         Dealloc;
-
-    GET_GMM_CLIENT_TYPE(pClientContext, ClientType);
 
     ENTER_CRITICAL_SECTION
     if(pPool->__IsUnusedTRTTPoolOverLimit(&PoolSizeToFree))
     {
-        for(i = 0; i < NumNodePoolElements && FreedSize < PoolSizeToFree; i++)
+        for(i = 0; i < NumNodePoolElements && RetiredSize < PoolSizeToFree; i++)
         {
             Pool = (PrevPool) ? PrevPool->GetNextPool() : pPool;
 
-            if(Pool->IsPoolInUse(UmdContext ? SyncInfo(UmdContext->BBFenceObj, UmdContext->BBLastFence) : SyncInfo()))
+            //Pool referenced by next BB submission must stay in BO list, evacuated pools are retired by compaction
+            if(Pool->IsPoolInUse(UmdContext ? SyncInfo(UmdContext->BBFenceObj, UmdContext->BBLastFence) : SyncInfo()) ||
+               Pool->IsEvacuating())
             {
                 PrevPool = Pool;
                 continue;
             }
 
-            if(GmmCheckForNullDevCbPfn(ClientType, &DeviceCbInt, GMM_DEV_CB_WAIT_FROM_CPU))
-            {
-                GMM_DDI_WAITFORSYNCHRONIZATIONOBJECTFROMCPU Wait = {0};
-                Wait.bo                                          = Pool->GetPoolHandle();
-                GmmDeviceCallback(ClientType, &DeviceCbInt, &Wait);
-            }
+            RetiredSize += Pool->GetPoolSize();
+            __RetirePool(Pool, PrevPool);
+            i--;
+        }
+    }
+    EXIT_CRITICAL_SECTION
+}
 
-            Dealloc.Handle = Pool->GetPoolHandle();
-            Dealloc.GfxVA  = Pool->GetGfxAddress();
-            Dealloc.Priv   = Pool->GetGmmResInfo();
-            Dealloc.hCsr   = hCsr;
+//=============================================================================
+//
+// Function: __RetirePool
+//
+// Desc: Unlinks pool from pool list (and BO list) onto retired list, to be freed
+//       by ReclaimPools once its PoolBBInfo fence completes.
+//       Caller must hold PoolLock
+//
+// Parameters:
+//      Pool: unused PageTablePool
+//      PrevPool: Pool's predecessor in pool list, NULL if Pool is list head
+//-----------------------------------------------------------------------------
+void GmmLib::GmmPageTableMgr::__RetirePool(GMM_PAGETABLEPool *Pool, GMM_PAGETABLEPool *PrevPool)
+{
+    __GMM_ASSERT(Pool->IsPoolUnused());
 
-            Status = __GmmDeviceDealloc(ClientType, &DeviceCbInt, &Dealloc, pClientContext);
+    if(PrevPool)
+    {
+        PrevPool->GetNextPool() = Pool->GetNextPool();
+    }
+    else
+    {
+        pPool = Pool->GetNextPool();
+    }
+    __RemoveFromFreePoolList(Pool);
+    GMM_TT_STORE_RELEASE(&NumNodePoolElements, NumNodePoolElements - 1);
+    __LogBOListChange(Pool->GetPoolHandle(), false);
 
-            __GMM_ASSERT(GMM_SUCCESS == Status);
+    Pool->GetNextPool() = pRetiredPool;
+    pRetiredPool        = Pool;
+    NumRetiredPools++;
+}
 
-            if(PrevPool)
-            {
-                PrevPool->GetNextPool() = Pool->GetNextPool();
-            }
-            else
-            {
-                pPool = Pool->GetNextPool();
-            }
-            delete Pool;
-            FreedSize += PAGETABLE_POOL_SIZE;
+//=============================================================================
+//
+// Function: __LogBOListChange
+//
+// Desc: Records pool added to/removed from pool list (BO list) and bumps BO list
+//       generation, published after the record for lock-free generation check.
+//       Caller must hold PoolLock
+//
+// Parameters:
+//      bo: Pool's BO handle
+//      Added: true if added, false if removed
+//-----------------------------------------------------------------------------
+void GmmLib::GmmPageTableMgr::__LogBOListChange(HANDLE bo, bool Added)
+{
+    GMM_PAGETABLE_BO_CHANGE &Change = BOListLog[BOListGen % GMM_PAGETABLE_BO_CHANGE_LOG_SIZE];
+
+    Change.bo    = bo;
+    Change.Added = Added ? 1 : 0;
+    GMM_TT_STORE_RELEASE(&BOListGen, BOListGen + 1);
+}
+
+//=============================================================================
+//
+// Function: __ReviveRetiredPool
+//
+// Desc: Moves retired pool of given PoolType back to pool list, instead of
+//       allocating new pool. Its nodes are all unassigned, same as freshly
+//       released pool nodes that get reassigned without Gpu wait.
+//       Caller must hold PoolLock
+//
+// Parameters:
+//      Type: AuxTT_L1/L2 pool
+//
+// Returns:
+//     PageTablePool element, NULL if no retired pool of PoolType exists
+//-----------------------------------------------------------------------------
+GmmLib::GMM_PAGETABLEPool *GmmLib::GmmPageTableMgr::__ReviveRetiredPool(GmmLib::POOL_TYPE Type)
+{
+    GMM_PAGETABLEPool **ppNext = &pRetiredPool;
+    GMM_PAGETABLEPool * Pool   = NULL;
+
+    while(*ppNext && (*ppNext)->GetPoolType() != Type)
+    {
+        ppNext = &(*ppNext)->GetNextPool();
+    }
+
+    if(!(Pool = *ppNext))
+    {
+        return NULL;
+    }
+
+    *ppNext             = Pool->GetNextPool();
+    Pool->GetNextPool() = NULL;
+    NumRetiredPools--;
+
+    if(pPool)
+    {
+        if(Type == POOL_TYPE_TRTTL2) // TRTT-L2 not 1st node in Pool LinkedList, place it at beginning
+        {
+            pPool = pPool->InsertInListAtBegin(Pool);
+        }
+        else
+        {
+            pPool->InsertInList(Pool);
         }
+        GMM_TT_STORE_RELEASE(&NumNodePoolElements, NumNodePoolElements + 1);
     }
-    EXIT_CRITICAL_SECTION
+    else
+    {
+        pPool = Pool;
+        GMM_TT_STORE_RELEASE(&NumNodePoolElements, 1);
+    }
+    __LogBOListChange(Pool->GetPoolHandle(), true);
+
+    return Pool;
+}
+
+//=============================================================================
+//
+// Function: __FreeRetiredPool
+//
+// Desc: Frees retired PageTablePool's memory. Caller must hold PoolLock and
+//       have unlinked pool from retired list
+//
+// Parameters:
+//      Pool: retired PageTablePool
+//      WaitForIdle: waits on Cpu for Gpu to be idle on pool before freeing
+//-----------------------------------------------------------------------------
+void GmmLib::GmmPageTableMgr::__FreeRetiredPool(GMM_PAGETABLEPool *Pool, bool WaitForIdle)
+{
+    GMM_STATUS         Status = GMM_SUCCESS;
+    GMM_CLIENT         ClientType;
+    GMM_DEVICE_DEALLOC Dealloc;
+
+    GET_GMM_CLIENT_TYPE(pClientContext, ClientType);
+
+    if(WaitForIdle && GmmCheckForNullDevCbPfn(ClientType, &DeviceCbInt, GMM_DEV_CB_WAIT_FROM_CPU))
+    {
+        GMM_DDI_WAITFORSYNCHRONIZATIONOBJECTFROMCPU Wait = {0};
+        Wait.bo                                          = Pool->GetPoolHandle();
+        GmmDeviceCallback(ClientType, &DeviceCbInt, &Wait);
+        __CountCallback(GMM_PAGETABLE_CB_WAIT_FROM_CPU);
+    }
+
+    Dealloc.Handle = Pool->GetPoolHandle();
+    Dealloc.GfxVA  = Pool->GetGfxAddress();
+    Dealloc.Priv   = Pool->GetGmmResInfo();
+    Dealloc.hCsr   = hCsr;
+
+    Status = __GmmDeviceDealloc(ClientType, &DeviceCbInt, &Dealloc, pClientContext);
+    __CountCallback(GMM_PAGETABLE_CB_DEALLOCATE);
+
+    __GMM_ASSERT(GMM_SUCCESS == Status);
+
+    delete Pool;
+}
+
+//=============================================================================
+//
+// Function: __CountCallback
+//
+// Desc: Counts client callback issued, reported by GetStats. Callbacks are
+//       issued under different locks (L3e, PoolLock), counter is updated atomically
+//
+// Parameters:
+//      Type: callback type
+//-----------------------------------------------------------------------------
+void GmmLib::GmmPageTableMgr::__CountCallback(GMM_PAGETABLE_CB_TYPE Type)
+{
+    GMM_TT_ATOMIC_ADD64(&NumCallbacks[Type], 1);
+}
+
+//=============================================================================
+//
+// Function: __WriteL2L3Entry
+//
+// Desc: Gpu-updates L2/L3 (or fallback L1) entry via client's pfWriteL2L3Entry
+//
+// Parameters:
+//      CmdQHandle: client cmdQ
+//      EntryAdr: Gfx address of table entry
+//      Data: entry value
+//-----------------------------------------------------------------------------
+void GmmLib::GmmPageTableMgr::__WriteL2L3Entry(HANDLE CmdQHandle, GMM_GFX_ADDRESS EntryAdr, uint64_t Data)
+{
+    __CountCallback(GMM_PAGETABLE_CB_WRITE_L2L3_ENTRY);
+    TTCb.pfWriteL2L3Entry(CmdQHandle, EntryAdr, Data);
 }
 
 //=============================================================================
@@ -244,6 +416,8 @@ void GmmLib::GmmPageTableMgr::__ReleaseUnusedPool(GMM_UMD_SYNCCONTEXT *UmdContex
 //
 // Desc: Finds free node within existing PageTablePool(s), if no such node found,
 //       allocates new PageTablePool. Caller should update Pool Node usage
+//       Pools with free nodes are kept in per-PoolType list, so lookup doesn't
+//       depend on number of pools.
 //
 // Parameters:
 //      FreePoolNodeIdx: pointer to return Pool's free Node index
@@ -255,61 +429,156 @@ void GmmLib::GmmPageTableMgr::__ReleaseUnusedPool(GMM_UMD_SYNCCONTEXT *UmdContex
 //-----------------------------------------------------------------------------
 GmmLib::GMM_PAGETABLEPool *GmmLib::GmmPageTableMgr::__GetFreePoolNode(uint32_t *FreePoolNodeIdx, POOL_TYPE PoolType)
 {
-    uint32_t PoolNode = -1, i = 0, j = 0, DWdivisor = 1, IdxMultiplier = 1;
-    bool     PoolNodeFound = false, TRTTPool = false;
+    uint32_t IdxMultiplier = 1;
+    bool     TRTTPool      = false;
 
     ENTER_CRITICAL_SECTION
-    GmmLib::GMM_PAGETABLEPool *Pool = pPool;
+    GmmLib::GMM_PAGETABLEPool *Pool = pFreePool[PoolType];
+
+    //Pools that got full since listed are dropped here, re-listed once a node is released
+    while(Pool && !Pool->GetFreeNode(FreePoolNodeIdx))
+    {
+        pFreePool[PoolType]       = Pool->GetNextFreePool();
+        Pool->GetNextFreePool()   = NULL;
+        Pool->IsInFreePoolList()  = false;
+        Pool                      = pFreePool[PoolType];
+    }
+
+    if(Pool)
+    {
+        __GMM_ASSERT(Pool->GetPoolType() == PoolType);
+        EXIT_CRITICAL_SECTION
+        return Pool;
+    }
 
-    Pool = (PoolType == POOL_TYPE_TRTTL2) ? Pool : //1st pool reserved for TRTT-L2, since TRTT-L2 pruning not supported yet,
-           (Pool ? Pool->GetNextPool() : NULL);    //other pools can be TR-L1/Aux-L1/Aux-L2 (and support dynamic pruning)
+    //No free pool node, reuse retired pool or allocate new
     TRTTPool      = (PoolType == POOL_TYPE_TRTTL2 || PoolType == POOL_TYPE_TRTTL1) ? true : false;
-    DWdivisor     = TRTTPool ? 8 * sizeof(uint32_t) : (PoolType == POOL_TYPE_AUXTTL2) ? 8 * sizeof(uint32_t) * AUX_L2TABLE_SIZE_IN_POOLNODES : 8 * sizeof(uint32_t) * AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetLibContext());
     IdxMultiplier = TRTTPool ? 1 : (PoolType == POOL_TYPE_AUXTTL2) ? AUX_L2TABLE_SIZE_IN_POOLNODES : AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetLibContext());
-    //Scan existing PageTablePools for free pool node
-    for(i = (PoolType == POOL_TYPE_TRTTL2) ? 0 : 1; Pool && i < NumNodePoolElements; i++)
+    if((Pool = __ReviveRetiredPool(PoolType)) ||
+       (Pool = __AllocateNodePool(IdxMultiplier * PAGE_SIZE, PoolType)))
     {
-        if(Pool->GetNumFreeNode() > 0 && Pool->GetPoolType() == PoolType)
-        {
-            PoolNodeFound    = true;
-            *FreePoolNodeIdx = 0;
-            for(; j < PAGETABLE_POOL_MAX_NODES / DWdivisor; j++)
-            {
-                if(_BitScanForward((uint32_t *)&PoolNode, (uint32_t) ~(Pool->GetNodeUsageAtIndex(j)))) // Get LSB that has value 0
-                {
-                    *FreePoolNodeIdx += PoolNode * IdxMultiplier;
-                    PoolNodeFound = true;
-                    break;
-                }
-                PoolNodeFound = false;
-                *FreePoolNodeIdx += DWdivisor; //DWORD size in bits
-            }
-        }
-        if(PoolNodeFound)
-        {
-            __GMM_ASSERT(Pool->GetPoolType() == PoolType);
-            EXIT_CRITICAL_SECTION
-            return Pool;
-        }
-        Pool = Pool->GetNextPool();
+        __GMM_ASSERT(Pool->GetPoolType() == PoolType);
+        __AddToFreePoolList(Pool);
+
+        *FreePoolNodeIdx = 0;
+        EXIT_CRITICAL_SECTION
+        return Pool;
+    }
+
+    EXIT_CRITICAL_SECTION
+    return NULL;
+}
+
+//=============================================================================
+//
+// Function: __AddToFreePoolList
+//
+// Desc: Lists pool for its PoolType, once it has unassigned node(s).
+//       Pools being evacuated by compaction stay unlisted.
+//       Caller must hold PoolLock
+//
+// Parameters:
+//      Pool: PageTablePool whose node got released/allocated
+//-----------------------------------------------------------------------------
+void GmmLib::GmmPageTableMgr::__AddToFreePoolList(GMM_PAGETABLEPool *Pool)
+{
+    if(!Pool->IsInFreePoolList() && !Pool->IsEvacuating())
+    {
+        Pool->GetNextFreePool()        = pFreePool[Pool->GetPoolType()];
+        pFreePool[Pool->GetPoolType()] = Pool;
+        Pool->IsInFreePoolList()       = true;
+    }
+}
+
+//=============================================================================
+//
+// Function: __RemoveFromFreePoolList
+//
+// Desc: Unlists pool from its PoolType's free-pool list, before it's released
+//
+// Parameters:
+//      Pool: PageTablePool being released
+//-----------------------------------------------------------------------------
+void GmmLib::GmmPageTableMgr::__RemoveFromFreePoolList(GMM_PAGETABLEPool *Pool)
+{
+    GMM_PAGETABLEPool **ppNext = &pFreePool[Pool->GetPoolType()];
+
+    if(!Pool->IsInFreePoolList())
+    {
+        return;
     }
 
-    //No free pool node, allocate new
-    if(!PoolNodeFound)
+    while(*ppNext && *ppNext != Pool)
     {
-        GMM_PAGETABLEPool *Pool = NULL;
-        if(Pool = __AllocateNodePool(IdxMultiplier * PAGE_SIZE, PoolType))
-        {
-            __GMM_ASSERT(Pool->GetPoolType() == PoolType);
+        ppNext = &(*ppNext)->GetNextFreePool();
+    }
 
-            *FreePoolNodeIdx = 0;
-            EXIT_CRITICAL_SECTION
-            return Pool;
-        }
+    if(*ppNext)
+    {
+        *ppNext = Pool->GetNextFreePool();
+    }
+    Pool->GetNextFreePool()  = NULL;
+    Pool->IsInFreePoolList() = false;
+}
+
+//=============================================================================
+//
+// Function: __AssignFreePoolNode
+//
+// Desc: Finds free pool node (allocating new pool if needed) and marks it
+//       assigned, atomically wrt other threads allocating/releasing nodes.
+//
+// Caller: PageTable L1/L2 table allocation
+//
+// Parameters:
+//      FreePoolNodeIdx: pointer to return Pool's assigned Node index
+//      PoolType: AuxTT_L1/L2 pool
+//      NodeBBInfo: returns BB info of node's previous use, for the new table
+//
+// Returns:
+//     PageTablePool element containing assigned node, NULL if none available
+//-----------------------------------------------------------------------------
+GmmLib::GMM_PAGETABLEPool *GmmLib::GmmPageTableMgr::__AssignFreePoolNode(uint32_t *FreePoolNodeIdx, POOL_TYPE PoolType, SyncInfo *NodeBBInfo)
+{
+    GmmLib::GMM_PAGETABLEPool *Pool = NULL;
+
+    ENTER_CRITICAL_SECTION
+    Pool = __GetFreePoolNode(FreePoolNodeIdx, PoolType);
+    if(Pool)
+    {
+        *NodeBBInfo = Pool->GetNodeBBInfoAtIndex(*FreePoolNodeIdx);
+        Pool->AssignNode(*FreePoolNodeIdx, Pool->GetTableNodes());
     }
+    EXIT_CRITICAL_SECTION
 
+    return Pool;
+}
+
+//=============================================================================
+//
+// Function: __ReleasePoolNode
+//
+// Desc: Marks pool node unassigned, and retires unused pools once the pool
+//       has no assigned nodes left
+//
+// Caller: DEASSIGN_POOLNODE
+//
+// Parameters:
+//      UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+//      Pool: PageTablePool containing the node
+//      NodeIdx: first pool node of released table
+//      PerTableNodes: pool nodes per table
+//-----------------------------------------------------------------------------
+void GmmLib::GmmPageTableMgr::__ReleasePoolNode(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_PAGETABLEPool *Pool, int NodeIdx, int PerTableNodes)
+{
+    ENTER_CRITICAL_SECTION
+    Pool->DeassignNode(NodeIdx, PerTableNodes);
+    __AddToFreePoolList(Pool);
+    if(Pool->IsPoolUnused())
+    {
+        __ReleaseUnusedPool(UmdContext);
+    }
     EXIT_CRITICAL_SECTION
-    return NULL;
 }
 
 
@@ -350,7 +619,7 @@ GmmLib::GmmPageTableMgr::GmmPageTableMgr(GMM_DEVICE_CALLBACKS_INT *DeviceCB, uin
     //Initialize PageTableMgr further, only if PageTable creation succeeded
     try
     {
-        ptr                 = new GmmPageTableMgr();
+        ptr                 = new(pClientContextIn->GetAllocatorCb(), GMM_HEAP_PAGETABLE) GmmPageTableMgr();
         ptr->pClientContext = pClientContextIn;
         memcpy(&ptr->DeviceCbInt, DeviceCB, sizeof(GMM_DEVICE_CALLBACKS_INT));
 
@@ -358,7 +627,7 @@ GmmLib::GmmPageTableMgr::GmmPageTableMgr(GMM_DEVICE_CALLBACKS_INT *DeviceCB, uin
            !pClientContextIn->GetSkuTable().FtrFlatPhysCCS)
         {
             __GMM_ASSERT(TTFlags & AUXTT); //Aux-TT is mandatory
-            ptr->AuxTTObj = new AuxTable(pClientContext);
+            ptr->AuxTTObj = new(pClientContextIn->GetAllocatorCb(), GMM_HEAP_PAGETABLE) AuxTable(pClientContext);
             if(!ptr->AuxTTObj)
             {
                 goto ERROR_CASE;
@@ -473,12 +742,156 @@ GMM_STATUS GmmLib::GmmPageTableMgr::InitContextAuxTableRegister(HANDLE CmdQHandl
 /////////////////////////////////////////////////////////////////////////////////////
 GMM_STATUS GmmLib::GmmPageTableMgr::UpdateAuxTable(const GMM_DDI_UPDATEAUXTABLE *UpdateReq)
 {
+    return UpdateAuxTables(UpdateReq, 1, NULL);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Updates the Aux-PageTables for multiple base resources. Requests are applied in
+/// BaseGpuVA order so consecutive ones reuse the same L2/L1 tables, Gpu-updates on
+/// a cmdQ are bracketed by single pfPrologTranslationTable/pfEpilogTranslationTable.
+/// Requests whose VA ranges overlap are applied in caller's order, only the runs of
+/// disjoint requests between them are reordered.
+///
+/// @param[in]  UpdateReqs: array of AuxTable update requests
+/// @param[in]  NumReqs: number of requests in UpdateReqs
+/// @param[out] pStatus: optional array of NumReqs, returns status of each request
+/// @return     GMM_SUCCESS if all requests succeeded, else status of first failed request
+/////////////////////////////////////////////////////////////////////////////////////
+GMM_STATUS GmmLib::GmmPageTableMgr::UpdateAuxTables(const GMM_DDI_UPDATEAUXTABLE *UpdateReqs, uint32_t NumReqs, GMM_STATUS *pStatus)
+{
+    GMM_STATUS Status    = GMM_SUCCESS;
+    uint32_t   FailedIdx = NumReqs;
+    uint32_t   SingleIdx = 0;
+    uint32_t * Order     = &SingleIdx;
+    HANDLE     CmdQ      = NULL; //cmdQ with pending prolog
+
     if(GetAuxL3TableAddr() == 0ULL)
     {
         GMM_ASSERTDPF(0, "Invalid AuxTable update request, AuxTable is not initialized");
         return GMM_INVALIDPARAM;
     }
 
+    __GMM_ASSERTPTR(UpdateReqs && NumReqs, GMM_INVALIDPARAM);
+
+    if(NumReqs > 1)
+    {
+        Order = NewArray<uint32_t>(pClientContext->GetAllocatorCb(), NumReqs, GMM_HEAP_PAGETABLE);
+        if(!Order)
+        {
+            return GMM_OUT_OF_MEMORY;
+        }
+
+        for(uint32_t i = 0; i < NumReqs; i++)
+        {
+            Order[i] = i;
+        }
+
+        auto ByVA = [UpdateReqs](uint32_t a, uint32_t b) {
+            return UpdateReqs[a].BaseGpuVA < UpdateReqs[b].BaseGpuVA;
+        };
+        auto Overlap = [UpdateReqs](uint32_t a, uint32_t b) {
+            return UpdateReqs[a].BaseGpuVA < UpdateReqs[b].BaseGpuVA + UpdateReqs[b].BaseResInfo->GetSizeMainSurface() &&
+                   UpdateReqs[b].BaseGpuVA < UpdateReqs[a].BaseGpuVA + UpdateReqs[a].BaseResInfo->GetSizeMainSurface();
+        };
+
+        std::stable_sort(Order, Order + NumReqs, ByVA);
+
+        //Requests with overlapping VA ranges must keep caller's order (eg map B, then unmap A
+        //covering B), so if any overlap only caller-order runs of disjoint requests are sorted
+        GMM_GFX_ADDRESS MaxEnd      = 0;
+        uint32_t        NumDisjoint = 0;
+        for(; NumDisjoint < NumReqs && UpdateReqs[Order[NumDisjoint]].BaseGpuVA >= MaxEnd; NumDisjoint++)
+        {
+            MaxEnd = GFX_MAX(MaxEnd, UpdateReqs[Order[NumDisjoint]].BaseGpuVA + UpdateReqs[Order[NumDisjoint]].BaseResInfo->GetSizeMainSurface());
+        }
+
+        if(NumDisjoint < NumReqs)
+        {
+            uint32_t RunStart = 0;
+
+            for(uint32_t i = 0; i < NumReqs; i++)
+            {
+                Order[i] = i;
+            }
+
+            for(uint32_t i = 1; i <= NumReqs; i++)
+            {
+                bool EndRun = (i == NumReqs);
+                for(uint32_t j = RunStart; !EndRun && j < i; j++)
+                {
+                    EndRun = Overlap(i, j);
+                }
+
+                if(EndRun)
+                {
+                    std::stable_sort(Order + RunStart, Order + i, ByVA);
+                    RunStart = i;
+                }
+            }
+        }
+    }
+
+    for(uint32_t n = 0; n < NumReqs; n++)
+    {
+        const GMM_DDI_UPDATEAUXTABLE *UpdateReq = &UpdateReqs[Order[n]];
+        GMM_STATUS                    ReqStatus = __ValidateAuxTableUpdate(UpdateReq);
+
+        if(ReqStatus == GMM_SUCCESS)
+        {
+            //Gpu-update only if client provided cmdQ and translation-table callbacks to program it,
+            //non-TR maps Cpu-update unless client opted in with SetAuxMapGpuUpdate
+            uint8_t CpuUpdate = UpdateReq->DoNotWait || !(UpdateReq->UmdContext && UpdateReq->UmdContext->pCommandQueueHandle) ||
+                                !TTCb.pfWriteL2L3Entry ||
+                                (UpdateReq->Map && !UpdateReq->BaseResInfo->GetResFlags().Gpu.TiledResource && !AuxMapGpuUpdate);
+
+            if(!CpuUpdate && UpdateReq->UmdContext->pCommandQueueHandle != CmdQ)
+            {
+                if(CmdQ)
+                {
+                    TTCb.pfEpilogTranslationTable(CmdQ, 1); // ForceFlush
+                    __CountCallback(GMM_PAGETABLE_CB_EPILOG);
+                }
+                CmdQ = UpdateReq->UmdContext->pCommandQueueHandle;
+                TTCb.pfPrologTranslationTable(CmdQ);
+                __CountCallback(GMM_PAGETABLE_CB_PROLOG);
+            }
+
+            ReqStatus = __UpdateAuxTable(UpdateReq, CpuUpdate);
+        }
+
+        if(pStatus)
+        {
+            pStatus[Order[n]] = ReqStatus;
+        }
+        if(ReqStatus != GMM_SUCCESS && Order[n] < FailedIdx)
+        {
+            FailedIdx = Order[n];
+            Status    = ReqStatus;
+        }
+    }
+
+    if(CmdQ)
+    {
+        TTCb.pfEpilogTranslationTable(CmdQ, 1); // ForceFlush
+        __CountCallback(GMM_PAGETABLE_CB_EPILOG);
+    }
+
+    if(Order != &SingleIdx)
+    {
+        DeleteArray(Order);
+    }
+
+    return Status;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Checks if AuxTable update request is valid for given base/Aux resources
+///
+/// @param[in]  UpdateReq: AuxTable update request
+/// @return     GMM_SUCCESS if request can be applied, GMM_INVALIDPARAM otherwise
+/////////////////////////////////////////////////////////////////////////////////////
+GMM_STATUS GmmLib::GmmPageTableMgr::__ValidateAuxTableUpdate(const GMM_DDI_UPDATEAUXTABLE *UpdateReq)
+{
     if(!((UpdateReq->BaseResInfo->GetResFlags().Info.RenderCompressed ||
           UpdateReq->BaseResInfo->GetResFlags().Info.MediaCompressed) &&
          ((!UpdateReq->AuxResInfo && UpdateReq->BaseResInfo->GetResFlags().Gpu.UnifiedAuxSurface) ||
@@ -502,20 +915,34 @@ GMM_STATUS GmmLib::GmmPageTableMgr::UpdateAuxTable(const GMM_DDI_UPDATEAUXTABLE
         }
     }
 
-    ENTER_CRITICAL_SECTION
+    return GMM_SUCCESS;
+}
 
-    if(UpdateReq->Map)
-    {
-        //Get AuxL1e data (other than CCS-adr) from main surface
-        uint64_t   PartialL1e = AuxTTObj->CreateAuxL1Data(UpdateReq->BaseResInfo).Value;
+/////////////////////////////////////////////////////////////////////////////////////
+/// Applies single AuxTable update request, caller has validated it and brackets
+/// Gpu-update with pfPrologTranslationTable/pfEpilogTranslationTable
+///
+/// @param[in]  UpdateReq: AuxTable update request
+/// @param[in]  CpuUpdate: 1 to update tables on CPU, 0 for Gpu-update on request's cmdQ
+/// @return     GMM_STATUS
+/////////////////////////////////////////////////////////////////////////////////////
+GMM_STATUS GmmLib::GmmPageTableMgr::__UpdateAuxTable(const GMM_DDI_UPDATEAUXTABLE *UpdateReq, uint8_t CpuUpdate)
+{
+    //AuxTable serializes updates per L3e (64GB VA range), pool node (de)allocation under PoolLock
+    if(UpdateReq->Map)
+    {
+        //Get AuxL1e data (other than CCS-adr) from main surface
+        uint64_t   PartialL1e = AuxTTObj->CreateAuxL1Data(UpdateReq->BaseResInfo).Value;
         GMM_STATUS Status     = GMM_SUCCESS;
 
+        //Deferred invalidation of reused VA must land before new mappings, not at next flush
+        AuxTTObj->InvalidatePendingOverlap(UpdateReq->UmdContext, UpdateReq->BaseGpuVA, UpdateReq->BaseResInfo->GetSizeMainSurface(), CpuUpdate);
+
         if(UpdateReq->BaseResInfo->GetResFlags().Gpu.TiledResource)
         {
             //Aux-TT is sparsely updated, for TRs, upon change in mapping state ie
             // null->non-null must be mapped
             // non-null->null        invalidated on AuxTT
-            uint8_t CpuUpdate = UpdateReq->DoNotWait || !(UpdateReq->UmdContext && UpdateReq->UmdContext->pCommandQueueHandle);
 
             GMM_GFX_ADDRESS AuxVA = UpdateReq->AuxSurfVA;
             if(UpdateReq->BaseResInfo->GetResFlags().Gpu.UnifiedAuxSurface)
@@ -587,11 +1014,10 @@ GMM_STATUS GmmLib::GmmPageTableMgr::UpdateAuxTable(const GMM_DDI_UPDATEAUXTABLE
 
                     //(Flat mapping): Remove main/aux resInfo from params
                     Status = AuxTTObj->MapValidEntry(UpdateReq->UmdContext, BaseSurfVA, MapSize, UpdateReq->BaseResInfo,
-                                                     AuxSurfVA, UpdateReq->AuxResInfo, PartialL1e, 1);
+                                                     AuxSurfVA, UpdateReq->AuxResInfo, PartialL1e, CpuUpdate);
                     if(Status != GMM_SUCCESS)
                     {
                         GMM_ASSERTDPF(0, "Insufficient memory, free resources and try again");
-                        EXIT_CRITICAL_SECTION
                         return Status;
                     }
                 }
@@ -600,14 +1026,504 @@ GMM_STATUS GmmLib::GmmPageTableMgr::UpdateAuxTable(const GMM_DDI_UPDATEAUXTABLE
     }
     else
     {
-        //Invalidate all mappings for given main surface
-        AuxTTObj->InvalidateTable(UpdateReq->UmdContext, UpdateReq->BaseGpuVA, UpdateReq->BaseResInfo->GetSizeMainSurface(), UpdateReq->DoNotWait);
+        //Invalidate all mappings for given main surface, unless queued for deferred invalidation
+        if(!AuxTTObj->QueueInvalidate(UpdateReq->BaseGpuVA, UpdateReq->BaseResInfo->GetSizeMainSurface()))
+        {
+            AuxTTObj->InvalidateTable(UpdateReq->UmdContext, UpdateReq->BaseGpuVA, UpdateReq->BaseResInfo->GetSizeMainSurface(), CpuUpdate);
+        }
+    }
+
+    return GMM_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Enables/disables deferred Aux-Table invalidation. While enabled, unmap requests
+/// queue their VA range (merged with overlapping/adjacent ones) instead of walking
+/// the tables; FlushAuxTableInvalidations invalidates them in bulk. Mapping a VA
+/// range with pending invalidation invalidates the overlap first.
+///
+/// @param[in]  Enable: 1 to defer invalidation, 0 to invalidate on unmap. Ranges
+///             pending when disabled stay queued until next flush
+/////////////////////////////////////////////////////////////////////////////////////
+void GmmLib::GmmPageTableMgr::SetDeferredAuxInvalidation(uint8_t Enable)
+{
+    if(AuxTTObj)
+    {
+        AuxTTObj->SetDeferredInvalidate(Enable ? true : false);
     }
+}
 
+/////////////////////////////////////////////////////////////////////////////////////
+/// Enables/disables Gpu-update of non-TR Aux-Table maps. Maps update the tables on
+/// CPU by default; once enabled, maps of requests carrying a cmdQ (and !DoNotWait)
+/// write their L1/L2 entries through the translation-table callbacks on that cmdQ.
+///
+/// @param[in]  Enable: 1 to Gpu-update maps, 0 to Cpu-update them
+/////////////////////////////////////////////////////////////////////////////////////
+void GmmLib::GmmPageTableMgr::SetAuxMapGpuUpdate(uint8_t Enable)
+{
+    AuxMapGpuUpdate = Enable ? 1 : 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Enables/disables coalesced Gpu-update of L1 entries through pfWriteL1Entries.
+/// pfWriteL1Entries takes DWORDs, so by default each L1e is written individually
+/// with pfWriteL2L3Entry to keep its update atomic. Clients enable it only if their
+/// pfWriteL1Entries command writes every QWORD of the run atomically.
+///
+/// @param[in]  Enable: 1 if pfWriteL1Entries writes L1e atomically, 0 otherwise
+/////////////////////////////////////////////////////////////////////////////////////
+void GmmLib::GmmPageTableMgr::SetAtomicL1EntriesWrite(uint8_t Enable)
+{
+    AtomicL1EntriesWrite = Enable ? 1 : 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Invalidates all Aux-Table ranges queued by deferred unmaps, clients call it at
+/// their sync point (eg before batch submission). Gpu-update is bracketed by single
+/// pfPrologTranslationTable/pfEpilogTranslationTable. Released tables' pool nodes
+/// are reused/freed only after their last Gpu-update fence retires.
+///
+/// @param[in]  UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+/// @param[in]  DoNotWait: 1 for CPU update, 0 for async(Gpu) update
+/// @return     GMM_STATUS
+/////////////////////////////////////////////////////////////////////////////////////
+GMM_STATUS GmmLib::GmmPageTableMgr::FlushAuxTableInvalidations(GMM_UMD_SYNCCONTEXT *UmdContext, uint8_t DoNotWait)
+{
+    GMM_STATUS Status = GMM_SUCCESS;
+    uint8_t    CpuUpdate;
+
+    if(GetAuxL3TableAddr() == 0ULL)
+    {
+        GMM_ASSERTDPF(0, "Invalid AuxTable flush request, AuxTable is not initialized");
+        return GMM_INVALIDPARAM;
+    }
+
+    if(!AuxTTObj->GetNumPendingInvalidations())
+    {
+        return GMM_SUCCESS;
+    }
+
+    //Gpu-update only if client provided cmdQ and translation-table callbacks to program it
+    CpuUpdate = DoNotWait || !(UmdContext && UmdContext->pCommandQueueHandle) || !TTCb.pfWriteL2L3Entry;
+
+    if(!CpuUpdate)
+    {
+        TTCb.pfPrologTranslationTable(UmdContext->pCommandQueueHandle);
+        __CountCallback(GMM_PAGETABLE_CB_PROLOG);
+    }
+
+    Status = AuxTTObj->FlushInvalidations(UmdContext, CpuUpdate);
+
+    if(!CpuUpdate)
+    {
+        TTCb.pfEpilogTranslationTable(UmdContext->pCommandQueueHandle, 1); // ForceFlush
+        __CountCallback(GMM_PAGETABLE_CB_EPILOG);
+    }
+
+    return Status;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Returns number of merged Aux-Table VA ranges pending deferred invalidation
+///
+/// @return     number of pending ranges
+/////////////////////////////////////////////////////////////////////////////////////
+uint32_t GmmLib::GmmPageTableMgr::GetNumPendingAuxInvalidations()
+{
+    return AuxTTObj ? AuxTTObj->GetNumPendingInvalidations() : 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Frees retired page-table pools whose last Gpu use has completed, without waiting.
+/// Pools never referenced by a BB (Cpu-updated) are freed as well
+///
+/// @param[in]  BBQueueHandle: BB fence object (GMM_UMD_SYNCCONTEXT::BBFenceObj) CompletedFence belongs to
+/// @param[in]  CompletedFence: last fence value observed complete on BBQueueHandle
+/// @return     number of pools freed
+/////////////////////////////////////////////////////////////////////////////////////
+uint32_t GmmLib::GmmPageTableMgr::ReclaimPools(HANDLE BBQueueHandle, uint64_t CompletedFence)
+{
+    GMM_PAGETABLEPool **ppNext = &pRetiredPool;
+    GMM_PAGETABLEPool * Pool   = NULL;
+    uint32_t            NumFreed = 0;
+
+    ENTER_CRITICAL_SECTION
+    while((Pool = *ppNext))
+    {
+        if(!IsBBInfoComplete(Pool->GetPoolBBInfo(), BBQueueHandle, CompletedFence))
+        {
+            ppNext = &Pool->GetNextPool();
+            continue;
+        }
+
+        *ppNext = Pool->GetNextPool();
+        NumRetiredPools--;
+        __FreeRetiredPool(Pool, false);
+        NumFreed++;
+    }
     EXIT_CRITICAL_SECTION
+
+    return NumFreed;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Frees all retired page-table pools, waiting on Cpu for Gpu to be idle on each.
+/// Meant for client's idle/trim points, not for submission path
+///
+/// @return     number of pools freed
+/////////////////////////////////////////////////////////////////////////////////////
+uint32_t GmmLib::GmmPageTableMgr::ReclaimPools()
+{
+    GMM_PAGETABLEPool *Pool     = NULL;
+    uint32_t           NumFreed = 0;
+
+    ENTER_CRITICAL_SECTION
+    while((Pool = pRetiredPool))
+    {
+        pRetiredPool = Pool->GetNextPool();
+        NumRetiredPools--;
+        __FreeRetiredPool(Pool, true);
+        NumFreed++;
+    }
+    EXIT_CRITICAL_SECTION
+
+    return NumFreed;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Returns number of retired page-table pools pending reclamation
+///
+/// @return     number of retired pools
+/////////////////////////////////////////////////////////////////////////////////////
+uint32_t GmmLib::GmmPageTableMgr::GetNumRetiredPools()
+{
+    uint32_t NumPools;
+
+    ENTER_CRITICAL_SECTION
+    NumPools = NumRetiredPools;
+    EXIT_CRITICAL_SECTION
+
+    return NumPools;
+}
+
+//=============================================================================
+//
+// Function: __SelectEvacuatePools
+//
+// Desc: Marks sparse Aux L1/L2 pools (occupancy below PAGETABLE_POOL_SPARSE_PCT,
+//       last Gpu use complete) for evacuation, sparsest first, as long as their
+//       tables fit in unassigned nodes of remaining pools of same PoolType.
+//       Pools holding Null L1/L2 tables are never evacuated.
+//       Caller must hold PoolLock
+//
+// Parameters:
+//      BBQueueHandle: BB fence object CompletedFence belongs to
+//      CompletedFence: last fence observed complete on BBQueueHandle
+//
+// Returns:
+//      Number of pools marked
+//-----------------------------------------------------------------------------
+uint32_t GmmLib::GmmPageTableMgr::__SelectEvacuatePools(HANDLE BBQueueHandle, uint64_t CompletedFence)
+{
+    const POOL_TYPE Types[] = {POOL_TYPE_AUXTTL1, POOL_TYPE_AUXTTL2};
+    uint32_t        NumSelected = 0;
+
+    for(uint32_t t = 0; t < sizeof(Types) / sizeof(Types[0]); t++)
+    {
+        GMM_PAGETABLEPool *Pool      = NULL;
+        int                FreeNodes = 0; //unassigned nodes in pools not evacuated
+        int                LiveNodes = 0; //assigned nodes in evacuated pools
+
+        for(Pool = pPool; Pool; Pool = Pool->GetNextPool())
+        {
+            FreeNodes += (Pool->GetPoolType() == Types[t]) ? Pool->GetNumFreeNode() : 0;
+        }
+
+        for(;;)
+        {
+            GMM_PAGETABLEPool *Sparsest = NULL;
+
+            for(Pool = pPool; Pool; Pool = Pool->GetNextPool())
+            {
+                int UsedNodes = Pool->GetMaxNodes() - Pool->GetNumFreeNode();
+
+                if(Pool->GetPoolType() != Types[t] || Pool->IsEvacuating() || Pool->IsPoolUnused() ||
+                   UsedNodes * 100 >= Pool->GetMaxNodes() * PAGETABLE_POOL_SPARSE_PCT ||
+                   (AuxTTObj->NullL1Table && AuxTTObj->NullL1Table->GetPool() == Pool) ||
+                   (AuxTTObj->NullL2Table && AuxTTObj->NullL2Table->GetPool() == Pool) ||
+                   !IsBBInfoComplete(Pool->GetPoolBBInfo(), BBQueueHandle, CompletedFence))
+                {
+                    continue;
+                }
+
+                if(!Sparsest || UsedNodes < Sparsest->GetMaxNodes() - Sparsest->GetNumFreeNode())
+                {
+                    Sparsest = Pool;
+                }
+            }
+
+            if(!Sparsest ||
+               LiveNodes + (Sparsest->GetMaxNodes() - Sparsest->GetNumFreeNode()) > FreeNodes - Sparsest->GetNumFreeNode())
+            {
+                break;
+            }
+
+            LiveNodes += Sparsest->GetMaxNodes() - Sparsest->GetNumFreeNode();
+            FreeNodes -= Sparsest->GetNumFreeNode();
+            __RemoveFromFreePoolList(Sparsest);
+            Sparsest->IsEvacuating() = true;
+            NumSelected++;
+        }
+    }
+
+    return NumSelected;
+}
+
+//=============================================================================
+//
+// Function: __RetireEvacuatedPools
+//
+// Desc: Ends evacuation, retiring pools emptied by compaction. Pools still holding
+//       tables (with Gpu-updates pending) are listed for node assignment again.
+//       Caller must hold PoolLock
+//
+// Parameters:
+//      UmdContext: Caller-thread specific info, NULL if none. Hw walks old
+//                  tables until compaction BB (next BB, for CPU update) lands,
+//                  so retired pools get its fence
+//
+// Returns:
+//      Number of pools retired
+//-----------------------------------------------------------------------------
+uint32_t GmmLib::GmmPageTableMgr::__RetireEvacuatedPools(GMM_UMD_SYNCCONTEXT *UmdContext)
+{
+    GMM_PAGETABLEPool *Pool = pPool, *PrevPool = NULL, *NextPool = NULL;
+    uint32_t           NumRetired = 0;
+
+    for(; Pool; Pool = NextPool)
+    {
+        NextPool = Pool->GetNextPool();
+
+        if(!Pool->IsEvacuating())
+        {
+            PrevPool = Pool;
+            continue;
+        }
+
+        Pool->IsEvacuating() = false;
+        if(!Pool->IsPoolUnused())
+        {
+            __AddToFreePoolList(Pool);
+            PrevPool = Pool;
+            continue;
+        }
+
+        if(UmdContext)
+        {
+            Pool->GetPoolBBInfo() = SyncInfo(UmdContext->BBFenceObj, UmdContext->BBLastFence + 1);
+        }
+        __RetirePool(Pool, PrevPool);
+        NumRetired++;
+    }
+
+    return NumRetired;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Compacts Aux-Table page-table pools: L1/L2 tables in sparse pools are moved into
+/// unassigned nodes of other pools, re-pointing their L3e/L2e, and emptied pools
+/// are retired (freed by ReclaimPools). Opt-in, for client's idle/trim points.
+/// Only tables whose last Gpu-update has completed are moved.
+///
+/// @param[in]  UmdContext: Caller-thread specific info (regarding BB for Aux udpate, cmdQ to use etc)
+/// @param[in]  DoNotWait: 1 for CPU update, 0 for async(Gpu) update
+/// @param[in]  CompletedFence: last fence observed complete on UmdContext's BBFenceObj
+/// @param[out] pNumPoolsEmptied: optional, number of pools retired
+/// @return     GMM_STATUS
+/////////////////////////////////////////////////////////////////////////////////////
+GMM_STATUS GmmLib::GmmPageTableMgr::CompactPools(GMM_UMD_SYNCCONTEXT *UmdContext, uint8_t DoNotWait, uint64_t CompletedFence, uint32_t *pNumPoolsEmptied)
+{
+    HANDLE   BBQueueHandle = UmdContext ? UmdContext->BBFenceObj : NULL;
+    uint32_t NumSelected = 0, NumEmptied = 0;
+    uint8_t  CpuUpdate;
+
+    if(pNumPoolsEmptied)
+    {
+        *pNumPoolsEmptied = 0;
+    }
+
+    if(GetAuxL3TableAddr() == 0ULL)
+    {
+        GMM_ASSERTDPF(0, "Invalid pool compaction request, AuxTable is not initialized");
+        return GMM_INVALIDPARAM;
+    }
+
+    //Gpu-update only if client provided cmdQ and translation-table callbacks to program it
+    CpuUpdate = DoNotWait || !(UmdContext && UmdContext->pCommandQueueHandle) || !TTCb.pfWriteL2L3Entry;
+
+    ENTER_CRITICAL_SECTION
+    NumSelected = __SelectEvacuatePools(BBQueueHandle, CompletedFence);
+    EXIT_CRITICAL_SECTION
+
+    if(!NumSelected)
+    {
+        return GMM_SUCCESS;
+    }
+
+    if(!CpuUpdate)
+    {
+        TTCb.pfPrologTranslationTable(UmdContext->pCommandQueueHandle);
+        __CountCallback(GMM_PAGETABLE_CB_PROLOG);
+    }
+
+    AuxTTObj->RelocateTables(UmdContext, CpuUpdate, BBQueueHandle, CompletedFence);
+
+    ENTER_CRITICAL_SECTION
+    NumEmptied = __RetireEvacuatedPools(UmdContext);
+    EXIT_CRITICAL_SECTION
+
+    if(!CpuUpdate)
+    {
+        TTCb.pfEpilogTranslationTable(UmdContext->pCommandQueueHandle, 1); // ForceFlush
+        __CountCallback(GMM_PAGETABLE_CB_EPILOG);
+    }
+
+    if(pNumPoolsEmptied)
+    {
+        *pNumPoolsEmptied = NumEmptied;
+    }
+
     return GMM_SUCCESS;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+/// Reports page-table memory and activity: pools and their nodes by PoolType, pool
+/// usage and fragmentation, live L2/L1 tables, main-surface bytes mapped, map updates
+/// written/skipped and callbacks issued by type. Map counters are read lock-free and
+/// may lag concurrent maps
+///
+/// @param[out] pStats: page-table statistics
+/// @param[in]  BBQueueHandle: BB fence object CompletedFence belongs to
+/// @param[in]  CompletedFence: last fence observed complete on BBQueueHandle,
+///                             unassigned tables with later NodeBBInfo fence count as pending
+/////////////////////////////////////////////////////////////////////////////////////
+void GmmLib::GmmPageTableMgr::GetStats(GMM_PAGETABLE_MGR_STATS *pStats, HANDLE BBQueueHandle, uint64_t CompletedFence)
+{
+    __GMM_ASSERTPTR(pStats, VOIDRETURN);
+
+    memset(pStats, 0, sizeof(*pStats));
+
+    if(!AuxTTObj)
+    {
+        return;
+    }
+
+    //Takes L3e locks, must not nest in PoolLock
+    AuxTTObj->GetTableStats(&pStats->NumL2Tables, &pStats->NumL1Tables, &pStats->MappedSize);
+    AuxTTObj->GetMapStats(pStats);
+
+    if(AuxTTObj->GetL3Handle())
+    {
+        pStats->L3TableSize = GMM_AUX_L3_SIZE * GMM_AUX_L3e_SIZE;
+    }
+
+    ENTER_CRITICAL_SECTION
+    for(GMM_PAGETABLEPool *Pool = pPool; Pool; Pool = Pool->GetNextPool())
+    {
+        POOL_TYPE Type      = Pool->GetPoolType();
+        int       UsedNodes = Pool->GetMaxNodes() - Pool->GetNumFreeNode();
+
+        pStats->NumPools[Type]++;
+        pStats->NumUsedNodes[Type] += UsedNodes;
+        pStats->NumFreeNodes[Type] += Pool->GetNumFreeNode();
+        pStats->PoolSize += Pool->GetPoolSize();
+        pStats->UsedSize += (GMM_GFX_SIZE_T)UsedNodes * PAGE_SIZE;
+
+        if(Pool->IsPoolUnused())
+        {
+            pStats->NumUnusedPools++;
+            continue;
+        }
+
+        pStats->FragmentedSize += (GMM_GFX_SIZE_T)Pool->GetNumFreeNode() * PAGE_SIZE;
+        if(UsedNodes * 100 < Pool->GetMaxNodes() * PAGETABLE_POOL_SPARSE_PCT)
+        {
+            pStats->NumSparsePools++;
+        }
+    }
+
+    for(GMM_PAGETABLEPool *Pool = pRetiredPool; Pool; Pool = Pool->GetNextPool())
+    {
+        pStats->NumRetiredPools++;
+        pStats->RetiredSize += Pool->GetPoolSize();
+    }
+
+    //NodeBBInfo is kept per table, each table spans GetTableNodes() nodes
+    for(int List = 0; List < 2; List++)
+    {
+        for(GMM_PAGETABLEPool *Pool = List ? pRetiredPool : pPool; Pool; Pool = Pool->GetNextPool())
+        {
+            for(int i = 0; i < Pool->GetMaxNodes(); i += Pool->GetTableNodes())
+            {
+                if(!IsBBInfoComplete(Pool->GetNodeBBInfoAtIndex(i), BBQueueHandle, CompletedFence))
+                {
+                    pStats->NumPendingFences++;
+                }
+            }
+        }
+    }
+    EXIT_CRITICAL_SECTION
+
+    for(int i = 0; i < GMM_PAGETABLE_CB_MAX; i++)
+    {
+        pStats->NumCallbacks[i] = NumCallbacks[i];
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Dumps page-table pools (BO list and retired) and Aux Table tree as text, one line
+/// per pool/table. Output is truncated to BufferSize (null-terminated if non-zero);
+/// call with NULL buffer to query the size needed
+///
+/// @param[out] pBuffer: dump buffer, may be NULL
+/// @param[in]  BufferSize: size of pBuffer in bytes
+/// @return     dump length, excluding terminating null
+/////////////////////////////////////////////////////////////////////////////////////
+uint32_t GmmLib::GmmPageTableMgr::DumpPageTables(char *pBuffer, uint32_t BufferSize)
+{
+    static const char *PoolTypeName[POOL_TYPE_MAX] = {"TRTTL1", "TRTTL2", "AUXTTL1", "AUXTTL2"};
+    uint32_t           Len                         = 0;
+
+    if(pBuffer && BufferSize)
+    {
+        pBuffer[0] = '\0';
+    }
+
+    if(!AuxTTObj)
+    {
+        return 0;
+    }
+
+    ENTER_CRITICAL_SECTION
+    for(int List = 0; List < 2; List++)
+    {
+        for(GMM_PAGETABLEPool *Pool = List ? pRetiredPool : pPool; Pool; Pool = Pool->GetNextPool())
+        {
+            Len = __GmmTTDumpPrintf(pBuffer, BufferSize, Len, "Pool %s gfx=0x%llx nodes=%d/%d%s%s\n",
+                                    PoolTypeName[Pool->GetPoolType()], (unsigned long long)Pool->GetGfxAddress(),
+                                    Pool->GetMaxNodes() - Pool->GetNumFreeNode(), Pool->GetMaxNodes(),
+                                    Pool->IsEvacuating() ? " evacuating" : "", List ? " retired" : "");
+        }
+    }
+    EXIT_CRITICAL_SECTION
+
+    //Takes L3e locks, must not nest in PoolLock
+    Len = AuxTTObj->DumpTables(pBuffer, BufferSize, Len);
+
+    return Len;
+}
+
 #if defined(__linux__) && !_WIN32
 /////////////////////////////////////////////////////////////////////////////////////
 /// Gets size of PageTable buffer object (BOs) list
@@ -621,14 +1537,11 @@ int GmmLib::GmmPageTableMgr::GetNumOfPageTableBOs(uint8_t TTFlags)
 
     __GMM_ASSERTPTR(TTFlags & AUXTT, 0);
 
-    ENTER_CRITICAL_SECTION
-
+    //Lock-free, L3 table lives as long as AuxTTObj and pool count is published after pool list update
     if(AuxTTObj && AuxTTObj->GetL3Handle())
         NumBO++;
 
-    NumBO += NumNodePoolElements;
-
-    EXIT_CRITICAL_SECTION
+    NumBO += GMM_TT_LOAD_ACQUIRE(&NumNodePoolElements);
 
     return NumBO;
 }
@@ -657,7 +1570,8 @@ int GmmLib::GmmPageTableMgr::GetPageTableBOList(uint8_t TTFlags, void *BOList)
 
     Pool = pPool;
 
-    for(int i = 0; i < NumNodePoolElements; i++)
+    //Pools may have been added/released since NumBO was sampled, don't overrun client's list
+    for(int i = 0; i < NumBO - 1 && i < (int)NumNodePoolElements; i++)
     {
         if(Pool)
         {
@@ -670,6 +1584,73 @@ int GmmLib::GmmPageTableMgr::GetPageTableBOList(uint8_t TTFlags, void *BOList)
 
     return NumBO;
 }
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Gets generation of PageTable buffer object (BOs) list, bumped on every BO added
+/// to or removed from the list. Clients read it before GetPageTableBOList, and track
+/// later changes with GetPageTableBOChanges
+///
+/// @param[in]  TTFlags: Flags specifying PageTable-type for which BO list generation required
+/// @return     BO list generation
+/////////////////////////////////////////////////////////////////////////////////////
+uint32_t GmmLib::GmmPageTableMgr::GetPageTableBOGeneration(uint8_t TTFlags)
+{
+    __GMM_ASSERTPTR(TTFlags & AUXTT, 0);
+
+    return GMM_TT_LOAD_ACQUIRE(&BOListGen);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Gets PageTable buffer objects (BOs) added to/removed from BO list since given
+/// generation, in order. Check is lock-free when nothing changed. Changes made
+/// between reading generation and GetPageTableBOList may already be in the list,
+/// clients apply them idempotently.
+///
+/// @param[in]   TTFlags: Flags specifying PageTable-type for which BO changes required
+/// @param[in]   Generation: BO list generation client's list reflects
+/// @param[out]  Changes: client allocated array for BO changes
+/// @param[in]   MaxChanges: Changes array size
+/// @param[out]  pGeneration: current BO list generation, reflected once changes applied
+/// @return      number of changes, -1 if Generation is older than kept changes
+///              (GMM_PAGETABLE_BO_CHANGE_LOG_SIZE) or Changes is too small; client
+///              then rebuilds list with GetPageTableBOList
+/////////////////////////////////////////////////////////////////////////////////////
+int GmmLib::GmmPageTableMgr::GetPageTableBOChanges(uint8_t TTFlags, uint32_t Generation, GMM_PAGETABLE_BO_CHANGE *Changes, int MaxChanges, uint32_t *pGeneration)
+{
+    uint32_t NumChanges;
+
+    __GMM_ASSERTPTR(TTFlags & AUXTT, -1);
+    __GMM_ASSERTPTR(pGeneration, -1);
+
+    //BO list rarely changes, skip lock on per-submission check
+    if(GMM_TT_LOAD_ACQUIRE(&BOListGen) == Generation)
+    {
+        *pGeneration = Generation;
+        return 0;
+    }
+
+    __GMM_ASSERTPTR(Changes, -1);
+
+    ENTER_CRITICAL_SECTION
+
+    *pGeneration = BOListGen;
+    NumChanges   = BOListGen - Generation;
+
+    if(NumChanges > GMM_PAGETABLE_BO_CHANGE_LOG_SIZE || NumChanges > (uint32_t)MaxChanges)
+    {
+        EXIT_CRITICAL_SECTION
+        return -1;
+    }
+
+    for(uint32_t i = 0; i < NumChanges; i++)
+    {
+        Changes[i] = BOListLog[(Generation + i) % GMM_PAGETABLE_BO_CHANGE_LOG_SIZE];
+    }
+
+    EXIT_CRITICAL_SECTION
+
+    return (int)NumChanges;
+}
 #endif
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -688,6 +1669,17 @@ GmmLib::GmmPageTableMgr::~GmmPageTableMgr()
         ENTER_CRITICAL_SECTION
         pPool->__DestroyPageTablePool(&DeviceCbInt, hCsr);
         NumNodePoolElements = 0;
+        memset(pFreePool, 0, sizeof(pFreePool));
+        EXIT_CRITICAL_SECTION
+    }
+
+    //Retired pools outlived their BBs along with the device, free without waiting
+    if(pRetiredPool)
+    {
+        ENTER_CRITICAL_SECTION
+        pRetiredPool->__DestroyPageTablePool(&DeviceCbInt, hCsr);
+        pRetiredPool    = NULL;
+        NumRetiredPools = 0;
         EXIT_CRITICAL_SECTION
     }
 
@@ -727,6 +1719,15 @@ GmmLib::GmmPageTableMgr::GmmPageTableMgr()
 
     memset(&DeviceCb, 0, sizeof(GMM_DEVICE_CALLBACKS));
     memset(&DeviceCbInt, 0, sizeof(GMM_DEVICE_CALLBACKS_INT));
+    memset(&TTCb, 0, sizeof(GMM_TRANSLATIONTABLE_CALLBACKS));
+    memset(pFreePool, 0, sizeof(pFreePool));
+    this->pRetiredPool    = NULL;
+    this->NumRetiredPools = 0;
+    this->BOListGen       = 0;
+    memset(BOListLog, 0, sizeof(BOListLog));
+    memset(NumCallbacks, 0, sizeof(NumCallbacks));
+    this->AuxMapGpuUpdate = 0;
+    this->AtomicL1EntriesWrite = 0;
 }
 
 
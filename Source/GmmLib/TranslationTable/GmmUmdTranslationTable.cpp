@@ -28,6 +28,8 @@ Description: Contains functions of internal classes
 #include "Internal/Common/GmmLibInc.h"
 #include "../TranslationTable/GmmUmdTranslationTable.h"
 #include "Internal/Common/Texture/GmmTextureCalc.h"
+#include <stdarg.h>
+#include <stdio.h>
 
 #if !defined(__GMM_KMD)
 
@@ -66,6 +68,7 @@ GMM_STATUS GmmLib::PageTable::AllocateL3Table(uint32_t L3TableSize, uint32_t L3A
     Alloc.hCsr      = PageTableMgr->hCsr;
 
     Status = __GmmDeviceAlloc(pClientContext, &PageTableMgr->DeviceCbInt, &Alloc);
+    PageTableMgr->__CountCallback(GMM_PAGETABLE_CB_ALLOCATE);
     if(Status != GMM_SUCCESS)
     {
         LeaveCriticalSection(&TTLock);
@@ -113,9 +116,9 @@ bool GmmLib::GmmPageTablePool::__IsUnusedTRTTPoolOverLimit(GMM_GFX_SIZE_T *OverL
 
     while(Pool)
     {
-        if(Pool->NumFreeNodes == PAGETABLE_POOL_MAX_NODES)
+        if(Pool->NumFreeNodes == Pool->MaxNodes)
         {
-            UnusedTrTTPoolSize += PAGETABLE_POOL_SIZE;
+            UnusedTrTTPoolSize += Pool->GetPoolSize();
         }
         Pool = Pool->NextPool;
     }
@@ -170,12 +173,12 @@ void GmmLib::PageTable::AllocateL1L2Table(GMM_GFX_ADDRESS TileAddr, GMM_GFX_ADDR
         uint32_t                   PoolNodeIdx = PAGETABLE_POOL_MAX_NODES;
         GmmLib::GMM_PAGETABLEPool *PoolElem    = NULL;
         POOL_TYPE                  PoolType    = POOL_TYPE_AUXTTL2;
-        PoolElem                               = PageTableMgr->__GetFreePoolNode(&PoolNodeIdx, PoolType);
+        SyncInfo                   NodeBBInfo;
+        PoolElem                               = PageTableMgr->__AssignFreePoolNode(&PoolNodeIdx, PoolType, &NodeBBInfo);
         if(PoolElem)
         {
-            pTTL2[L3eIdx] = MidLevelTable(PoolElem, PoolNodeIdx, PoolElem->GetNodeBBInfoAtIndex(PoolNodeIdx));
+            pTTL2[L3eIdx].Init(PoolElem, PoolNodeIdx, NodeBBInfo);
             *L2TableAdr   = PoolElem->GetGfxAddress() + PAGE_SIZE * PoolNodeIdx; //PoolNodeIdx must be multiple of 8 (Aux L2) and multiple of 2 (Aux L1)
-            ASSIGN_POOLNODE(PoolElem, PoolNodeIdx, NodesPerTable)
         }
     }
 
@@ -192,26 +195,99 @@ void GmmLib::PageTable::AllocateL1L2Table(GMM_GFX_ADDRESS TileAddr, GMM_GFX_ADDR
         uint32_t                   PoolNodeIdx = PAGETABLE_POOL_MAX_NODES;
         GmmLib::GMM_PAGETABLEPool *PoolElem    = NULL;
         POOL_TYPE                  PoolType    = POOL_TYPE_AUXTTL1;
+        SyncInfo                   NodeBBInfo;
 
-        PoolElem = PageTableMgr->__GetFreePoolNode(&PoolNodeIdx, PoolType); //Recognize if Aux-L1 being allocated
+        PoolElem = PageTableMgr->__AssignFreePoolNode(&PoolNodeIdx, PoolType, &NodeBBInfo); //Recognize if Aux-L1 being allocated
         if(PoolElem)
         {
-            pL1Tbl = new GmmLib::LastLevelTable(PoolElem, PoolNodeIdx, GMM_L1_SIZE_DWORD(TTType, GetGmmLibContext()), L2eIdx); // use TR vs Aux L1_Size_DWORD
+            pL1Tbl = GetL1TableObj(PoolElem, PoolNodeIdx, L2eIdx);
 
-            if(pL1Tbl)
+            if(pL1Tbl && pTTL2[L3eIdx].InsertL1Table(pL1Tbl))
             {
                 *L1TableAdr = PoolElem->GetGfxAddress() + PAGE_SIZE * PoolNodeIdx; //PoolNodeIdx should reflect 1 node per Tr-table and 2 nodes per AUX L1 TABLE
-                if(PoolNodeIdx != PAGETABLE_POOL_MAX_NODES)
+                pL1Tbl->GetBBInfo() = NodeBBInfo;
+            }
+            else
+            {
+                uint32_t PerTableNodes = (TTType == AUXTT) ? AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetGmmLibContext()) : 1;
+
+                DEASSIGN_POOLNODE(PageTableMgr, NULL, PoolElem, PoolNodeIdx, PerTableNodes)
+                if(pL1Tbl)
                 {
-                    uint32_t PerTableNodes = (TTType == AUXTT) ? AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetGmmLibContext()) : 1;
-		    ASSIGN_POOLNODE(PoolElem, PoolNodeIdx, PerTableNodes)
+                    EnterCriticalSection(&TTLock);
+                    pL1Tbl->Next() = pFreeL1Tables;
+                    pFreeL1Tables  = pL1Tbl;
+                    LeaveCriticalSection(&TTLock);
                 }
-                pTTL2[L3eIdx].InsertInList(pL1Tbl);
             }
         }
     }
 }
 
+//=============================================================================
+//
+// Function: GetL1TableObj
+//
+// Desc: Returns L1 table object for given pool node, reusing one released
+//       earlier by ReleaseL1Table before allocating new. Recycled objects are
+//       shared by all L3e, so the list is accessed under TTLock
+//
+// Parameters:
+//      PoolElem: Pool containing L1 table's node
+//      NodeIdx: Pool node idx assigned to L1 table
+//      L2eIdx: L2 entry idx pointing to L1 table
+//
+// Returns:
+//     LastLevelTable*, NULL if allocation failed
+//-----------------------------------------------------------------------------
+GmmLib::LastLevelTable *GmmLib::PageTable::GetL1TableObj(GMM_PAGETABLEPool *PoolElem, int NodeIdx, int L2eIdx)
+{
+    GmmLib::LastLevelTable *pL1Tbl = NULL;
+
+    EnterCriticalSection(&TTLock);
+    pL1Tbl = pFreeL1Tables;
+    if(pL1Tbl)
+    {
+        pFreeL1Tables = pL1Tbl->Next();
+    }
+    LeaveCriticalSection(&TTLock);
+
+    if(pL1Tbl)
+    {
+        pL1Tbl->Init(PoolElem, NodeIdx, GMM_L1_SIZE_DWORD(TTType, GetGmmLibContext()), L2eIdx); // use TR vs Aux L1_Size_DWORD
+    }
+    else
+    {
+        pL1Tbl = new(pClientContext->GetAllocatorCb(), GMM_HEAP_PAGETABLE) GmmLib::LastLevelTable(PoolElem, NodeIdx, GMM_L1_SIZE_DWORD(TTType, GetGmmLibContext()), L2eIdx); // use TR vs Aux L1_Size_DWORD
+    }
+
+    return pL1Tbl;
+}
+
+//=============================================================================
+//
+// Function: ReleaseL1Table
+//
+// Desc: Detaches L1 table from its L2 table and keeps the object for reuse by
+//       GetL1TableObj. Caller must have released its pool node.
+//
+// Parameters:
+//      L3eIdx: L3 entry idx of L2 table
+//      L2eIdx: L2 entry idx of L1 table
+//-----------------------------------------------------------------------------
+void GmmLib::PageTable::ReleaseL1Table(GMM_GFX_SIZE_T L3eIdx, GMM_GFX_SIZE_T L2eIdx)
+{
+    GmmLib::LastLevelTable *pL1Tbl = pTTL2[L3eIdx].RemoveL1Table(L2eIdx);
+
+    if(pL1Tbl)
+    {
+        EnterCriticalSection(&TTLock);
+        pL1Tbl->Next() = pFreeL1Tables;
+        pFreeL1Tables  = pL1Tbl;
+        LeaveCriticalSection(&TTLock);
+    }
+}
+
 //=============================================================================
 //
 // Function: AllocateDummyTables
@@ -247,11 +323,11 @@ void GmmLib::PageTable::AllocateDummyTables(GmmLib::Table **L2Table, GmmLib::Tab
         uint32_t                   PoolNodeIdx = PAGETABLE_POOL_MAX_NODES;
         GmmLib::GMM_PAGETABLEPool *PoolElem    = NULL;
         POOL_TYPE                  PoolType    = POOL_TYPE_AUXTTL2;
-        PoolElem                               = PageTableMgr->__GetFreePoolNode(&PoolNodeIdx, PoolType);
+        SyncInfo                   NodeBBInfo;
+        PoolElem                               = PageTableMgr->__AssignFreePoolNode(&PoolNodeIdx, PoolType, &NodeBBInfo);
         if(PoolElem)
         {
-            *L2Table = new GmmLib::MidLevelTable(PoolElem, PoolNodeIdx, PoolElem->GetNodeBBInfoAtIndex(PoolNodeIdx));
-            ASSIGN_POOLNODE(PoolElem, PoolNodeIdx, NodesPerTable)
+            *L2Table = new(pClientContext->GetAllocatorCb(), GMM_HEAP_PAGETABLE) GmmLib::MidLevelTable(PoolElem, PoolNodeIdx, NodeBBInfo);
         }
     }
 
@@ -260,19 +336,21 @@ void GmmLib::PageTable::AllocateDummyTables(GmmLib::Table **L2Table, GmmLib::Tab
         uint32_t                   PoolNodeIdx = PAGETABLE_POOL_MAX_NODES;
         GmmLib::GMM_PAGETABLEPool *PoolElem    = NULL;
         POOL_TYPE                  PoolType    = POOL_TYPE_AUXTTL1;
+        SyncInfo                   NodeBBInfo;
 
-        PoolElem = PageTableMgr->__GetFreePoolNode(&PoolNodeIdx, PoolType); //Recognize if Aux-L1 being allocated
+        PoolElem = PageTableMgr->__AssignFreePoolNode(&PoolNodeIdx, PoolType, &NodeBBInfo); //Recognize if Aux-L1 being allocated
         if(PoolElem)
         {
-            *L1Table = new GmmLib::LastLevelTable(PoolElem, PoolNodeIdx, GMM_L1_SIZE_DWORD(TTType, GetGmmLibContext()), 0); // use TR vs Aux L1_Size_DWORD
+            *L1Table = new(pClientContext->GetAllocatorCb(), GMM_HEAP_PAGETABLE) GmmLib::LastLevelTable(PoolElem, PoolNodeIdx, GMM_L1_SIZE_DWORD(TTType, GetGmmLibContext()), 0); // use TR vs Aux L1_Size_DWORD
 
             if(*L1Table)
             {
-                if(PoolNodeIdx != PAGETABLE_POOL_MAX_NODES)
-                {
-                    uint32_t PerTableNodes = (TTType == AUXTT) ? AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetGmmLibContext()) : 1;
-                    ASSIGN_POOLNODE(PoolElem, PoolNodeIdx, PerTableNodes)
-                }
+                (*L1Table)->GetBBInfo() = NodeBBInfo;
+            }
+            else
+            {
+                uint32_t PerTableNodes = (TTType == AUXTT) ? AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetGmmLibContext()) : 1;
+                DEASSIGN_POOLNODE(PageTableMgr, NULL, PoolElem, PoolNodeIdx, PerTableNodes)
             }
         }
     }
@@ -314,8 +392,8 @@ void GmmLib::PageTable::GetL1L2TableAddr(GMM_GFX_ADDRESS TileAddr, GMM_GFX_ADDRE
 
         if(Pool)
         {
-            __GMM_ASSERT(Pool->GetNumFreeNode() != PAGETABLE_POOL_MAX_NODES);
-            __GMM_ASSERT(pTTL2[L3eIdx].GetNodeIdx() < PAGETABLE_POOL_MAX_NODES);
+            __GMM_ASSERT(!Pool->IsPoolUnused());
+            __GMM_ASSERT(pTTL2[L3eIdx].GetNodeIdx() < Pool->GetMaxNodes());
             __GMM_ASSERT(Pool->GetNodeUsageAtIndex(pTTL2[L3eIdx].GetNodeIdx() / (32 * NodesPerTable)) != 0);
 
             *L2TableAdr = Pool->GetGfxAddress() + PAGE_SIZE * (pTTL2[L3eIdx].GetNodeIdx());
@@ -329,8 +407,8 @@ void GmmLib::PageTable::GetL1L2TableAddr(GMM_GFX_ADDRESS TileAddr, GMM_GFX_ADDRE
             if(Pool)
             {
                 uint32_t PerTableNodes = (TTType == AUXTT) ? AUX_L1TABLE_SIZE_IN_POOLNODES_2(GetGmmLibContext()) : 1;
-                __GMM_ASSERT(Pool->GetNumFreeNode() != PAGETABLE_POOL_MAX_NODES);
-                __GMM_ASSERT(pL1Tbl->GetNodeIdx() < PAGETABLE_POOL_MAX_NODES);
+                __GMM_ASSERT(!Pool->IsPoolUnused());
+                __GMM_ASSERT(pL1Tbl->GetNodeIdx() < Pool->GetMaxNodes());
                 __GMM_ASSERT(Pool->GetNodeUsageAtIndex(pL1Tbl->GetNodeIdx() / (32 * PerTableNodes)) != 0);
 
                 *L1TableAdr = Pool->GetGfxAddress() + PAGE_SIZE * (pL1Tbl->GetNodeIdx());
@@ -365,7 +443,6 @@ uint8_t GmmLib::PageTable::GetMappingType(GMM_GFX_ADDRESS GfxVA, GMM_GFX_SIZE_T
     L1eIdx      = GMM_L1_ENTRY_IDX(TTType, GfxVA, GetGmmLibContext());
     L1EntrySize = WA16K(GetGmmLibContext()) ? GMM_KBYTE(16) : WA64K(GetGmmLibContext()) ? GMM_KBYTE(64) : GMM_MBYTE(1);
 
-    EnterCriticalSection(&TTLock);
     __GMM_ASSERT(TTL3.L3Handle);
 
 #define GET_NEXT_L1TABLE(L1eIdx, L2eIdx, L3eIdx) \
@@ -395,6 +472,11 @@ uint8_t GmmLib::PageTable::GetMappingType(GMM_GFX_ADDRESS GfxVA, GMM_GFX_SIZE_T
 
     while(!(bFoundLastVA || bTerminate) && (TileAddr < GfxVA + Size))
     {
+        GMM_GFX_SIZE_T LockedL3eIdx = L3eIdx;
+
+        //L2/L1 tables at L3eIdx can't change while scanning them
+        EnterL3eLock(LockedL3eIdx);
+
         if(pTTL2[L3eIdx].GetPool())
         {
             GmmLib::LastLevelTable *pL1Tbl = NULL;
@@ -484,6 +566,8 @@ uint8_t GmmLib::PageTable::GetMappingType(GMM_GFX_ADDRESS GfxVA, GMM_GFX_SIZE_T
                 GET_NEXT_L2TABLE(L1eIdx, L2eIdx, L3eIdx)
             }
         }
+
+        LeaveL3eLock(LockedL3eIdx);
     }
 
     if(!bFoundLastVA)
@@ -491,7 +575,6 @@ uint8_t GmmLib::PageTable::GetMappingType(GMM_GFX_ADDRESS GfxVA, GMM_GFX_SIZE_T
         LastAddr = TileAddr;
     }
 
-    LeaveCriticalSection(&TTLock);
     return MapType;
 }
 
@@ -533,6 +616,11 @@ bool GmmLib::Table::TrackTableUsage(TT_TYPE Type, bool IsL1, GMM_GFX_ADDRESS Til
 
     if(NullMapped)
     {
+        if(UsedEntries[ElemNum]) //Entries in same DWORD still in use, skip scan
+        {
+            return false;
+        }
+
         int TableDWSize = IsL1 ? static_cast<int>(GMM_L1_SIZE_DWORD(Type,  pGmmLibContext)) : static_cast<int>(GMM_L2_SIZE_DWORD(Type));
         for(int i = 0; i < TableDWSize; i++)
         {
@@ -545,6 +633,85 @@ bool GmmLib::Table::TrackTableUsage(TT_TYPE Type, bool IsL1, GMM_GFX_ADDRESS Til
     return NullMapped ? true : false;
 }
 
+//=============================================================================
+//
+// Function: SetTableUsage
+//
+// Desc: Marks run of consecutive entries as used (non-null mapped), a DWORD of
+//       UsedEntries at a time
+//
+// Parameters:
+//      EntryIdx: Index of first entry in table
+//      NumEntries: Number of entries in run, must not cross end of table
+//-----------------------------------------------------------------------------
+void GmmLib::Table::SetTableUsage(uint32_t EntryIdx, uint32_t NumEntries)
+{
+    while(NumEntries)
+    {
+        uint32_t ElemNum = EntryIdx / (sizeof(UsedEntries[0]) * 8);
+        uint32_t BitNum  = EntryIdx % (sizeof(UsedEntries[0]) * 8);
+        uint32_t NumBits = GFX_MIN(NumEntries, (uint32_t)(sizeof(UsedEntries[0]) * 8) - BitNum);
+
+        UsedEntries[ElemNum] |= ((NumBits == 32) ? 0xffffffff : ((1u << NumBits) - 1)) << BitNum;
+
+        EntryIdx += NumBits;
+        NumEntries -= NumBits;
+    }
+}
+
+//=============================================================================
+//
+// Function: GetNumUsedEntries
+//
+// Parameters:
+//      TableDWSize: UsedEntries size in DWORDs
+//
+// Returns:
+//      Number of used (non-null mapped) entries in table
+//-----------------------------------------------------------------------------
+uint32_t GmmLib::Table::GetNumUsedEntries(int TableDWSize)
+{
+    uint32_t NumUsed = 0;
+
+    for(int i = 0; i < TableDWSize; i++)
+    {
+        for(uint32_t Bits = UsedEntries[i]; Bits; Bits &= Bits - 1)
+        {
+            NumUsed++;
+        }
+    }
+    return NumUsed;
+}
+
+//=============================================================================
+//
+// Function: __GmmTTDumpPrintf
+//
+// Desc: Appends formatted text at Len in dump buffer. Output past BufferSize is
+//       dropped but counted, so caller can size buffer from returned length
+//
+// Parameters:
+//      pBuffer: dump buffer (may be NULL to query size)
+//      BufferSize: buffer size in bytes
+//      Len: current dump length
+//      Format: printf format
+//
+// Returns:
+//      New dump length, excluding terminating null
+//-----------------------------------------------------------------------------
+uint32_t GmmLib::__GmmTTDumpPrintf(char *pBuffer, uint32_t BufferSize, uint32_t Len, const char *Format, ...)
+{
+    va_list Args;
+    int     Num;
+    bool    Fits = pBuffer && Len < BufferSize;
+
+    va_start(Args, Format);
+    Num = vsnprintf(Fits ? pBuffer + Len : NULL, Fits ? BufferSize - Len : 0, Format, Args);
+    va_end(Args);
+
+    return Len + ((Num > 0) ? Num : 0);
+}
+
 //=============================================================================
 //
 // Function: __IsTableNullMapped
@@ -668,6 +835,7 @@ GMM_STATUS GmmLib::PageTable::DestroyL3Table()
         Dealloc.hCsr   = PageTableMgr->hCsr;
 
         Status = __GmmDeviceDealloc(ClientType, &PageTableMgr->DeviceCbInt, &Dealloc, pClientContext);
+        PageTableMgr->__CountCallback(GMM_PAGETABLE_CB_DEALLOCATE);
 
         TTL3.L3Handle   = NULL;
         TTL3.GfxAddress = 0;
@@ -79,6 +79,7 @@ static inline int _BitScanForward(uint32_t *index, uint32_t mask)
 #define GMM_L1_USABLESIZE(TTType, pGmmLibContext)  (GMM_AUX_L1_USABLESIZE(pGmmLibContext))
 #define GMM_L1_SIZE(TTType, pGmmLibContext) (GMM_AUX_L1_SIZE(pGmmLibContext))
 #define GMM_L1_SIZE_DWORD(TTType, pGmmLibContext) (GMM_AUX_L1_SIZE_DWORD(pGmmLibContext))
+#define GMM_L1_SIZE_DWORD_MAX        (GFX_CEIL_DIV((1 << (GMM_AUX_L1_HIGH_BIT - GMM_AUX_L1_LOW_BIT + 1)), 32)) // Largest L1 usage bitmap, across WA16K/WA64K
 #define GMM_L2_SIZE(TTType)          (GMM_AUX_L2_SIZE)
 #define GMM_L2_SIZE_DWORD(TTType)    (GMM_AUX_L2_SIZE_DWORD)
 #define GMM_L3_SIZE(TTType)          (GMM_AUX_L3_SIZE)
@@ -94,35 +95,51 @@ static inline int _BitScanForward(uint32_t *index, uint32_t mask)
 #ifdef __cplusplus
 #include "External/Common/GmmMemAllocator.hpp"
 
+//Counters read lock-free by PageTableMgr queries, written under PoolLock
+#if _WIN32
+#define GMM_TT_LOAD_ACQUIRE(p)         (*(volatile uint32_t *)(p)) // volatile read has acquire semantics
+#define GMM_TT_STORE_RELEASE(p, Value) InterlockedExchange((LONG *)(p), (LONG)(Value))
+#define GMM_TT_ATOMIC_ADD64(p, Value)  InterlockedExchangeAdd64((LONG64 *)(p), (LONG64)(Value))
+#else
+#define GMM_TT_LOAD_ACQUIRE(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define GMM_TT_STORE_RELEASE(p, Value) __atomic_store_n((p), (Value), __ATOMIC_RELEASE)
+#define GMM_TT_ATOMIC_ADD64(p, Value)  __sync_fetch_and_add((p), (Value))
+#endif
+
 //HW provides single-set of TR/Aux-TT registers for non-privileged programming
 //Engine-specific offsets are HW-updated with programmed values.
 #define GET_L3ADROFFSET(TRTT, L3AdrOffset, pGmmLibContext) \
            L3AdrOffset = 0x4200;            
 
 
-#define ASSIGN_POOLNODE(Pool, NodeIdx, PerTableNodes)    {       \
-    (Pool)->GetNodeUsageAtIndex((NodeIdx) / (32 *(PerTableNodes))) |= __BIT(((NodeIdx) / (PerTableNodes)) % 32);  \
-    (Pool)->GetNodeBBInfoAtIndex(NodeIdx) = SyncInfo();                              \
-    (Pool)->GetNumFreeNode() -= (PerTableNodes);                      \
-                                          }
-
 #define DEASSIGN_POOLNODE(PageTableMgr, UmdContext, Pool, NodeIdx, PerTableNodes)  {            \
-    (Pool)->GetNodeUsageAtIndex((NodeIdx) / (32 * (PerTableNodes))) &= ~__BIT(((NodeIdx) / (PerTableNodes)) % 32 );  \
-    (Pool)->GetNumFreeNode() += (PerTableNodes);                      \
-    if((Pool)->GetNumFreeNode() == PAGETABLE_POOL_MAX_NODES) {        \
-    PageTableMgr->__ReleaseUnusedPool((UmdContext));              \
-                                                    }             \
+    PageTableMgr->__ReleasePoolNode((UmdContext), (Pool), (NodeIdx), (PerTableNodes));       \
                                           }
 
 namespace GmmLib
 {
 #define PAGETABLE_POOL_MAX_NODES         512                               //Max. number of L2/L1 tables pool contains
+#define PAGETABLE_POOL_MIN_NODES         64                                //Size of first pool of each PoolType, later ones double up to max.
+#define PAGETABLE_POOL_SPARSE_PCT        25                                //Pools with fewer assigned nodes (in %) get evacuated by compaction
 #define PAGETABLE_POOL_SIZE_IN_DWORD     PAGETABLE_POOL_MAX_NODES / 32
 #define PAGETABLE_POOL_SIZE              PAGETABLE_POOL_MAX_NODES * PAGE_SIZE   //Pool for L2/L1 table allocation
 #define AUX_L2TABLE_SIZE_IN_POOLNODES    8                                 //Aux L2 is 32KB
 #define AUX_L1TABLE_SIZE_IN_POOLNODES 2 //Aux L1 is 8KB
 #define AUX_L1TABLE_SIZE_IN_POOLNODES_2(pGmmLibContext) (pGmmLibContext ? ((WA64K(pGmmLibContext) || WA16K(pGmmLibContext)) ? 2 : 1) : 2) //Aux L1 is 8KB / 4K (MTL)
 #define PAGETABLE_POOL_MAX_UNUSED_SIZE   GMM_MBYTE(16)                     //Max. size of unused pool, driver keeps resident
+#define AUX_L1_WRITE_BATCH_MAX_ENTRIES   256                               //Max. contiguous L1e coalesced into one pfWriteL1Entries call
+#define PAGETABLE_L3e_LOCK_COUNT         64                                //L3e (L2 table and its L1 tables) locks, striped by L3eIdx
+#define AUX_INVALIDATE_RANGE_MIN_COUNT   64                                //Initial capacity of deferred-invalidation range list
+#define AUX_RELOCATE_MAX_HELD_NODES      64                                //Max. busy pool nodes skipped by one CPU-update compaction
+
+    //True if last Gpu use recorded in BBInfo completed (CompletedFence on BBQueueHandle), or there's none
+    inline bool IsBBInfoComplete(const SyncInfo &BBInfo, HANDLE BBQueueHandle, uint64_t CompletedFence)
+    {
+        return !BBInfo.BBQueueHandle || (BBInfo.BBQueueHandle == BBQueueHandle && BBInfo.BBFence <= CompletedFence);
+    }
+
+    //Appends formatted text to page-table dump, returns new length (counted past BufferSize, like snprintf)
+    uint32_t __GmmTTDumpPrintf(char *pBuffer, uint32_t BufferSize, uint32_t Len, const char *Format, ...);
 
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -131,7 +148,8 @@ namespace GmmLib
     /// Separate NodePool (linked-list element) kept for each PoolType, for cleaner management in 
     /// per-table size
     /////////////////////////////////////////////////////////////////////////////////////////////
-    class GmmPageTablePool
+    class GmmPageTablePool :
+        public GmmMemAllocator
     {
     private:
                                        //PageTablePool allocation descriptor
@@ -143,7 +161,8 @@ namespace GmmLib
         POOL_TYPE         PoolType;       //Separate Node-pools for TR-L2, TR-L1, Aux-L2, Aux-L1 usages-  
 
                                       //PageTablePool usage descriptors
-        int              NumFreeNodes;    //has value {0 to Pool_Max_nodes}
+        int              NumFreeNodes;    //has value {0 to MaxNodes}
+        int              MaxNodes;        //pool size in nodes {PAGETABLE_POOL_MIN_NODES to PAGETABLE_POOL_MAX_NODES}
         uint32_t*           NodeUsage;       //destined node state (updated during node assignment and removed based on destined state of L1/L2 Table 
                                           //that used the pool node) 
                                           //Aux-Pool node-usage tracked at every eighth/second node(for L2 vs L1) 
@@ -155,7 +174,13 @@ namespace GmmLib
 
         SyncInfo         PoolBBInfo;      //BB info for Gpu usage of the Pool (most recent of pool node BB info)
 
+        uint32_t         NodeUsageFree;   //bit j set if NodeUsage[j] has unassigned table, for O(1) free node lookup
+        int              TableNodes;      //pool nodes per table (1b in NodeUsage)
+
         GmmPageTablePool* NextPool;       //Next node-Pool in the LinkedList
+        GmmPageTablePool* NextFreePool;   //Next node-Pool of same PoolType in PageTableMgr's free-pool list
+        bool             InFreePoolList;
+        bool             Evacuating;      //being emptied by compaction, not used for new node assignment
         GmmClientContext    *pClientContext;    ///< ClientContext of the client creating this Object
     public:
         GmmPageTablePool() :
@@ -165,44 +190,58 @@ namespace GmmLib
             CPUAddress(0x0),
             PoolType(POOL_TYPE_TRTTL1),
             NumFreeNodes(PAGETABLE_POOL_MAX_NODES),
+            MaxNodes(PAGETABLE_POOL_MAX_NODES),
             NodeUsage(NULL),
             NodeBBInfo(NULL),
             PoolBBInfo(),
+            NodeUsageFree(0),
+            TableNodes(1),
             NextPool(NULL),
+            NextFreePool(NULL),
+            InFreePoolList(false),
+            Evacuating(false),
             pClientContext(NULL)
         {
 
         }
-        GmmPageTablePool(HANDLE hAlloc, GMM_RESOURCE_INFO* pGmmRes, GMM_GFX_ADDRESS SysMem, POOL_TYPE Type) :
+        GmmPageTablePool(HANDLE hAlloc, GMM_RESOURCE_INFO* pGmmRes, GMM_GFX_ADDRESS SysMem, POOL_TYPE Type, int NumNodes = PAGETABLE_POOL_MAX_NODES) :
             GmmPageTablePool()
         {
-            int              DwordPoolSize;
+            int              DwordPoolSize, NumTables;
             GMM_LIB_CONTEXT *pGmmLibContext;
             PoolHandle     = hAlloc;
             pGmmResInfo    = pGmmRes;
             PoolGfxAddress = SysMem;
             CPUAddress     = PoolGfxAddress;
             NextPool       = NULL;
-            NumFreeNodes   = PAGETABLE_POOL_MAX_NODES;
+            MaxNodes       = NumNodes;
+            NumFreeNodes   = MaxNodes;
             PoolType       = Type;
             if(pGmmResInfo)
             {
                 pClientContext = pGmmResInfo->GetGmmClientContext();
             }
             pGmmLibContext = pClientContext ? pClientContext->GetLibContext() : NULL;
-            DwordPoolSize  = (Type == POOL_TYPE_AUXTTL1) ? PAGETABLE_POOL_SIZE_IN_DWORD / AUX_L1TABLE_SIZE_IN_POOLNODES_2(pGmmLibContext) : (Type == POOL_TYPE_AUXTTL2) ? PAGETABLE_POOL_SIZE_IN_DWORD / AUX_L2TABLE_SIZE_IN_POOLNODES : PAGETABLE_POOL_SIZE_IN_DWORD;
-            NodeUsage      = new uint32_t[DwordPoolSize]();
-            NodeBBInfo     = new SyncInfo[DwordPoolSize * 32]();
+            TableNodes     = (Type == POOL_TYPE_AUXTTL1) ? AUX_L1TABLE_SIZE_IN_POOLNODES_2(pGmmLibContext) : (Type == POOL_TYPE_AUXTTL2) ? AUX_L2TABLE_SIZE_IN_POOLNODES : 1;
+            NumTables      = MaxNodes / TableNodes;
+            DwordPoolSize  = GFX_CEIL_DIV(NumTables, 32);
+            NodeUsage      = NewArray<uint32_t>(GetAllocatorCb(), DwordPoolSize, GMM_HEAP_PAGETABLE);
+            NodeBBInfo     = NewArray<SyncInfo>(GetAllocatorCb(), DwordPoolSize * 32, GMM_HEAP_PAGETABLE);
+            NodeUsageFree  = (uint32_t)(__BIT64(DwordPoolSize) - 1);
+            if(NumTables % 32)
+            {
+                NodeUsage[DwordPoolSize - 1] = ~(__BIT(NumTables % 32) - 1); //tables past pool end never free
+            }
 	}
-        GmmPageTablePool(HANDLE hAlloc, GMM_RESOURCE_INFO* pGmmRes, GMM_GFX_ADDRESS GfxAdr, GMM_GFX_ADDRESS CPUAdr, POOL_TYPE Type) :
-            GmmPageTablePool(hAlloc, pGmmRes, GfxAdr, Type)
+        GmmPageTablePool(HANDLE hAlloc, GMM_RESOURCE_INFO* pGmmRes, GMM_GFX_ADDRESS GfxAdr, GMM_GFX_ADDRESS CPUAdr, POOL_TYPE Type, int NumNodes = PAGETABLE_POOL_MAX_NODES) :
+            GmmPageTablePool(hAlloc, pGmmRes, GfxAdr, Type, NumNodes)
         {
             CPUAddress = (CPUAdr != GfxAdr) ? CPUAdr : GfxAdr;
         }
         ~GmmPageTablePool()
         {
-            delete[] NodeUsage;
-            delete[] NodeBBInfo;
+            DeleteArray(NodeUsage);
+            DeleteArray(NodeBBInfo);
         }
 
         GmmPageTablePool* InsertInList(GmmPageTablePool* NewNode)
@@ -224,9 +263,58 @@ namespace GmmLib
         }
 
         GmmPageTablePool* &GetNextPool() { return NextPool; }
+        GmmPageTablePool* &GetNextFreePool() { return NextFreePool; }
+        bool& IsInFreePoolList() { return InFreePoolList; }
+        bool& IsEvacuating() { return Evacuating; }
+
+        void AssignNode(int NodeIdx, int PerTableNodes)
+        {
+            int j = NodeIdx / (32 * PerTableNodes);
+
+            NodeUsage[j] |= __BIT((NodeIdx / PerTableNodes) % 32);
+            if(NodeUsage[j] == 0xFFFFFFFF)
+            {
+                NodeUsageFree &= ~__BIT(j);
+            }
+            GetNodeBBInfoAtIndex(NodeIdx) = SyncInfo();
+            NumFreeNodes -= PerTableNodes;
+        }
+
+        void DeassignNode(int NodeIdx, int PerTableNodes)
+        {
+            int j = NodeIdx / (32 * PerTableNodes);
+
+            NodeUsage[j] &= ~__BIT((NodeIdx / PerTableNodes) % 32);
+            NodeUsageFree |= __BIT(j);
+            NumFreeNodes += PerTableNodes;
+        }
+
+        /////////////////////////////////////////////////////////////////////////
+        /// Finds unassigned pool node, using NodeUsageFree to pick NodeUsage DWORD
+        /// @param[out] NodeIdx: first pool node of unassigned table
+        /// @return     true if pool has unassigned table
+        /////////////////////////////////////////////////////////////////////////
+        bool GetFreeNode(uint32_t *NodeIdx)
+        {
+            uint32_t j = 0, Bit = 0;
+
+            if(NumFreeNodes <= 0 ||
+               !_BitScanForward(&j, NodeUsageFree) ||
+               !_BitScanForward(&Bit, ~NodeUsage[j]))
+            {
+                return false;
+            }
+
+            *NodeIdx = (j * 32 + Bit) * TableNodes;
+            return true;
+        }
         HANDLE& GetPoolHandle() { return PoolHandle; }
         POOL_TYPE& GetPoolType() { return PoolType; }
         int& GetNumFreeNode() { return NumFreeNodes; }
+        int GetMaxNodes() { return MaxNodes; }
+        GMM_GFX_SIZE_T GetPoolSize() { return (GMM_GFX_SIZE_T)MaxNodes * PAGE_SIZE; }
+        bool IsPoolUnused() { return NumFreeNodes == MaxNodes; }
+        int GetTableNodes() { return TableNodes; }
         SyncInfo& GetPoolBBInfo() { return PoolBBInfo; }
         uint32_t& GetNodeUsageAtIndex(int j) { return NodeUsage[j]; }
         SyncInfo& GetNodeBBInfoAtIndex(int j)
@@ -238,8 +326,9 @@ namespace GmmLib
         GMM_GFX_ADDRESS GetGfxAddress() { return PoolGfxAddress; }
         GMM_GFX_ADDRESS GetCPUAddress() { return CPUAddress; }
         GMM_RESOURCE_INFO* &GetGmmResInfo() { return pGmmResInfo; }
+        const GmmClientAllocationCallbacks *GetAllocatorCb() { return pClientContext ? pClientContext->GetAllocatorCb() : NULL; }
         bool IsPoolInUse(SyncInfo BBInfo) {
-            if (NumFreeNodes < PAGETABLE_POOL_MAX_NODES ||
+            if (NumFreeNodes < MaxNodes ||
                 (PoolBBInfo.BBQueueHandle == BBInfo.BBQueueHandle &&
                     PoolBBInfo.BBFence == BBInfo.BBFence + 1)) //Pool will be used by next BB submission, freeing it will cause page fault
             {
@@ -256,7 +345,8 @@ namespace GmmLib
     /// Contains functions and members for Table. 
     /// Table defines basic building block for tables at different page-table levels
     /////////////////////////////////////////////////////////////////////////////////////////////
-    class Table
+    class Table :
+        public GmmMemAllocator
     {
     protected:
         GMM_PAGETABLEPool *PoolElem;              //L2 Pool ptr different for L2Tables when Pool_nodes <512
@@ -278,9 +368,13 @@ namespace GmmLib
         GMM_GFX_ADDRESS GetCPUAddress() { return (PoolElem->GetCPUAddress() + (PoolNodeIdx * PAGE_SIZE)); }
         SyncInfo& GetBBInfo() { return BBInfo; }
         uint32_t* &GetUsedEntries() { return UsedEntries; }
+        const GmmClientAllocationCallbacks *GetAllocatorCb() { return PoolElem ? PoolElem->GetAllocatorCb() : NULL; }
         bool TrackTableUsage(TT_TYPE Type, bool IsL1, GMM_GFX_ADDRESS TileAdr, bool NullMapped,GMM_LIB_CONTEXT* pGmmLibContext);
         bool IsTableNullMapped(TT_TYPE Type, bool IsL1, GMM_GFX_ADDRESS TileAdr,GMM_LIB_CONTEXT *pGmmLibContext);
+        void SetTableUsage(uint32_t EntryIdx, uint32_t NumEntries);
+        uint32_t GetNumUsedEntries(int TableDWSize);
         void UpdatePoolFence(GMM_UMD_SYNCCONTEXT * UmdContext, bool ClearNode);
+        void Relocate(GmmPageTablePool *Pool, int NodeIdx) { PoolElem = Pool; PoolNodeIdx = NodeIdx; }
     };
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -291,28 +385,40 @@ namespace GmmLib
     {
     private:
         uint32_t         L2eIdx;
-        LastLevelTable *pNext;
+        LastLevelTable *pNext;                    //links recycled tables in PageTable's free list
+        uint64_t        *pShadow;                 //L1e last written, valid for used entries only. Allocated on first Gpu-update
+        uint32_t         L1UsedEntries[GMM_L1_SIZE_DWORD_MAX]; //UsedEntries storage, avoids separate allocation
 
     public:
         LastLevelTable() : Table(),
             L2eIdx()                             //Pass in Aux vs TR table's GMM_L2_SIZE and initialize L2eIdx?
         {
-            pNext = NULL;
+            pNext       = NULL;
+            pShadow     = NULL;
+            UsedEntries = L1UsedEntries;
+            memset(L1UsedEntries, 0, sizeof(L1UsedEntries));
+        }
+
+        ~LastLevelTable()
+        {
+            DeleteArray(pShadow);
         }
 
         LastLevelTable(GMM_PAGETABLEPool *Elem, int NodeIdx, int DwordL1e, int L2eIndex)
 	: LastLevelTable()
         {
+            Init(Elem, NodeIdx, DwordL1e, L2eIndex);
+        }
+
+        void Init(GMM_PAGETABLEPool *Elem, int NodeIdx, int DwordL1e, int L2eIndex)
+        {
+            __GMM_ASSERT(DwordL1e <= GMM_L1_SIZE_DWORD_MAX);
             PoolElem    = Elem;
             PoolNodeIdx = NodeIdx;
             BBInfo      = Elem->GetNodeBBInfoAtIndex(NodeIdx);
             L2eIdx      = L2eIndex;
             pNext       = NULL;
-            UsedEntries = new uint32_t[DwordL1e]();
-        }
-        ~LastLevelTable()
-        {
-            delete[] UsedEntries;
+            memset(L1UsedEntries, 0, sizeof(L1UsedEntries));
         }
 
         int GetL2eIdx() {
@@ -322,6 +428,31 @@ namespace GmmLib
         LastLevelTable* &Next() {
             return pNext;
         }
+
+        //Shadow kept across recycling, stale values are masked by cleared UsedEntries.
+        //Zero-filled, never matches a valid L1e
+        bool AllocateShadow(uint32_t NumL1e)
+        {
+            if (!pShadow)
+            {
+                pShadow = NewArray<uint64_t>(GetAllocatorCb(), NumL1e, GMM_HEAP_PAGETABLE);
+            }
+            return pShadow != NULL;
+        }
+
+        //true if entry is in use and was last written with Value, ie re-map can be skipped
+        bool IsEntryMapped(uint32_t L1eIdx, uint64_t Value)
+        {
+            return pShadow && (UsedEntries[L1eIdx / 32] & __BIT(L1eIdx % 32)) && pShadow[L1eIdx] == Value;
+        }
+
+        void ShadowEntries(uint32_t L1eIdx, const uint64_t *Values, uint32_t NumL1e)
+        {
+            if (pShadow)
+            {
+                memcpy(&pShadow[L1eIdx], Values, NumL1e * sizeof(uint64_t));
+            }
+        }
     };
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -331,7 +462,7 @@ namespace GmmLib
     class MidLevelTable : public Table
     {
     private:
-        LastLevelTable  *pTTL1;                    //linked list of L1 tables
+        LastLevelTable **pTTL1;                    //L1 tables indexed by L2eIdx, allocated on first insert
 
     public:
         MidLevelTable() :Table()
@@ -339,6 +470,10 @@ namespace GmmLib
             pTTL1 = NULL;
         }
         MidLevelTable(GMM_PAGETABLEPool *Pool, int NodeIdx, SyncInfo Info) : MidLevelTable()
+        {
+            Init(Pool, NodeIdx, Info);
+        }
+        void Init(GMM_PAGETABLEPool *Pool, int NodeIdx, SyncInfo Info)
         {
             PoolElem = Pool;
             BBInfo = Info;
@@ -348,75 +483,43 @@ namespace GmmLib
         {
             if (pTTL1)
             {
-                LastLevelTable* item = pTTL1;
-
-                while (item)
+                for (int i = 0; i < GMM_AUX_L2_SIZE; i++)
                 {
-                    LastLevelTable* nextItem = item->Next();
-                    delete item;
-                    item = nextItem;
+                    delete pTTL1[i];
                 }
 
+                DeleteArray(pTTL1);
                 pTTL1 = NULL;
             }
         }
-        LastLevelTable* GetL1Table(GMM_GFX_SIZE_T L2eIdx, LastLevelTable** Prev = NULL)
+        LastLevelTable* GetL1Table(GMM_GFX_SIZE_T L2eIdx)
         {
-            LastLevelTable* pL1Tbl = pTTL1;
-            LastLevelTable* PrevL1Tbl = NULL;
-
-            while (pL1Tbl)
+            return pTTL1 ? pTTL1[L2eIdx] : NULL;
+        }
+        bool InsertL1Table(LastLevelTable* pL1Tbl)
+        {
+            if (!pTTL1)
             {
-                if (pL1Tbl->GetL2eIdx() == L2eIdx)
+                pTTL1 = NewArray<LastLevelTable *>(GetAllocatorCb(), GMM_AUX_L2_SIZE, GMM_HEAP_PAGETABLE);
+                if (!pTTL1)
                 {
-                    break;
+                    return false;
                 }
-                PrevL1Tbl = pL1Tbl;
-                pL1Tbl = pL1Tbl->Next();
             }
 
-            //if requested, save previous node in linked-list
-            if (Prev)
-            {
-                *Prev = PrevL1Tbl;
-            }
-            return pL1Tbl;
+            __GMM_ASSERT(!pTTL1[pL1Tbl->GetL2eIdx()]);
+            pTTL1[pL1Tbl->GetL2eIdx()] = pL1Tbl;
+            return true;
         }
-        void InsertInList(LastLevelTable* pL1Tbl)
+        LastLevelTable* RemoveL1Table(GMM_GFX_SIZE_T L2eIdx)
         {
-            LastLevelTable* Prev = pTTL1;
+            LastLevelTable* pL1Tbl = GetL1Table(L2eIdx);
 
-            //Insert at end
-            while (Prev && Prev->Next())
-            {
-                Prev = Prev->Next();
-            }
-
-            if (Prev)
-            {
-                Prev->Next() = pL1Tbl;
-            }
-            else
-            {
-                pTTL1 = pL1Tbl;
-            }
-        }
-        void DeleteFromList(LastLevelTable* pL1Tbl, LastLevelTable* PrevL1Tbl)
-        {
-            //Save next L1Table in list, before deleting current one
             if (pL1Tbl)
             {
-                if (PrevL1Tbl)
-                {
-                    PrevL1Tbl->Next() = pL1Tbl->Next();
-                }
-                else
-                {
-                    pTTL1 = pL1Tbl->Next();
-                }
-
-                delete pL1Tbl;
+                pTTL1[L2eIdx] = NULL;
             }
+            return pL1Tbl;
         }
     };
 
@@ -444,35 +547,57 @@ namespace GmmLib
         } TTL3;
 
         MidLevelTable*   pTTL2;                      //array of L2-Tables
+        LastLevelTable*  pFreeL1Tables;              //recycled L1 table objects, reused before allocating new
 
     public:
 #ifdef _WIN32
-        CRITICAL_SECTION    TTLock;                  //synchronized access of PageTable obj
+        CRITICAL_SECTION    TTLock;                  //synchronized access of PageTable obj (L3 table, dummy tables, pFreeL1Tables)
+        CRITICAL_SECTION    L3eLock[PAGETABLE_L3e_LOCK_COUNT];  //synchronized access of L2 table at L3eIdx, and its L1 tables
 #elif defined __linux__
         pthread_mutex_t TTLock;
+        pthread_mutex_t L3eLock[PAGETABLE_L3e_LOCK_COUNT];
 #endif
 
         GmmPageTableMgr*  PageTableMgr;
         GmmClientContext    *pClientContext;
 
-        PageTable(int Size, int NumL3e, TT_TYPE flag) :
+        PageTable(int Size, int NumL3e, TT_TYPE flag, GmmClientContext *pClientContextIn = NULL) :
             TTType(flag),
 	    NodesPerTable(Size / PAGE_SIZE)
         {
             PageTableMgr = NULL;
-            pClientContext = NULL;
+            pClientContext = pClientContextIn;
+            pFreeL1Tables = NULL;
             InitializeCriticalSection(&TTLock);
+            for (int i = 0; i < PAGETABLE_L3e_LOCK_COUNT; i++)
+            {
+                InitializeCriticalSection(&L3eLock[i]);
+            }
 
-            pTTL2 = new MidLevelTable[NumL3e];
+            pTTL2 = NewArray<MidLevelTable>(pClientContext ? pClientContext->GetAllocatorCb() : NULL, NumL3e, GMM_HEAP_PAGETABLE);
         }
 
         ~PageTable()
         {
-            delete[] pTTL2;
+            DeleteArray(pTTL2);
 
+            while (pFreeL1Tables)
+            {
+                LastLevelTable* pL1Tbl = pFreeL1Tables;
+                pFreeL1Tables = pL1Tbl->Next();
+                delete pL1Tbl;
+            }
+
+            for (int i = 0; i < PAGETABLE_L3e_LOCK_COUNT; i++)
+            {
+                DeleteCriticalSection(&L3eLock[i]);
+            }
             DeleteCriticalSection(&TTLock);
         }
 
+        void EnterL3eLock(GMM_GFX_SIZE_T L3eIdx) { EnterCriticalSection(&L3eLock[L3eIdx % PAGETABLE_L3e_LOCK_COUNT]); }
+        void LeaveL3eLock(GMM_GFX_SIZE_T L3eIdx) { LeaveCriticalSection(&L3eLock[L3eIdx % PAGETABLE_L3e_LOCK_COUNT]); }
+
 	inline GMM_LIB_CONTEXT* GetGmmLibContext()
         {
             return pClientContext->GetLibContext();
@@ -484,6 +609,8 @@ namespace GmmLib
         GMM_STATUS DestroyL3Table();
         void AllocateL1L2Table(GMM_GFX_ADDRESS TileAddr, GMM_GFX_ADDRESS * L1TableAdr, GMM_GFX_ADDRESS * L2TableAdr);
         void AllocateDummyTables(GmmLib::Table **L2Table, GmmLib::Table **L1Table);
+        LastLevelTable* GetL1TableObj(GMM_PAGETABLEPool *PoolElem, int NodeIdx, int L2eIdx);
+        void ReleaseL1Table(GMM_GFX_SIZE_T L3eIdx, GMM_GFX_SIZE_T L2eIdx);
         void GetL1L2TableAddr(GMM_GFX_ADDRESS TileAddr, GMM_GFX_ADDRESS * L1TableAdr, GMM_GFX_ADDRESS* L2TableAdr);
         uint8_t GetMappingType(GMM_GFX_ADDRESS GfxVA, GMM_GFX_SIZE_T Size, GMM_GFX_ADDRESS& LastAddr);
         HANDLE GetL3Handle() { return TTL3.L3Handle; }
@@ -497,16 +624,90 @@ namespace GmmLib
     class AuxTable : public PageTable
     {
     public:
+        //////////////////////////////////////////////////////////////////////////////////////////
+        /// Run of contiguous L1 entries, pending Gpu-update via single pfWriteL1Entries callback
+        //////////////////////////////////////////////////////////////////////////////////////////
+        typedef struct AUX_L1_WRITE_BATCH_REC
+        {
+            GMM_GFX_ADDRESS GfxAddress;                             // Gfx address of first pending L1e
+            uint32_t        NumEntries;                             // Number of pending L1e
+            uint64_t        Data[AUX_L1_WRITE_BATCH_MAX_ENTRIES];   // Pending L1e values
+        } AUX_L1_WRITE_BATCH;
+
+        //////////////////////////////////////////////////////////////////////////////////////////
+        /// Pool nodes skipped as relocation destination (Gpu-updates of previous use in flight),
+        /// kept assigned until relocation ends
+        //////////////////////////////////////////////////////////////////////////////////////////
+        typedef struct AUX_HELD_NODES_REC
+        {
+            struct
+            {
+                GmmPageTablePool *Pool;                             // Pool containing node
+                uint32_t          NodeIdx;                          // First pool node of table
+                SyncInfo          BBInfo;                           // Node's pending Gpu-use
+            } Node[AUX_RELOCATE_MAX_HELD_NODES];
+            uint32_t NumNodes;
+        } AUX_HELD_NODES;
+
+        //////////////////////////////////////////////////////////////////////////////////////////
+        /// CCS cacheline position of main-surface 16K chunk, stepped incrementally in address
+        /// order instead of re-deriving it per chunk (non-linear CCS)
+        //////////////////////////////////////////////////////////////////////////////////////////
+        typedef struct AUX_CCS_ITERATOR_REC
+        {
+            GMM_GFX_ADDRESS AuxVA;              // Start adr of Aux-surface
+            uint32_t        AuxPitchInTiles;    // Aux pitch in CCS tiles
+            uint32_t        Pitch;              // Yf: main pitch in 4xYF units, Ys: in Ys tiles; 0: all chunks map to CCS$ <0,0>
+            bool            IsYF;
+            GMM_GFX_SIZE_T  Chunk;              // Current 16K-chunk index from main-surface start
+            uint32_t        x, y;               // Yf: CCS$ <i,j>, Ys: Ys-tile <x,y>
+            uint32_t        SubTile;            // Ys: 16K-chunk within Ys tile (2x2 in Y-major)
+        } AUX_CCS_ITERATOR;
+
+        //////////////////////////////////////////////////////////////////////////////////////////
+        /// Unmapped main-surface VA range [Start, End), pending deferred invalidation
+        //////////////////////////////////////////////////////////////////////////////////////////
+        typedef struct AUX_INVALIDATE_RANGE_REC
+        {
+            GMM_GFX_ADDRESS Start;
+            GMM_GFX_ADDRESS End;
+        } AUX_INVALIDATE_RANGE;
+
+    private:
+        AUX_INVALIDATE_RANGE *pPendingInv;              //sorted, non-overlapping, non-adjacent ranges pending invalidation
+        uint32_t              NumPendingInv;
+        uint32_t              MaxPendingInv;
+        bool                  DeferInvalidate;          //unmaps queue ranges until FlushInvalidations
+        uint64_t              NumMapL1eWritten;         //L1e Gpu-updated by MapValidEntry
+        uint64_t              NumMapL1eSkipped;         //L1e re-mapped to unchanged value, Gpu-update skipped
+
+        uint32_t __FindPendingInvalidate(GMM_GFX_ADDRESS Adr);
+        bool     __GrowPendingInvalidate();
+
+    public:
+#ifdef _WIN32
+        CRITICAL_SECTION    InvLock;                    //synchronized access of pending invalidations, taken before L3eLock
+#elif defined __linux__
+        pthread_mutex_t InvLock;
+#endif
+
         const int L1Size;
         Table* NullL2Table;
         Table* NullL1Table;
         GMM_GFX_ADDRESS NullCCSTile;
         AuxTable(GmmClientContext *pClientContextIn)
-            : PageTable(8 * PAGE_SIZE, GMM_AUX_L3_SIZE, TT_TYPE::AUXTT), L1Size((WA16K(pClientContextIn->GetLibContext()) || WA64K(pClientContextIn->GetLibContext())) ? (2 * PAGE_SIZE) : PAGE_SIZE)
+            : PageTable(8 * PAGE_SIZE, GMM_AUX_L3_SIZE, TT_TYPE::AUXTT, pClientContextIn), L1Size((WA16K(pClientContextIn->GetLibContext()) || WA64K(pClientContextIn->GetLibContext())) ? (2 * PAGE_SIZE) : PAGE_SIZE)
         {
             NullL2Table = nullptr;
             NullL1Table = nullptr;
             NullCCSTile = 0;
+            pPendingInv     = NULL;
+            NumPendingInv   = 0;
+            MaxPendingInv   = 0;
+            DeferInvalidate = false;
+            NumMapL1eWritten = 0;
+            NumMapL1eSkipped = 0;
+            InitializeCriticalSection(&InvLock);
         }
         AuxTable()
             : PageTable(8 * PAGE_SIZE, GMM_AUX_L3_SIZE, TT_TYPE::AUXTT), L1Size(2 * PAGE_SIZE)
@@ -514,15 +715,52 @@ namespace GmmLib
             NullL2Table = nullptr;
             NullL1Table = nullptr;
             NullCCSTile = 0;
+            pPendingInv     = NULL;
+            NumPendingInv   = 0;
+            MaxPendingInv   = 0;
+            DeferInvalidate = false;
+            NumMapL1eWritten = 0;
+            NumMapL1eSkipped = 0;
+            InitializeCriticalSection(&InvLock);
+        }
+        ~AuxTable()
+        {
+            DeleteArray(pPendingInv);
+            DeleteCriticalSection(&InvLock);
         }
         GMM_STATUS InvalidateTable(GMM_UMD_SYNCCONTEXT * UmdContext, GMM_GFX_ADDRESS BaseAdr, GMM_GFX_SIZE_T Size, uint8_t DoNotWait);
 
+        void SetDeferredInvalidate(bool Enable);
+        bool QueueInvalidate(GMM_GFX_ADDRESS BaseAdr, GMM_GFX_SIZE_T Size);
+        GMM_STATUS InvalidatePendingOverlap(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX_ADDRESS BaseAdr, GMM_GFX_SIZE_T Size, uint8_t DoNotWait);
+        GMM_STATUS FlushInvalidations(GMM_UMD_SYNCCONTEXT *UmdContext, uint8_t DoNotWait);
+        uint32_t GetNumPendingInvalidations();
+
+        uint32_t RelocateTables(GMM_UMD_SYNCCONTEXT *UmdContext, uint8_t DoNotWait, HANDLE BBQueueHandle, uint64_t CompletedFence);
+        void GetMapStats(GMM_PAGETABLE_MGR_STATS *pStats);
+        void GetTableStats(uint32_t *pNumL2Tables, uint32_t *pNumL1Tables, GMM_GFX_SIZE_T *pMappedSize);
+        uint32_t DumpTables(char *pBuffer, uint32_t BufferSize, uint32_t Len);
+
         GMM_STATUS MapValidEntry(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX_ADDRESS BaseAdr, GMM_GFX_SIZE_T BaseSize,
                                  GMM_RESOURCE_INFO* BaseResInfo, GMM_GFX_ADDRESS AuxVA, GMM_RESOURCE_INFO* AuxResInfo, uint64_t PartialData, uint8_t DoNotWait);
 
         GMM_STATUS MapNullCCS(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_GFX_ADDRESS BaseAdr, GMM_GFX_SIZE_T Size, uint64_t PartialL1e, uint8_t DoNotWait);
+        GMM_STATUS InitNullTables();
 
         GMM_AUXTTL1e CreateAuxL1Data(GMM_RESOURCE_INFO* BaseResInfo);
+
+        void InitTableEntries(GMM_UMD_SYNCCONTEXT *UmdContext, AUX_L1_WRITE_BATCH *Batch, Table *pTable,
+                              GMM_GFX_ADDRESS TableGfxAdr, bool IsL1, uint64_t Data, uint8_t DoNotWait);
+        GmmPageTablePool *AssignRelocationNode(uint32_t *NodeIdx, POOL_TYPE PoolType, AUX_HELD_NODES *Held, uint8_t DoNotWait,
+                                               HANDLE BBQueueHandle, uint64_t CompletedFence, bool *NodePending);
+        void CopyTableEntries(GMM_UMD_SYNCCONTEXT *UmdContext, AUX_L1_WRITE_BATCH *Batch, Table *pTable,
+                              GMM_GFX_ADDRESS SrcCPUAdr, bool IsL1, bool NodePending);
+        void WriteL1Entry(GMM_UMD_SYNCCONTEXT *UmdContext, AUX_L1_WRITE_BATCH *Batch, GMM_GFX_ADDRESS GfxAddress, uint64_t Data);
+        void FlushL1Entries(GMM_UMD_SYNCCONTEXT *UmdContext, AUX_L1_WRITE_BATCH *Batch);
+        void FillLinearL1Entries(uint64_t *L1CPUAdr, uint32_t NumEntries, uint64_t FirstEntry, uint64_t Step);
+        void InitCCSIterator(AUX_CCS_ITERATOR *Iter, GMM_RESOURCE_INFO *BaseResInfo, GMM_RESOURCE_INFO *AuxResInfo,
+                             GMM_GFX_ADDRESS AuxVA, GMM_GFX_SIZE_T AdrOffset);
+        GMM_GFX_ADDRESS StepCCSIterator(AUX_CCS_ITERATOR *Iter, GMM_GFX_SIZE_T AdrOffset);
         GMM_GFX_ADDRESS GMM_INLINE __GetCCSCacheline(GMM_RESOURCE_INFO* BaseResInfo, GMM_GFX_ADDRESS BaseAdr, GMM_RESOURCE_INFO* AuxResInfo,
                                                      GMM_GFX_ADDRESS AuxVA, GMM_GFX_SIZE_T AdrOffset);
 
@@ -23,12 +23,18 @@ OTHER DEALINGS IN THE SOFTWARE.
 #if defined (__linux__) && !defined(__i386__)
 
 #include "GmmAuxTableULT.h"
+#include <algorithm>
+#include <chrono>
+#include <dlfcn.h>
+#include <pthread.h>
 
 using namespace std;
 using namespace GmmLib;
 
 static GMM_DEVICE_CALLBACKS_INT DeviceCBInt;
 
+CTestAuxTable::TT_WRITE_STATS CTestAuxTable::TTWriteStats;
+
 CTestAuxTable::CTestAuxTable()
 {
 }
@@ -66,6 +72,37 @@ void CTestAuxTable::waitFromCpuCB(void *bo)
 {
 }
 
+int CTestAuxTable::prologTranslationTableCB(void *pDeviceHandle)
+{
+    TTWriteStats.NumProlog++;
+    return 0;
+}
+
+int CTestAuxTable::writeL1EntriesCB(void *pDeviceHandle, const uint32_t NumEntries, GMM_GFX_ADDRESS GfxAddress, uint32_t *Data)
+{
+    // NumEntries is in DWORDs
+    memcpy((void *)GfxAddress, Data, NumEntries * sizeof(uint32_t));
+
+    TTWriteStats.NumWriteL1Entries++;
+    TTWriteStats.NumBytes += NumEntries * sizeof(uint32_t);
+    return 0;
+}
+
+int CTestAuxTable::writeL2L3EntryCB(void *pDeviceHandle, GMM_GFX_ADDRESS GfxAddress, uint64_t Data)
+{
+    *(uint64_t *)GfxAddress = Data;
+
+    TTWriteStats.NumWriteL2L3Entry++;
+    TTWriteStats.NumBytes += sizeof(uint64_t);
+    return 0;
+}
+
+int CTestAuxTable::epilogTranslationTableCB(void *pDeviceHandle, uint8_t ForceFlush)
+{
+    TTWriteStats.NumEpilog++;
+    return 0;
+}
+
 void CTestAuxTable::SetUpTestCase()
 {
     GfxPlatform.eProductFamily    = IGFX_TIGERLAKE_LP;
@@ -262,4 +299,2042 @@ TEST_F(CTestAuxTable, TestAuxTableContent)
     pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
 }
 
+TEST_F(CTestAuxTable, TestAuxTableCoalescedL1Writes)
+{
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+
+    mgr->TTCb.pfPrologTranslationTable = CTestAuxTable::prologTranslationTableCB;
+    mgr->TTCb.pfWriteL1Entries         = CTestAuxTable::writeL1EntriesCB;
+    mgr->TTCb.pfWriteL2L3Entry         = CTestAuxTable::writeL2L3EntryCB;
+    mgr->TTCb.pfEpilogTranslationTable = CTestAuxTable::epilogTranslationTableCB;
+    mgr->SetAuxMapGpuUpdate(1);
+    mgr->SetAtomicL1EntriesWrite(1);
+
+    Surface *surf = new Surface(1920, 1080);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GMM_UMD_SYNCCONTEXT UmdContext = {0};
+    UmdContext.pCommandQueueHandle = (void *)0xdeadbeef;
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+
+    updateReq.UmdContext  = &UmdContext;
+    updateReq.BaseResInfo = surf->getGMMResourceInfo();
+    updateReq.BaseGpuVA   = surf->getGfxAddress(GMM_PLANE_Y);
+    updateReq.Map         = 1;
+
+    memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+
+    GMM_STATUS res = mgr->UpdateAuxTable(&updateReq);
+    ASSERT_TRUE(res == GMM_SUCCESS);
+
+    // L1e go through pfWriteL1Entries only, coalesced well below one call per tile
+    size_t TileSize = (const_cast<WA_TABLE &>(pGfxAdapterInfo->WaTable).WaAuxTable16KGranular) ? GMM_KBYTE(16) : GMM_KBYTE(64);
+    size_t NumTiles = surf->getGMMResourceInfo()->GetSizeMainSurface() / TileSize;
+    EXPECT_GT(TTWriteStats.NumWriteL1Entries, 0u);
+    EXPECT_LT(TTWriteStats.NumWriteL1Entries, NumTiles);
+
+    // Gpu-updated table content must match the Cpu-update path
+    Walker *ywalker = new Walker(surf->getGfxAddress(GMM_PLANE_Y),
+                                 surf->getAuxGfxAddress(GMM_AUX_CCS),
+                                 mgr->GetAuxL3TableAddr());
+
+    for(size_t i = 0; i < surf->getSurfaceSize(GMM_PLANE_Y); i += GMM_KBYTE(4))
+    {
+        GMM_GFX_ADDRESS addr = surf->getGfxAddress(GMM_PLANE_Y) + i;
+        ASSERT_EQ(ywalker->expected(addr), ywalker->walk(addr));
+    }
+
+    Walker *uvwalker = new Walker(surf->getGfxAddress(GMM_PLANE_U),
+                                  surf->getAuxGfxAddress(GMM_AUX_UV_CCS),
+                                  mgr->GetAuxL3TableAddr());
+
+    for(size_t i = 0; i < surf->getSurfaceSize(GMM_PLANE_U); i += GMM_KBYTE(4))
+    {
+        GMM_GFX_ADDRESS addr = surf->getGfxAddress(GMM_PLANE_U) + i;
+        ASSERT_EQ(uvwalker->expected(addr), uvwalker->walk(addr));
+    }
+
+    delete uvwalker;
+    delete ywalker;
+    delete surf;
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+}
+
+// pfWriteL1Entries isn't used unless client declares its QWORD writes atomic, L1e written one by one
+TEST_F(CTestAuxTable, TestAuxTableL1WritesPerEntryDefault)
+{
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+
+    mgr->TTCb.pfPrologTranslationTable = CTestAuxTable::prologTranslationTableCB;
+    mgr->TTCb.pfWriteL1Entries         = CTestAuxTable::writeL1EntriesCB;
+    mgr->TTCb.pfWriteL2L3Entry         = CTestAuxTable::writeL2L3EntryCB;
+    mgr->TTCb.pfEpilogTranslationTable = CTestAuxTable::epilogTranslationTableCB;
+    mgr->SetAuxMapGpuUpdate(1);
+
+    Surface *surf = new Surface(1920, 1080);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GMM_UMD_SYNCCONTEXT UmdContext = {0};
+    UmdContext.pCommandQueueHandle = (void *)0xdeadbeef;
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+
+    updateReq.UmdContext  = &UmdContext;
+    updateReq.BaseResInfo = surf->getGMMResourceInfo();
+    updateReq.BaseGpuVA   = surf->getGfxAddress(GMM_PLANE_Y);
+    updateReq.Map         = 1;
+
+    memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+
+    GMM_STATUS res = mgr->UpdateAuxTable(&updateReq);
+    ASSERT_TRUE(res == GMM_SUCCESS);
+
+    // One 64-bit pfWriteL2L3Entry per tile
+    size_t TileSize = (const_cast<WA_TABLE &>(pGfxAdapterInfo->WaTable).WaAuxTable16KGranular) ? GMM_KBYTE(16) : GMM_KBYTE(64);
+    size_t NumTiles = surf->getGMMResourceInfo()->GetSizeMainSurface() / TileSize;
+    EXPECT_EQ(0u, TTWriteStats.NumWriteL1Entries);
+    EXPECT_GE(TTWriteStats.NumWriteL2L3Entry, NumTiles);
+
+    Walker *ywalker = new Walker(surf->getGfxAddress(GMM_PLANE_Y),
+                                 surf->getAuxGfxAddress(GMM_AUX_CCS),
+                                 mgr->GetAuxL3TableAddr());
+
+    for(size_t i = 0; i < surf->getSurfaceSize(GMM_PLANE_Y); i += GMM_KBYTE(4))
+    {
+        GMM_GFX_ADDRESS addr = surf->getGfxAddress(GMM_PLANE_Y) + i;
+        ASSERT_EQ(ywalker->expected(addr), ywalker->walk(addr));
+    }
+
+    // Unmap invalidates per entry too
+    updateReq.Map = 0;
+    memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+
+    res = mgr->UpdateAuxTable(&updateReq);
+    ASSERT_TRUE(res == GMM_SUCCESS);
+    EXPECT_EQ(0u, TTWriteStats.NumWriteL1Entries);
+
+    delete ywalker;
+    delete surf;
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+}
+
+TEST_F(CTestAuxTable, TestAuxTableInitReusedTable)
+{
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+
+    mgr->TTCb.pfPrologTranslationTable = CTestAuxTable::prologTranslationTableCB;
+    mgr->TTCb.pfWriteL1Entries         = CTestAuxTable::writeL1EntriesCB;
+    mgr->TTCb.pfWriteL2L3Entry         = CTestAuxTable::writeL2L3EntryCB;
+    mgr->TTCb.pfEpilogTranslationTable = CTestAuxTable::epilogTranslationTableCB;
+    mgr->SetAuxMapGpuUpdate(1);
+    mgr->SetAtomicL1EntriesWrite(1);
+
+    Surface *surf = new Surface(1920, 1080);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GMM_UMD_SYNCCONTEXT UmdContext = {0};
+    UmdContext.pCommandQueueHandle = (void *)0xdeadbeef;
+    UmdContext.BBFenceObj          = (HANDLE)0xdeadbeef;
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+
+    updateReq.UmdContext  = &UmdContext;
+    updateReq.BaseResInfo = surf->getGMMResourceInfo();
+    updateReq.BaseGpuVA   = surf->getGfxAddress(GMM_PLANE_Y);
+    updateReq.Map         = 1;
+
+    // Fresh tables are Cpu-filled, only mapped entries are Gpu-written
+    memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+    ASSERT_TRUE(mgr->UpdateAuxTable(&updateReq) == GMM_SUCCESS);
+    uint64_t FreshTableBytes = TTWriteStats.NumBytes;
+
+    // Unmap releases L1 table with its last Gpu-update fence
+    updateReq.Map = 0;
+    ASSERT_TRUE(mgr->UpdateAuxTable(&updateReq) == GMM_SUCCESS);
+
+    // Reused pool node may have Gpu-updates in flight, so it's Gpu-initialized
+    updateReq.Map = 1;
+    memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+    ASSERT_TRUE(mgr->UpdateAuxTable(&updateReq) == GMM_SUCCESS);
+    EXPECT_GT(TTWriteStats.NumBytes, FreshTableBytes);
+
+    Walker *ywalker = new Walker(surf->getGfxAddress(GMM_PLANE_Y),
+                                 surf->getAuxGfxAddress(GMM_AUX_CCS),
+                                 mgr->GetAuxL3TableAddr());
+
+    for(size_t i = 0; i < surf->getSurfaceSize(GMM_PLANE_Y); i += GMM_KBYTE(4))
+    {
+        GMM_GFX_ADDRESS addr = surf->getGfxAddress(GMM_PLANE_Y) + i;
+        ASSERT_EQ(ywalker->expected(addr), ywalker->walk(addr));
+    }
+
+    delete ywalker;
+    delete surf;
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+}
+
+TEST_F(CTestAuxTable, DISABLED_BenchmarkAuxTableL1WriteCoalescing)
+{
+    const struct
+    {
+        unsigned int Width;
+        unsigned int Height;
+    } SurfSizes[] = {{1280, 720}, {1920, 1080}, {3840, 2160}, {7680, 4320}};
+
+    // Per-entry pfWriteL2L3Entry (no pfWriteL1Entries) vs coalesced pfWriteL1Entries
+    for(int Coalesce = 0; Coalesce <= 1; Coalesce++)
+    {
+        for(size_t n = 0; n < sizeof(SurfSizes) / sizeof(SurfSizes[0]); n++)
+        {
+            GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+            ASSERT_TRUE(mgr != NULL);
+
+            mgr->TTCb.pfPrologTranslationTable = CTestAuxTable::prologTranslationTableCB;
+            mgr->TTCb.pfWriteL1Entries         = Coalesce ? CTestAuxTable::writeL1EntriesCB : NULL;
+            mgr->TTCb.pfWriteL2L3Entry         = CTestAuxTable::writeL2L3EntryCB;
+            mgr->TTCb.pfEpilogTranslationTable = CTestAuxTable::epilogTranslationTableCB;
+            mgr->SetAuxMapGpuUpdate(1);
+            mgr->SetAtomicL1EntriesWrite(Coalesce);
+
+            Surface *surf = new Surface(SurfSizes[n].Width, SurfSizes[n].Height);
+
+            ASSERT_TRUE(surf != NULL && surf->init());
+
+            GMM_UMD_SYNCCONTEXT UmdContext = {0};
+            UmdContext.pCommandQueueHandle = (void *)0xdeadbeef;
+
+            GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+
+            updateReq.UmdContext  = &UmdContext;
+            updateReq.BaseResInfo = surf->getGMMResourceInfo();
+            updateReq.BaseGpuVA   = surf->getGfxAddress(GMM_PLANE_Y);
+            updateReq.Map         = 1;
+
+            memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+
+            GMM_STATUS res = mgr->UpdateAuxTable(&updateReq);
+            ASSERT_TRUE(res == GMM_SUCCESS);
+
+            printf("%-10s %5ux%-5u: WriteL1Entries=%llu WriteL2L3Entry=%llu Callbacks=%llu Bytes=%llu\n",
+                   Coalesce ? "coalesced" : "per-entry", SurfSizes[n].Width, SurfSizes[n].Height,
+                   (unsigned long long)TTWriteStats.NumWriteL1Entries,
+                   (unsigned long long)TTWriteStats.NumWriteL2L3Entry,
+                   (unsigned long long)(TTWriteStats.NumWriteL1Entries + TTWriteStats.NumWriteL2L3Entry),
+                   (unsigned long long)TTWriteStats.NumBytes);
+
+            delete surf;
+            pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+        }
+    }
+}
+
+TEST_F(CTestAuxTable, TestAuxTablePoolNodeReuse)
+{
+    const int num_surf = 64;
+    Surface * surfaces[num_surf];
+    int       i;
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+
+    // Map all, unmap every other surface and remap it, so freed pool nodes get reused
+    for(int pass = 0; pass < 2; pass++)
+    {
+        for(i = 0; i < num_surf; i++)
+        {
+            if(pass && (i & 1))
+            {
+                continue;
+            }
+
+            if(!pass)
+            {
+                surfaces[i] = new Surface(1920, 1080);
+                ASSERT_TRUE(surfaces[i] != NULL && surfaces[i]->init());
+            }
+
+            GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+
+            updateReq.BaseResInfo = surfaces[i]->getGMMResourceInfo();
+            updateReq.BaseGpuVA   = surfaces[i]->getGfxAddress(GMM_PLANE_Y);
+            updateReq.Map         = 1;
+
+            if(pass)
+            {
+                updateReq.Map = 0;
+                ASSERT_TRUE(mgr->UpdateAuxTable(&updateReq) == GMM_SUCCESS);
+                updateReq.Map = 1;
+            }
+
+            ASSERT_TRUE(mgr->UpdateAuxTable(&updateReq) == GMM_SUCCESS);
+        }
+    }
+
+    for(i = 0; i < num_surf; i++)
+    {
+        Walker walker(surfaces[i]->getGfxAddress(GMM_PLANE_Y),
+                      surfaces[i]->getAuxGfxAddress(GMM_AUX_CCS),
+                      mgr->GetAuxL3TableAddr());
+
+        for(size_t j = 0; j < surfaces[i]->getSurfaceSize(GMM_PLANE_Y); j += GMM_KBYTE(64))
+        {
+            GMM_GFX_ADDRESS addr = surfaces[i]->getGfxAddress(GMM_PLANE_Y) + j;
+            ASSERT_EQ(walker.expected(addr), walker.walk(addr));
+        }
+    }
+
+    for(i = 0; i < num_surf; i++)
+    {
+        delete surfaces[i];
+    }
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+}
+
+TEST_F(CTestAuxTable, DISABLED_BenchmarkAuxTablePoolNodeAlloc)
+{
+    const int SurfCounts[] = {64, 512, 2048};
+
+    for(size_t n = 0; n < sizeof(SurfCounts) / sizeof(SurfCounts[0]); n++)
+    {
+        const int num_surf = SurfCounts[n];
+        Surface **surfaces = new Surface *[num_surf];
+        int       i;
+
+        GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+        ASSERT_TRUE(mgr != NULL);
+
+        for(i = 0; i < num_surf; i++)
+        {
+            surfaces[i] = new Surface(1280, 720);
+            ASSERT_TRUE(surfaces[i] != NULL && surfaces[i]->init());
+        }
+
+        auto Start = std::chrono::steady_clock::now();
+
+        // Surfaces are placed 64MB apart (tables only, surface memory isn't touched) so each gets own L1 table,
+        // map all, then unmap/remap each, every remap allocates its L1 table from a populated pool set
+        for(int Map = 1; Map >= 0; Map--)
+        {
+            for(i = 0; i < num_surf; i++)
+            {
+                GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+
+                updateReq.BaseResInfo = surfaces[i]->getGMMResourceInfo();
+                updateReq.BaseGpuVA   = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(64);
+                updateReq.Map         = Map;
+
+                if(!Map)
+                {
+                    mgr->UpdateAuxTable(&updateReq);
+                    updateReq.Map = 1;
+                }
+                mgr->UpdateAuxTable(&updateReq);
+            }
+        }
+
+        auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+
+        printf("%5d surfaces: %lld us, %.2f us/update, PageTableBOs=%d\n",
+               num_surf, (long long)Elapsed, (double)Elapsed / (num_surf * 3), mgr->GetNumOfPageTableBOs(AUXTT));
+
+        for(i = 0; i < num_surf; i++)
+        {
+            delete surfaces[i];
+        }
+        delete[] surfaces;
+        pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    }
+}
+
+// Per-thread input for multi-threaded Aux-table map/unmap ULTs
+typedef struct
+{
+    GmmPageTableMgr *  mgr;
+    GMM_RESOURCE_INFO *ResInfo;
+    GMM_GFX_ADDRESS    BaseVA;   // VA of thread's first surface
+    GMM_GFX_SIZE_T     Stride;   // VA distance between thread's surfaces
+    int                NumSurf;
+    int                Passes;   // 0: map all, unmap/remap odd ones; >0: map/unmap all, Passes times
+    pthread_barrier_t *pBarrier;
+    int                Failures;
+} AUXTT_MT_PARAMS;
+
+static int AuxTTUpdate(AUXTT_MT_PARAMS *pParams, GMM_GFX_ADDRESS BaseVA, uint8_t Map)
+{
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+
+    updateReq.BaseResInfo = pParams->ResInfo;
+    updateReq.BaseGpuVA   = BaseVA;
+    updateReq.Map         = Map;
+
+    return (pParams->mgr->UpdateAuxTable(&updateReq) == GMM_SUCCESS) ? 0 : 1;
+}
+
+static void *AuxTTMapUnmapThread(void *pArg)
+{
+    AUXTT_MT_PARAMS *pParams = (AUXTT_MT_PARAMS *)pArg;
+
+    pthread_barrier_wait(pParams->pBarrier);
+
+    if(!pParams->Passes)
+    {
+        for(int i = 0; i < pParams->NumSurf; i++)
+        {
+            pParams->Failures += AuxTTUpdate(pParams, pParams->BaseVA + i * pParams->Stride, 1);
+        }
+        for(int i = 1; i < pParams->NumSurf; i += 2)
+        {
+            pParams->Failures += AuxTTUpdate(pParams, pParams->BaseVA + i * pParams->Stride, 0);
+            pParams->Failures += AuxTTUpdate(pParams, pParams->BaseVA + i * pParams->Stride, 1);
+        }
+    }
+
+    for(int pass = 0; pass < pParams->Passes; pass++)
+    {
+        for(int Map = 1; Map >= 0; Map--)
+        {
+            for(int i = 0; i < pParams->NumSurf; i++)
+            {
+                pParams->Failures += AuxTTUpdate(pParams, pParams->BaseVA + i * pParams->Stride, (uint8_t)Map);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+// Runs NumThreads threads on mgr, returns wall time in microseconds
+static long long AuxTTRunThreads(AUXTT_MT_PARAMS *Params, int NumThreads)
+{
+    pthread_t         ThreadId[16];
+    pthread_barrier_t Barrier;
+
+    pthread_barrier_init(&Barrier, NULL, NumThreads + 1);
+
+    for(int t = 0; t < NumThreads; t++)
+    {
+        Params[t].pBarrier = &Barrier;
+        EXPECT_EQ(0, pthread_create(&ThreadId[t], NULL, AuxTTMapUnmapThread, (void *)&Params[t]));
+    }
+
+    auto Start = std::chrono::steady_clock::now();
+    pthread_barrier_wait(&Barrier);
+
+    for(int t = 0; t < NumThreads; t++)
+    {
+        EXPECT_EQ(0, pthread_join(ThreadId[t], NULL));
+    }
+
+    auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+
+    pthread_barrier_destroy(&Barrier);
+    return (long long)Elapsed;
+}
+
+TEST_F(CTestAuxTable, TestAuxTableMultiThreadedMapUnmap)
+{
+    const int       NumThreads = 8;
+    const int       NumSurf    = 16;
+    AUXTT_MT_PARAMS Params[NumThreads];
+    Surface *       surfaces[NumThreads];
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+
+    // Threads interleave 4MB apart, sharing L1 tables, half of them in other L3e (64GB VA range)
+    for(int t = 0; t < NumThreads; t++)
+    {
+        surfaces[t] = new Surface(1920, 1080);
+        ASSERT_TRUE(surfaces[t] != NULL && surfaces[t]->init());
+        ASSERT_LE(surfaces[t]->getGMMResourceInfo()->GetSizeMainSurface(), GMM_MBYTE(4));
+
+        memset(&Params[t], 0, sizeof(Params[t]));
+        Params[t].mgr     = mgr;
+        Params[t].ResInfo = surfaces[t]->getGMMResourceInfo();
+        Params[t].BaseVA  = GMM_GBYTE(64) * (1 + (t & 1)) + (t / 2) * GMM_MBYTE(4);
+        Params[t].Stride  = (NumThreads / 2) * GMM_MBYTE(4);
+        Params[t].NumSurf = NumSurf;
+    }
+
+    AuxTTRunThreads(Params, NumThreads);
+
+    for(int t = 0; t < NumThreads; t++)
+    {
+        EXPECT_EQ(0, Params[t].Failures);
+
+        for(int i = 0; i < NumSurf; i++)
+        {
+            GMM_GFX_ADDRESS BaseVA = Params[t].BaseVA + i * Params[t].Stride;
+            Walker          walker(BaseVA, BaseVA + Params[t].ResInfo->GetUnifiedAuxSurfaceOffset(GMM_AUX_CCS), mgr->GetAuxL3TableAddr());
+
+            for(GMM_GFX_SIZE_T j = 0; j < surfaces[t]->getSurfaceSize(GMM_PLANE_Y); j += GMM_KBYTE(64))
+            {
+                ASSERT_EQ(walker.expected(BaseVA + j), walker.walk(BaseVA + j));
+            }
+        }
+    }
+
+    // Unmap everything concurrently, all L1 tables get released
+    for(int t = 0; t < NumThreads; t++)
+    {
+        Params[t].Passes = 1;
+    }
+
+    AuxTTRunThreads(Params, NumThreads);
+
+    for(int t = 0; t < NumThreads; t++)
+    {
+        EXPECT_EQ(0, Params[t].Failures);
+    }
+
+    for(int t = 0; t < NumThreads; t++)
+    {
+        delete surfaces[t];
+    }
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+}
+
+TEST_F(CTestAuxTable, DISABLED_BenchmarkAuxTableMultiThreadedMap)
+{
+    const int NumSurf = 256;
+    const int Passes  = 8;
+
+    // Threads on disjoint L3e (64GB VA ranges), then all in same L3e
+    for(int SameL3e = 0; SameL3e <= 1; SameL3e++)
+    {
+        for(int NumThreads = 1; NumThreads <= 8; NumThreads *= 2)
+        {
+            AUXTT_MT_PARAMS Params[8];
+            Surface *       surfaces[8];
+
+            GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+            ASSERT_TRUE(mgr != NULL);
+
+            for(int t = 0; t < NumThreads; t++)
+            {
+                surfaces[t] = new Surface(1920, 1080);
+                ASSERT_TRUE(surfaces[t] != NULL && surfaces[t]->init());
+
+                memset(&Params[t], 0, sizeof(Params[t]));
+                Params[t].mgr     = mgr;
+                Params[t].ResInfo = surfaces[t]->getGMMResourceInfo();
+                Params[t].BaseVA  = SameL3e ? (GMM_GBYTE(64) + t * NumSurf * GMM_MBYTE(4)) : (GMM_GBYTE(64) * (t + 1));
+                Params[t].Stride  = GMM_MBYTE(4);
+                Params[t].NumSurf = NumSurf;
+                Params[t].Passes  = Passes;
+            }
+
+            long long Elapsed = AuxTTRunThreads(Params, NumThreads);
+            int       Updates = NumThreads * NumSurf * Passes * 2;
+
+            printf("%-12s %d threads: %lld us, %.0f updates/s\n", SameL3e ? "same L3e" : "disjoint L3e",
+                   NumThreads, Elapsed, Updates * 1e6 / (double)(Elapsed ? Elapsed : 1));
+
+            for(int t = 0; t < NumThreads; t++)
+            {
+                EXPECT_EQ(0, Params[t].Failures);
+                delete surfaces[t];
+            }
+            pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+        }
+    }
+}
+
+TEST_F(CTestAuxTable, TestUpdateAuxTablesBulk)
+{
+    const int NumSurf = 8;
+    Surface * surfaces[NumSurf + 1];
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+
+    mgr->TTCb.pfPrologTranslationTable = CTestAuxTable::prologTranslationTableCB;
+    mgr->TTCb.pfWriteL1Entries         = CTestAuxTable::writeL1EntriesCB;
+    mgr->TTCb.pfWriteL2L3Entry         = CTestAuxTable::writeL2L3EntryCB;
+    mgr->TTCb.pfEpilogTranslationTable = CTestAuxTable::epilogTranslationTableCB;
+    mgr->SetAuxMapGpuUpdate(1);
+    mgr->SetAtomicL1EntriesWrite(1);
+
+    GMM_UMD_SYNCCONTEXT UmdContext = {0};
+    UmdContext.pCommandQueueHandle = (void *)0xdeadbeef;
+
+    GMM_DDI_UPDATEAUXTABLE updateReqs[NumSurf + 1];
+    GMM_STATUS             status[NumSurf + 1];
+
+    // Last request is for non-compressed surface, must fail alone
+    for(int i = 0; i <= NumSurf; i++)
+    {
+        surfaces[i] = new Surface(1280, 720, i < NumSurf);
+        ASSERT_TRUE(surfaces[i] != NULL && surfaces[i]->init());
+
+        memset(&updateReqs[i], 0, sizeof(updateReqs[i]));
+        updateReqs[i].UmdContext  = &UmdContext;
+        updateReqs[i].BaseResInfo = surfaces[i]->getGMMResourceInfo();
+        updateReqs[i].BaseGpuVA   = surfaces[i]->getGfxAddress(GMM_PLANE_Y);
+        updateReqs[i].Map         = 1;
+    }
+
+    memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+
+    EXPECT_EQ(GMM_INVALIDPARAM, mgr->UpdateAuxTables(updateReqs, NumSurf + 1, status));
+
+    for(int i = 0; i < NumSurf; i++)
+    {
+        EXPECT_EQ(GMM_SUCCESS, status[i]);
+    }
+    EXPECT_EQ(GMM_INVALIDPARAM, status[NumSurf]);
+
+    // Single prolog/epilog for all requests on the cmdQ
+    EXPECT_EQ(1u, TTWriteStats.NumProlog);
+    EXPECT_EQ(1u, TTWriteStats.NumEpilog);
+
+    for(int i = 0; i < NumSurf; i++)
+    {
+        for(int plane = 0; plane < 2; plane++)
+        {
+            GMM_YUV_PLANE Plane = plane ? GMM_PLANE_U : GMM_PLANE_Y;
+            Walker        walker(surfaces[i]->getGfxAddress(Plane),
+                          surfaces[i]->getAuxGfxAddress(plane ? GMM_AUX_UV_CCS : GMM_AUX_CCS),
+                          mgr->GetAuxL3TableAddr());
+
+            for(size_t j = 0; j < surfaces[i]->getSurfaceSize(Plane); j += GMM_KBYTE(64))
+            {
+                GMM_GFX_ADDRESS addr = surfaces[i]->getGfxAddress(Plane) + j;
+                ASSERT_EQ(walker.expected(addr), walker.walk(addr));
+            }
+        }
+    }
+
+    // Bulk unmap
+    for(int i = 0; i < NumSurf; i++)
+    {
+        updateReqs[i].Map = 0;
+    }
+    EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTables(updateReqs, NumSurf, status));
+
+    for(int i = 0; i <= NumSurf; i++)
+    {
+        delete surfaces[i];
+    }
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+}
+
+// Overlapping requests keep caller's order, map B then unmap A covering B leaves B unmapped
+TEST_F(CTestAuxTable, TestUpdateAuxTablesOverlap)
+{
+    Surface *surfA = new Surface(1920, 1080);
+    Surface *surfB = new Surface(256, 256);
+
+    ASSERT_TRUE(surfA != NULL && surfA->init());
+    ASSERT_TRUE(surfB != NULL && surfB->init());
+
+    GMM_UMD_SYNCCONTEXT UmdContext = {0};
+    UmdContext.pCommandQueueHandle = (void *)0xdeadbeef;
+
+    GMM_DDI_UPDATEAUXTABLE updateReqs[2];
+    memset(updateReqs, 0, sizeof(updateReqs));
+
+    updateReqs[0].UmdContext  = &UmdContext;
+    updateReqs[0].BaseResInfo = surfB->getGMMResourceInfo();
+    updateReqs[0].BaseGpuVA   = GMM_GBYTE(4) + GMM_KBYTE(64);
+    updateReqs[0].Map         = 1;
+
+    updateReqs[1].UmdContext  = &UmdContext;
+    updateReqs[1].BaseResInfo = surfA->getGMMResourceInfo();
+    updateReqs[1].BaseGpuVA   = GMM_GBYTE(4);
+    updateReqs[1].Map         = 0;
+
+    ASSERT_GT(surfA->getGMMResourceInfo()->GetSizeMainSurface(), GMM_KBYTE(64) + surfB->getGMMResourceInfo()->GetSizeMainSurface());
+
+    GmmPageTableMgr *mgr[2];
+    for(int Bulk = 0; Bulk <= 1; Bulk++)
+    {
+        mgr[Bulk] = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+        ASSERT_TRUE(mgr[Bulk] != NULL);
+
+        mgr[Bulk]->TTCb.pfPrologTranslationTable = CTestAuxTable::prologTranslationTableCB;
+        mgr[Bulk]->TTCb.pfWriteL1Entries         = CTestAuxTable::writeL1EntriesCB;
+        mgr[Bulk]->TTCb.pfWriteL2L3Entry         = CTestAuxTable::writeL2L3EntryCB;
+        mgr[Bulk]->TTCb.pfEpilogTranslationTable = CTestAuxTable::epilogTranslationTableCB;
+        mgr[Bulk]->SetAuxMapGpuUpdate(1);
+
+        if(Bulk)
+        {
+            ASSERT_EQ(GMM_SUCCESS, mgr[Bulk]->UpdateAuxTables(updateReqs, 2, NULL));
+        }
+        else
+        {
+            ASSERT_EQ(GMM_SUCCESS, mgr[Bulk]->UpdateAuxTable(&updateReqs[0]));
+            ASSERT_EQ(GMM_SUCCESS, mgr[Bulk]->UpdateAuxTable(&updateReqs[1]));
+        }
+    }
+
+    // Aux adr of L1e mapping addr, 0 if unmap released its L1/L2 table
+    auto Walk = [](GmmPageTableMgr *pMgr, GMM_GFX_ADDRESS addr) -> GMM_GFX_ADDRESS {
+        Walker walker(0, 0, pMgr->GetAuxL3TableAddr());
+        if(!(((uint64_t *)pMgr->GetAuxL3TableAddr())[Walker::l3Index(addr)] & 1) || !walker.l2Valid(addr))
+        {
+            return 0;
+        }
+        return walker.walk(addr);
+    };
+
+    Walker walkerB(updateReqs[0].BaseGpuVA, updateReqs[0].BaseGpuVA + surfB->getGMMResourceInfo()->GetUnifiedAuxSurfaceOffset(GMM_AUX_CCS), 0);
+    EXPECT_NE(walkerB.expected(updateReqs[0].BaseGpuVA), Walk(mgr[1], updateReqs[0].BaseGpuVA));
+
+    for(GMM_GFX_SIZE_T Offset = 0; Offset < surfA->getGMMResourceInfo()->GetSizeMainSurface(); Offset += GMM_KBYTE(16))
+    {
+        GMM_GFX_ADDRESS addr = GMM_GBYTE(4) + Offset;
+        ASSERT_EQ(Walk(mgr[0], addr), Walk(mgr[1], addr)) << "Offset 0x" << std::hex << Offset;
+    }
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr[0]);
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr[1]);
+    delete surfB;
+    delete surfA;
+}
+
+TEST_F(CTestAuxTable, DISABLED_BenchmarkUpdateAuxTablesBulk)
+{
+    const int NumSurf = 4096;
+
+    Surface *surf = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GMM_UMD_SYNCCONTEXT UmdContext = {0};
+    UmdContext.pCommandQueueHandle = (void *)0xdeadbeef;
+
+    GMM_DDI_UPDATEAUXTABLE *updateReqs = new GMM_DDI_UPDATEAUXTABLE[NumSurf];
+
+    // Surfaces 4MB apart (tables only, surface memory isn't touched), requested in scattered VA order
+    for(int i = 0; i < NumSurf; i++)
+    {
+        memset(&updateReqs[i], 0, sizeof(updateReqs[i]));
+        updateReqs[i].UmdContext  = &UmdContext;
+        updateReqs[i].BaseResInfo = surf->getGMMResourceInfo();
+        updateReqs[i].BaseGpuVA   = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)((i * 2731) % NumSurf) * GMM_MBYTE(4);
+        updateReqs[i].Map         = 1;
+    }
+
+    for(int Bulk = 0; Bulk <= 1; Bulk++)
+    {
+        GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+        ASSERT_TRUE(mgr != NULL);
+
+        mgr->TTCb.pfPrologTranslationTable = CTestAuxTable::prologTranslationTableCB;
+        mgr->TTCb.pfWriteL1Entries         = CTestAuxTable::writeL1EntriesCB;
+        mgr->TTCb.pfWriteL2L3Entry         = CTestAuxTable::writeL2L3EntryCB;
+        mgr->TTCb.pfEpilogTranslationTable = CTestAuxTable::epilogTranslationTableCB;
+        mgr->SetAuxMapGpuUpdate(1);
+        mgr->SetAtomicL1EntriesWrite(1);
+
+        memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+
+        auto Start = std::chrono::steady_clock::now();
+
+        if(Bulk)
+        {
+            EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTables(updateReqs, NumSurf, NULL));
+        }
+        else
+        {
+            for(int i = 0; i < NumSurf; i++)
+            {
+                EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReqs[i]));
+            }
+        }
+
+        auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+
+        printf("%-10s %d surfaces: %lld us, Prolog/Epilog=%llu/%llu Callbacks=%llu\n", Bulk ? "bulk" : "per-call", NumSurf,
+               (long long)Elapsed, (unsigned long long)TTWriteStats.NumProlog, (unsigned long long)TTWriteStats.NumEpilog,
+               (unsigned long long)(TTWriteStats.NumWriteL1Entries + TTWriteStats.NumWriteL2L3Entry));
+
+        pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    }
+
+    delete[] updateReqs;
+    delete surf;
+}
+
+TEST_F(CTestAuxTable, TestAuxTableDeferredInvalidate)
+{
+    const int NumSurf = 8;
+
+    Surface *surf = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+
+    mgr->TTCb.pfPrologTranslationTable = CTestAuxTable::prologTranslationTableCB;
+    mgr->TTCb.pfWriteL1Entries         = CTestAuxTable::writeL1EntriesCB;
+    mgr->TTCb.pfWriteL2L3Entry         = CTestAuxTable::writeL2L3EntryCB;
+    mgr->TTCb.pfEpilogTranslationTable = CTestAuxTable::epilogTranslationTableCB;
+    mgr->SetAuxMapGpuUpdate(1);
+    mgr->SetAtomicL1EntriesWrite(1);
+
+    GMM_UMD_SYNCCONTEXT UmdContext = {0};
+    UmdContext.pCommandQueueHandle = (void *)0xdeadbeef;
+
+    GMM_DDI_UPDATEAUXTABLE updateReqs[NumSurf];
+    GMM_GFX_ADDRESS        auxOffset = surf->getAuxGfxAddress(GMM_AUX_CCS) - surf->getGfxAddress(GMM_PLANE_Y);
+
+    // Each surface in its own L1 table (tables only, surface memory isn't touched)
+    for(int i = 0; i < NumSurf; i++)
+    {
+        memset(&updateReqs[i], 0, sizeof(updateReqs[i]));
+        updateReqs[i].UmdContext  = &UmdContext;
+        updateReqs[i].BaseResInfo = surf->getGMMResourceInfo();
+        updateReqs[i].BaseGpuVA   = GMM_GBYTE(4) + i * GMM_MBYTE(32);
+        updateReqs[i].Map         = 1;
+    }
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTables(updateReqs, NumSurf, NULL));
+
+    mgr->SetDeferredAuxInvalidation(1);
+
+    // Unmaps are queued, tables untouched
+    memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+    for(int i = 0; i < NumSurf; i++)
+    {
+        updateReqs[i].Map = 0;
+        EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReqs[i]));
+    }
+    EXPECT_EQ(0u, TTWriteStats.NumWriteL1Entries + TTWriteStats.NumWriteL2L3Entry);
+    EXPECT_EQ((uint32_t)NumSurf, mgr->GetNumPendingAuxInvalidations());
+
+    // Re-queued and adjacent unmaps merge with pending ranges
+    GMM_GFX_SIZE_T Size = surf->getGMMResourceInfo()->GetSizeMainSurface();
+    EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReqs[3]));
+    updateReqs[2].BaseGpuVA += Size;
+    EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReqs[2]));
+    updateReqs[2].BaseGpuVA -= Size;
+    EXPECT_EQ((uint32_t)NumSurf, mgr->GetNumPendingAuxInvalidations());
+
+    // Remap of VA pending invalidation drops it from queue
+    updateReqs[0].Map = 1;
+    EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReqs[0]));
+    EXPECT_EQ((uint32_t)NumSurf - 1, mgr->GetNumPendingAuxInvalidations());
+
+    for(int i = 1; i < NumSurf; i++)
+    {
+        EXPECT_TRUE(Walker(updateReqs[i].BaseGpuVA, updateReqs[i].BaseGpuVA + auxOffset, mgr->GetAuxL3TableAddr()).l2Valid(updateReqs[i].BaseGpuVA));
+    }
+
+    memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+    EXPECT_EQ(GMM_SUCCESS, mgr->FlushAuxTableInvalidations(&UmdContext, 0));
+    EXPECT_EQ(1u, TTWriteStats.NumProlog);
+    EXPECT_EQ(1u, TTWriteStats.NumEpilog);
+    EXPECT_EQ(0u, mgr->GetNumPendingAuxInvalidations());
+
+    // Unmapped surfaces lost their L1 tables, remapped one is intact
+    for(int i = 1; i < NumSurf; i++)
+    {
+        EXPECT_FALSE(Walker(updateReqs[i].BaseGpuVA, updateReqs[i].BaseGpuVA + auxOffset, mgr->GetAuxL3TableAddr()).l2Valid(updateReqs[i].BaseGpuVA));
+    }
+
+    Walker walker(updateReqs[0].BaseGpuVA, updateReqs[0].BaseGpuVA + auxOffset, mgr->GetAuxL3TableAddr());
+    for(size_t j = 0; j < surf->getSurfaceSize(GMM_PLANE_Y); j += GMM_KBYTE(64))
+    {
+        GMM_GFX_ADDRESS addr = updateReqs[0].BaseGpuVA + j;
+        ASSERT_EQ(walker.expected(addr), walker.walk(addr));
+    }
+
+    // Nothing pending, flush is a no-op
+    memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+    EXPECT_EQ(GMM_SUCCESS, mgr->FlushAuxTableInvalidations(&UmdContext, 0));
+    EXPECT_EQ(0u, TTWriteStats.NumProlog);
+
+    // Disabled, unmap invalidates immediately
+    mgr->SetDeferredAuxInvalidation(0);
+    updateReqs[0].Map = 0;
+    EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReqs[0]));
+    EXPECT_EQ(0u, mgr->GetNumPendingAuxInvalidations());
+    EXPECT_FALSE(walker.l2Valid(updateReqs[0].BaseGpuVA));
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    delete surf;
+}
+
+TEST_F(CTestAuxTable, DISABLED_BenchmarkAuxTableDeferredInvalidate)
+{
+    const int NumSurf = 4096;
+    const int Passes  = 8;
+
+    Surface *surf = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GMM_UMD_SYNCCONTEXT UmdContext = {0};
+    UmdContext.pCommandQueueHandle = (void *)0xdeadbeef;
+
+    GMM_DDI_UPDATEAUXTABLE *updateReqs = new GMM_DDI_UPDATEAUXTABLE[NumSurf];
+    GMM_GFX_SIZE_T          Stride     = GFX_ALIGN(surf->getGMMResourceInfo()->GetSizeMainSurface(), GMM_KBYTE(64));
+
+    // Short-lived surfaces packed back-to-back, churned (map all, unmap all) each pass
+    for(int i = 0; i < NumSurf; i++)
+    {
+        memset(&updateReqs[i], 0, sizeof(updateReqs[i]));
+        updateReqs[i].UmdContext  = &UmdContext;
+        updateReqs[i].BaseResInfo = surf->getGMMResourceInfo();
+        updateReqs[i].BaseGpuVA   = GMM_GBYTE(4) + i * Stride;
+    }
+
+    for(int Deferred = 0; Deferred <= 1; Deferred++)
+    {
+        GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+        ASSERT_TRUE(mgr != NULL);
+
+        mgr->TTCb.pfPrologTranslationTable = CTestAuxTable::prologTranslationTableCB;
+        mgr->TTCb.pfWriteL1Entries         = CTestAuxTable::writeL1EntriesCB;
+        mgr->TTCb.pfWriteL2L3Entry         = CTestAuxTable::writeL2L3EntryCB;
+        mgr->TTCb.pfEpilogTranslationTable = CTestAuxTable::epilogTranslationTableCB;
+        mgr->SetAuxMapGpuUpdate(1);
+        mgr->SetAtomicL1EntriesWrite(1);
+        mgr->SetDeferredAuxInvalidation(Deferred);
+
+        long long MapTime = 0, UnmapTime = 0;
+
+        memset(&TTWriteStats, 0, sizeof(TTWriteStats));
+
+        for(int Pass = 0; Pass < Passes; Pass++)
+        {
+            auto Start = std::chrono::steady_clock::now();
+            for(int i = 0; i < NumSurf; i++)
+            {
+                updateReqs[i].Map = 1;
+                EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReqs[i]));
+            }
+            auto Mid = std::chrono::steady_clock::now();
+            for(int i = 0; i < NumSurf; i++)
+            {
+                updateReqs[i].Map = 0;
+                EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReqs[i]));
+            }
+            EXPECT_EQ(GMM_SUCCESS, mgr->FlushAuxTableInvalidations(&UmdContext, 0));
+            auto End = std::chrono::steady_clock::now();
+
+            MapTime += std::chrono::duration_cast<std::chrono::microseconds>(Mid - Start).count();
+            UnmapTime += std::chrono::duration_cast<std::chrono::microseconds>(End - Mid).count();
+        }
+
+        printf("%-10s %d surfaces x %d passes: map %lld us, unmap+flush %lld us, Callbacks=%llu\n", Deferred ? "deferred" : "immediate",
+               NumSurf, Passes, MapTime, UnmapTime,
+               (unsigned long long)(TTWriteStats.NumWriteL1Entries + TTWriteStats.NumWriteL2L3Entry));
+
+        pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    }
+
+    delete[] updateReqs;
+    delete surf;
+}
+
+TEST_F(CTestAuxTable, TestAuxTableLargeSurfaceCpuUpdate)
+{
+    Surface *surf = new Surface(4096, 4096);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+
+    // Start mid L1 table, surface spans several L1 tables (tables only, surface memory isn't touched)
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+    updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+    updateReq.BaseGpuVA              = GMM_GBYTE(4) + GMM_MBYTE(5);
+    updateReq.Map                    = 1;
+    updateReq.DoNotWait              = 1;
+
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+
+    for(int plane = 0; plane < 2; plane++)
+    {
+        GMM_YUV_PLANE   Plane   = plane ? GMM_PLANE_U : GMM_PLANE_Y;
+        GMM_GFX_ADDRESS MainVA  = updateReq.BaseGpuVA + surf->getGfxAddress(Plane) - surf->getGfxAddress(GMM_PLANE_Y);
+        GMM_GFX_ADDRESS AuxVA   = updateReq.BaseGpuVA + surf->getAuxGfxAddress(plane ? GMM_AUX_UV_CCS : GMM_AUX_CCS) - surf->getGfxAddress(GMM_PLANE_Y);
+        Walker          walker(MainVA, AuxVA, mgr->GetAuxL3TableAddr());
+
+        for(size_t j = 0; j < surf->getSurfaceSize(Plane); j += GMM_KBYTE(64))
+        {
+            ASSERT_EQ(walker.expected(MainVA + j), walker.walk(MainVA + j));
+        }
+    }
+
+    // Unmap releases every L1 table, ie usage was tracked for all entries
+    updateReq.Map = 0;
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+
+    Walker walker(updateReq.BaseGpuVA, 0, mgr->GetAuxL3TableAddr());
+    for(size_t j = 0; j < surf->getGMMResourceInfo()->GetSizeMainSurface(); j += GMM_MBYTE(16))
+    {
+        EXPECT_FALSE(walker.l2Valid(updateReq.BaseGpuVA + j));
+    }
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    delete surf;
+}
+
+TEST_F(CTestAuxTable, DISABLED_BenchmarkAuxTableLargeSurfaceCpuUpdate)
+{
+    const unsigned int Heights[] = {12288, 16384, 32768};
+    const int          Passes    = 8;
+
+    for(unsigned int h = 0; h < sizeof(Heights) / sizeof(Heights[0]); h++)
+    {
+        // 16K-wide NV12, 288MB..768MB main surface (tables only, surface memory isn't touched)
+        Surface *surf = new Surface(16384, Heights[h]);
+
+        ASSERT_TRUE(surf != NULL && surf->init());
+
+        GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+        ASSERT_TRUE(mgr != NULL);
+
+        GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+        updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+        updateReq.BaseGpuVA              = GMM_GBYTE(4);
+        updateReq.DoNotWait              = 1;
+
+        long long MapTime = 0;
+
+        for(int Pass = 0; Pass < Passes; Pass++)
+        {
+            updateReq.Map = 1;
+
+            auto Start = std::chrono::steady_clock::now();
+            EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+            MapTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+
+            updateReq.Map = 0;
+            EXPECT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+        }
+
+        GMM_GFX_SIZE_T Size = surf->getGMMResourceInfo()->GetSizeMainSurface();
+        printf("%4llu MB surface: map %lld us/pass, %.1f GB/s\n", (unsigned long long)(Size >> 20), MapTime / Passes,
+               MapTime ? ((double)Size * Passes / 1e3) / MapTime : 0.0);
+
+        pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+        delete surf;
+    }
+}
+
+// Per-chunk CCS cacheline derivation (AuxTable::__GetCCSCacheline), reference for non-linear CCS mappings
+static GMM_GFX_ADDRESS AuxTTCCSCacheline(GMM_RESOURCE_INFO *ResInfo, GMM_GFX_ADDRESS AuxVA, GMM_GFX_SIZE_T AdrOffset)
+{
+    uint32_t i = 0, j = 0;
+    uint32_t PitchInTiles = ResInfo->GetRenderPitchTiles();
+
+    AdrOffset >>= 14;
+    if(ResInfo->GetResFlags().Info.TiledYf)
+    {
+        i = static_cast<uint32_t>(AdrOffset % (PitchInTiles / 4));
+        j = static_cast<uint32_t>(AdrOffset / (PitchInTiles / 4));
+    }
+    else if(PitchInTiles != 0)
+    {
+        uint32_t x = static_cast<uint32_t>(AdrOffset >> 2);
+        i          = 2 * (x % PitchInTiles) + ((AdrOffset % 4) >> 1);
+        j          = 2 * (x / PitchInTiles) + (AdrOffset % 2);
+    }
+
+    return AuxVA + ((i / 8 + (j / 8) * ResInfo->GetRenderAuxPitchTiles()) * GMM_KBYTE(4)) + (8 * GMM_BYTES(64) * (i % 8)) + (GMM_BYTES(64) * (j % 8));
+}
+
+TEST_F(CTestAuxTable, TestAuxTableCCSIteratorRandomGeometry)
+{
+    const GMM_RESOURCE_FORMAT Formats[] = {GMM_FORMAT_R8G8B8A8_UNORM, GMM_FORMAT_R16G16B16A16_FLOAT, GMM_FORMAT_R32_FLOAT, GMM_FORMAT_R8_UNORM};
+    const int                 NumRes    = 48;
+
+    // Non-linear CCS at 16K granularity, CCS cacheline derived per chunk
+    SKU_FEATURE_TABLE &Sku    = const_cast<SKU_FEATURE_TABLE &>(pGmmULTClientContext->GetLibContext()->GetSkuTable());
+    WA_TABLE &         LibWa  = const_cast<WA_TABLE &>(pGmmULTClientContext->GetLibContext()->GetWaTable());
+    WA_TABLE           SaveWa = LibWa;
+    bool               SaveLinearCCS = Sku.FtrLinearCCS;
+
+    Sku.FtrLinearCCS                                = 0;
+    LibWa.WaAuxTable16KGranular                     = 1;
+    LibWa.WaAuxTable64KGranular                     = 0;
+    pGfxAdapterInfo->WaTable.WaAuxTable16KGranular = 1;
+    pGfxAdapterInfo->WaTable.WaAuxTable64KGranular = 0;
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(&DeviceCBInt, TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+
+    srand(0x5eed);
+
+    int Checked = 0;
+    for(int n = 0; n < NumRes; n++)
+    {
+        GMM_RESCREATE_PARAMS gmmParams        = {};
+        gmmParams.Type                        = RESOURCE_2D;
+        gmmParams.Format                      = Formats[rand() % (sizeof(Formats) / sizeof(Formats[0]))];
+        gmmParams.BaseWidth64                 = 1 + rand() % 4096;
+        gmmParams.BaseHeight                  = 1 + rand() % 2048;
+        gmmParams.Depth                       = 0x1;
+        gmmParams.ArraySize                   = 1;
+        gmmParams.Flags.Info.RenderCompressed = 1;
+        gmmParams.Flags.Gpu.CCS               = 1;
+        gmmParams.Flags.Gpu.UnifiedAuxSurface = 1;
+        gmmParams.Flags.Gpu.RenderTarget      = 1;
+        gmmParams.Flags.Gpu.Texture           = 1;
+        gmmParams.Flags.Info.TiledY           = 1;
+        gmmParams.Flags.Info.TiledYf          = (n & 1) ? 0 : 1;
+        gmmParams.Flags.Info.TiledYs          = (n & 1) ? 1 : 0;
+
+        GMM_RESOURCE_INFO *ResInfo = pGmmULTClientContext->CreateResInfoObject(&gmmParams);
+        if(!ResInfo)
+        {
+            continue;
+        }
+        if(ResInfo->GetResFlags().Info.TiledYf && ResInfo->GetRenderPitchTiles() < 4)
+        {
+            pGmmULTClientContext->DestroyResInfoObject(ResInfo);
+            continue;
+        }
+
+        GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+        updateReq.BaseResInfo            = ResInfo;
+        updateReq.BaseGpuVA              = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)n * GMM_MBYTE(64);
+        updateReq.Map                    = 1;
+        updateReq.DoNotWait              = 1;
+
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+
+        GMM_GFX_ADDRESS AuxVA  = updateReq.BaseGpuVA + ResInfo->GetUnifiedAuxSurfaceOffset(GMM_AUX_CCS);
+        Walker          walker(updateReq.BaseGpuVA, AuxVA, mgr->GetAuxL3TableAddr());
+
+        for(GMM_GFX_SIZE_T Offset = 0; Offset < ResInfo->GetSizeMainSurface(); Offset += GMM_KBYTE(16))
+        {
+            ASSERT_EQ(AuxTTCCSCacheline(ResInfo, AuxVA, Offset) & 0x0000ffffffffffc0, walker.walk(updateReq.BaseGpuVA + Offset))
+            << "Res " << n << " Offset 0x" << std::hex << Offset;
+        }
+
+        updateReq.Map = 0;
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+
+        pGmmULTClientContext->DestroyResInfoObject(ResInfo);
+        Checked++;
+    }
+    EXPECT_EQ(NumRes, Checked);
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+
+    Sku.FtrLinearCCS = SaveLinearCCS;
+    LibWa            = SaveWa;
+    pGfxAdapterInfo->WaTable.WaAuxTable16KGranular = SaveWa.WaAuxTable16KGranular;
+    pGfxAdapterInfo->WaTable.WaAuxTable64KGranular = SaveWa.WaAuxTable64KGranular;
+}
+
+TEST_F(CTestAuxTable, TestAuxTableFakeDevice)
+{
+    const int NumSurf = 16;
+
+    FakeDevice dev;
+    Surface *  surf = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+    dev.attach(mgr);
+
+    // Root table allocated up-front
+    EXPECT_EQ(1u, dev.Stats.NumAlloc);
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+    updateReq.UmdContext             = dev.getUmdContext();
+    updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+
+    for(int i = 0; i < NumSurf; i++)
+    {
+        updateReq.BaseGpuVA = GMM_GBYTE(4) + i * GMM_MBYTE(16);
+        updateReq.Map       = 1;
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    }
+
+    // One submission per request, each advancing fence timeline
+    EXPECT_EQ((uint64_t)NumSurf, dev.Stats.NumSubmit);
+    EXPECT_EQ((uint64_t)NumSurf, dev.getUmdContext()->BBLastFence);
+    EXPECT_GT(dev.Stats.NumAlloc, 1u);
+    EXPECT_GT(dev.Stats.NumWriteL1Entries, 0u);
+    EXPECT_FALSE(dev.getCommands().empty());
+
+    GMM_GFX_ADDRESS auxOffset = surf->getAuxGfxAddress(GMM_AUX_CCS) - surf->getGfxAddress(GMM_PLANE_Y);
+    for(int i = 0; i < NumSurf; i++)
+    {
+        GMM_GFX_ADDRESS BaseVA = GMM_GBYTE(4) + i * GMM_MBYTE(16);
+        Walker          walker(BaseVA, BaseVA + auxOffset, mgr->GetAuxL3TableAddr());
+
+        for(size_t j = 0; j < surf->getSurfaceSize(GMM_PLANE_Y); j += GMM_KBYTE(64))
+        {
+            ASSERT_EQ(walker.expected(BaseVA + j), walker.walk(BaseVA + j));
+        }
+    }
+
+    for(int i = 0; i < NumSurf; i++)
+    {
+        updateReq.BaseGpuVA = GMM_GBYTE(4) + i * GMM_MBYTE(16);
+        updateReq.Map       = 0;
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    }
+
+    // All page-table BOs released with manager
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    EXPECT_EQ(dev.Stats.NumAlloc, dev.Stats.NumFree);
+    EXPECT_EQ(0u, dev.Stats.LiveBytes);
+
+    delete surf;
+}
+
+// Maps Cpu-update by default even with cmdQ and callbacks, Gpu-update is opt-in
+TEST_F(CTestAuxTable, TestAuxTableMapCpuUpdateDefault)
+{
+    FakeDevice dev;
+    Surface *  surf = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+    dev.attach(mgr);
+    mgr->SetAuxMapGpuUpdate(0);
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+    updateReq.UmdContext             = dev.getUmdContext();
+    updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+    updateReq.BaseGpuVA              = GMM_GBYTE(4);
+    updateReq.Map                    = 1;
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+
+    EXPECT_EQ(0u, dev.Stats.NumSubmit);
+    EXPECT_EQ(0u, dev.Stats.NumWriteL1Entries);
+    EXPECT_EQ(0u, dev.Stats.NumWriteL2L3Entry);
+
+    GMM_GFX_ADDRESS auxOffset = surf->getAuxGfxAddress(GMM_AUX_CCS) - surf->getGfxAddress(GMM_PLANE_Y);
+    Walker          walker(updateReq.BaseGpuVA, updateReq.BaseGpuVA + auxOffset, mgr->GetAuxL3TableAddr());
+    for(size_t j = 0; j < surf->getSurfaceSize(GMM_PLANE_Y); j += GMM_KBYTE(64))
+    {
+        ASSERT_EQ(walker.expected(updateReq.BaseGpuVA + j), walker.walk(updateReq.BaseGpuVA + j));
+    }
+
+    // Opted in, next map goes through the cmdQ
+    mgr->SetAuxMapGpuUpdate(1);
+    updateReq.BaseGpuVA = GMM_GBYTE(4) + GMM_MBYTE(16);
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    EXPECT_EQ(1u, dev.Stats.NumSubmit);
+    EXPECT_GT(dev.Stats.NumWriteL1Entries, 0u);
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    delete surf;
+}
+
+TEST_F(CTestAuxTable, TestAuxTablePoolReclaim)
+{
+    // Enough scattered L1 tables to leave unused pools over 16MB residency limit
+    const uint32_t L1TablesPerPool = 256; // 2MB pool of 8KB L1 tables
+    const uint32_t NumSurf         = 12 * L1TablesPerPool;
+
+    FakeDevice dev;
+    Surface *  surf = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+    dev.attach(mgr);
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+    updateReq.UmdContext             = dev.getUmdContext();
+    updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+
+    for(int Map = 1; Map >= 0; Map--)
+    {
+        for(uint32_t i = 0; i < NumSurf; i++)
+        {
+            updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+            updateReq.Map       = Map;
+            ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+        }
+    }
+
+    // Unmap retired unused pools without waiting on Gpu, which hasn't completed any submission
+    uint32_t NumRetired = mgr->GetNumRetiredPools();
+    uint64_t NumAlloc   = dev.Stats.NumAlloc;
+    EXPECT_GT(NumRetired, 0u);
+    EXPECT_EQ(0u, dev.Stats.NumCpuWait);
+    EXPECT_EQ(0u, dev.Stats.NumFree);
+    EXPECT_EQ(0u, mgr->ReclaimPools(dev.getUmdContext()->BBFenceObj, dev.getCompletedFence()));
+
+    // Retired pools reused instead of new allocation, once resident unused pools fill up
+    updateReq.Map = 1;
+    for(uint32_t i = 0; i < 10 * L1TablesPerPool; i++)
+    {
+        updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    }
+    EXPECT_EQ(NumAlloc, dev.Stats.NumAlloc);
+    EXPECT_LT(mgr->GetNumRetiredPools(), NumRetired);
+    NumRetired = mgr->GetNumRetiredPools();
+
+    // Freed once fence is observed complete, still no Cpu wait
+    dev.retire();
+    EXPECT_EQ(NumRetired, mgr->ReclaimPools(dev.getUmdContext()->BBFenceObj, dev.getCompletedFence()));
+    EXPECT_EQ(0u, mgr->GetNumRetiredPools());
+    EXPECT_EQ((uint64_t)NumRetired, dev.Stats.NumFree);
+    EXPECT_EQ(0u, dev.Stats.NumCpuWait);
+
+    updateReq.Map = 0;
+    for(uint32_t i = 0; i < 10 * L1TablesPerPool; i++)
+    {
+        updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    }
+
+    // Explicit reclaim frees remaining retired pools, waiting for idle
+    NumRetired = mgr->GetNumRetiredPools();
+    EXPECT_EQ(NumRetired, mgr->ReclaimPools());
+    EXPECT_EQ((uint64_t)NumRetired, dev.Stats.NumCpuWait);
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    EXPECT_EQ(dev.Stats.NumAlloc, dev.Stats.NumFree);
+    EXPECT_EQ(0u, dev.Stats.LiveBytes);
+
+    delete surf;
+}
+
+TEST_F(CTestAuxTable, TestAuxTablePoolCompaction)
+{
+    const uint32_t NumSurf = 1024;
+    const uint32_t Keep    = 8; // every 8th surface stays mapped
+
+    FakeDevice              dev;
+    GMM_PAGETABLE_MGR_STATS Stats = {0};
+    Surface *               surf  = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+    dev.attach(mgr);
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+    updateReq.UmdContext             = dev.getUmdContext();
+    updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+    updateReq.Map                    = 1;
+
+    // Light usage gets small L2 and L1 pools
+    updateReq.BaseGpuVA = GMM_GBYTE(4);
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    mgr->GetStats(&Stats, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+    EXPECT_EQ(2u, Stats.NumPools[POOL_TYPE_AUXTTL1] + Stats.NumPools[POOL_TYPE_AUXTTL2]);
+    EXPECT_EQ(2 * GMM_KBYTE(256), Stats.PoolSize);
+
+    // One L1 table per surface, pools grow with use
+    for(uint32_t i = 1; i < NumSurf; i++)
+    {
+        updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    }
+
+    updateReq.Map = 0;
+    for(uint32_t i = 0; i < NumSurf; i++)
+    {
+        if(i % Keep)
+        {
+            updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+            ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+        }
+    }
+
+    GMM_PAGETABLE_MGR_STATS Before = {0};
+    mgr->GetStats(&Before, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+    EXPECT_GT(Before.NumSparsePools, 0u);
+    EXPECT_GT(Before.FragmentedSize, 0u);
+
+    // Nothing moves while tables have Gpu-updates in flight
+    uint32_t NumEmptied = 0;
+    EXPECT_EQ(GMM_SUCCESS, mgr->CompactPools(dev.getUmdContext(), 0, dev.getCompletedFence(), &NumEmptied));
+    EXPECT_EQ(0u, NumEmptied);
+
+    dev.retire();
+    uint64_t NumSubmit = dev.Stats.NumSubmit;
+    EXPECT_EQ(GMM_SUCCESS, mgr->CompactPools(dev.getUmdContext(), 0, dev.getCompletedFence(), &NumEmptied));
+    EXPECT_GT(NumEmptied, 0u);
+    EXPECT_EQ(NumSubmit + 1, dev.Stats.NumSubmit);
+
+    mgr->GetStats(&Stats, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+    EXPECT_LT(Stats.NumSparsePools, Before.NumSparsePools);
+    EXPECT_LT(Stats.FragmentedSize, Before.FragmentedSize);
+    EXPECT_EQ(Before.UsedSize, Stats.UsedSize);
+    EXPECT_EQ(NumEmptied, Stats.NumRetiredPools);
+
+    // Moved tables still translate
+    GMM_GFX_ADDRESS auxOffset = surf->getAuxGfxAddress(GMM_AUX_CCS) - surf->getGfxAddress(GMM_PLANE_Y);
+    for(uint32_t i = 0; i < NumSurf; i += Keep)
+    {
+        GMM_GFX_ADDRESS BaseVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+        Walker          walker(BaseVA, BaseVA + auxOffset, mgr->GetAuxL3TableAddr());
+
+        for(size_t j = 0; j < surf->getSurfaceSize(GMM_PLANE_Y); j += GMM_KBYTE(64))
+        {
+            ASSERT_EQ(walker.expected(BaseVA + j), walker.walk(BaseVA + j));
+        }
+    }
+
+    // Emptied pools freed once compaction BB completes
+    EXPECT_EQ(0u, mgr->ReclaimPools(dev.getUmdContext()->BBFenceObj, dev.getCompletedFence()));
+    dev.retire();
+    EXPECT_EQ(NumEmptied, mgr->ReclaimPools(dev.getUmdContext()->BBFenceObj, dev.getCompletedFence()));
+
+    for(uint32_t i = 0; i < NumSurf; i += Keep)
+    {
+        updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    }
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    EXPECT_EQ(dev.Stats.NumAlloc, dev.Stats.NumFree);
+    EXPECT_EQ(0u, dev.Stats.LiveBytes);
+
+    delete surf;
+}
+
+// Compaction with free nodes whose previous use has Gpu-updates in flight: Gpu-update copies
+// tables into them behind those updates, CPU update leaves them unused
+TEST_F(CTestAuxTable, TestAuxTablePoolCompactionPendingNodes)
+{
+    const uint32_t NumSurf = 1024;
+    const uint32_t Keep    = 8; // every 8th surface stays mapped
+    const uint32_t NumBusy = 64; // surfaces re-mapped/unmapped without retiring
+
+    Surface *surf = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GMM_GFX_ADDRESS auxOffset = surf->getAuxGfxAddress(GMM_AUX_CCS) - surf->getGfxAddress(GMM_PLANE_Y);
+
+    for(uint8_t DoNotWait = 0; DoNotWait <= 1; DoNotWait++)
+    {
+        FakeDevice       dev;
+        GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+
+        ASSERT_TRUE(mgr != NULL);
+        dev.attach(mgr);
+
+        GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+        updateReq.UmdContext             = dev.getUmdContext();
+        updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+
+        updateReq.Map = 1;
+        for(uint32_t i = 0; i < NumSurf; i++)
+        {
+            updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+            ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+        }
+
+        updateReq.Map = 0;
+        for(uint32_t i = 0; i < NumSurf; i++)
+        {
+            if(i % Keep)
+            {
+                updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+                ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+            }
+        }
+        dev.retire();
+
+        // Lowest free nodes get Gpu-updates the compaction fence doesn't cover
+        for(updateReq.Map = 1;; updateReq.Map = 0)
+        {
+            for(uint32_t i = 0; i < NumBusy; i++)
+            {
+                updateReq.BaseGpuVA = GMM_GBYTE(512) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+                ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+            }
+            if(!updateReq.Map)
+            {
+                break;
+            }
+        }
+
+        uint64_t NumWriteL1Entries = dev.Stats.NumWriteL1Entries;
+        uint32_t NumEmptied        = 0;
+        EXPECT_EQ(GMM_SUCCESS, mgr->CompactPools(dev.getUmdContext(), DoNotWait, dev.getCompletedFence(), &NumEmptied));
+        EXPECT_GT(NumEmptied, 0u);
+        if(DoNotWait)
+        {
+            EXPECT_EQ(NumWriteL1Entries, dev.Stats.NumWriteL1Entries);
+        }
+        else
+        {
+            EXPECT_GT(dev.Stats.NumWriteL1Entries, NumWriteL1Entries);
+        }
+
+        // Moved tables still translate once in-flight updates land
+        dev.retire();
+        for(uint32_t i = 0; i < NumSurf; i += Keep)
+        {
+            GMM_GFX_ADDRESS BaseVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+            Walker          walker(BaseVA, BaseVA + auxOffset, mgr->GetAuxL3TableAddr());
+
+            for(size_t j = 0; j < surf->getSurfaceSize(GMM_PLANE_Y); j += GMM_KBYTE(64))
+            {
+                ASSERT_EQ(walker.expected(BaseVA + j), walker.walk(BaseVA + j));
+            }
+        }
+
+        // Hw may walk emptied pools until next BB lands, on CPU update too
+        if(DoNotWait)
+        {
+            EXPECT_EQ(0u, mgr->ReclaimPools(dev.getUmdContext()->BBFenceObj, dev.getCompletedFence()));
+            updateReq.Map       = 1;
+            updateReq.BaseGpuVA = GMM_GBYTE(512);
+            ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+            dev.retire();
+        }
+        EXPECT_EQ(NumEmptied, mgr->ReclaimPools(dev.getUmdContext()->BBFenceObj, dev.getCompletedFence()));
+
+        pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+        EXPECT_EQ(dev.Stats.NumAlloc, dev.Stats.NumFree);
+    }
+
+    delete surf;
+}
+
+// Applies BO list changes to client's list, idempotently
+static void AuxTTApplyBOChanges(std::vector<HANDLE> &BOList, GMM_PAGETABLE_BO_CHANGE *Changes, int NumChanges)
+{
+    for(int i = 0; i < NumChanges; i++)
+    {
+        std::vector<HANDLE>::iterator it = std::find(BOList.begin(), BOList.end(), Changes[i].bo);
+
+        if(Changes[i].Added && it == BOList.end())
+        {
+            BOList.push_back(Changes[i].bo);
+        }
+        else if(!Changes[i].Added && it != BOList.end())
+        {
+            BOList.erase(it);
+        }
+    }
+}
+
+static std::vector<HANDLE> AuxTTGetBOList(GmmPageTableMgr *mgr)
+{
+    std::vector<HANDLE> BOList(mgr->GetNumOfPageTableBOs(AUXTT));
+
+    BOList.resize(mgr->GetPageTableBOList(AUXTT, BOList.data()));
+    std::sort(BOList.begin(), BOList.end());
+    return BOList;
+}
+
+TEST_F(CTestAuxTable, TestAuxTableBOListChanges)
+{
+    const uint32_t L1TablesPerPool = 256; // 2MB pool of 8KB L1 tables
+    const uint32_t NumSurf         = 12 * L1TablesPerPool;
+
+    FakeDevice              dev;
+    GMM_PAGETABLE_BO_CHANGE Changes[GMM_PAGETABLE_BO_CHANGE_LOG_SIZE];
+    uint32_t                Gen = 0, NewGen = 0;
+    Surface *               surf = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+    dev.attach(mgr);
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+    updateReq.UmdContext             = dev.getUmdContext();
+    updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+
+    Gen                          = mgr->GetPageTableBOGeneration(AUXTT);
+    std::vector<HANDLE> ClientBO = AuxTTGetBOList(mgr);
+
+    // Unchanged list
+    EXPECT_EQ(0, mgr->GetPageTableBOChanges(AUXTT, Gen, Changes, GMM_PAGETABLE_BO_CHANGE_LOG_SIZE, &NewGen));
+    EXPECT_EQ(Gen, NewGen);
+
+    // Pools added/retired by map/unmap, client list tracked incrementally
+    for(int Map = 1; Map >= 0; Map--)
+    {
+        updateReq.Map = Map;
+        for(uint32_t i = 0; i < NumSurf; i++)
+        {
+            updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+            ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+
+            if(i % L1TablesPerPool == 0)
+            {
+                int NumChanges = mgr->GetPageTableBOChanges(AUXTT, Gen, Changes, GMM_PAGETABLE_BO_CHANGE_LOG_SIZE, &NewGen);
+
+                ASSERT_GE(NumChanges, 0);
+                EXPECT_EQ((uint32_t)NumChanges, NewGen - Gen);
+                AuxTTApplyBOChanges(ClientBO, Changes, NumChanges);
+                Gen = NewGen;
+
+                std::sort(ClientBO.begin(), ClientBO.end());
+                ASSERT_EQ(AuxTTGetBOList(mgr), ClientBO);
+            }
+        }
+    }
+
+    int NumChanges = mgr->GetPageTableBOChanges(AUXTT, Gen, Changes, GMM_PAGETABLE_BO_CHANGE_LOG_SIZE, &NewGen);
+    ASSERT_GE(NumChanges, 0);
+    AuxTTApplyBOChanges(ClientBO, Changes, NumChanges);
+    std::sort(ClientBO.begin(), ClientBO.end());
+    EXPECT_EQ(AuxTTGetBOList(mgr), ClientBO);
+    EXPECT_GT(mgr->GetNumRetiredPools(), 0u);
+
+    // Client too far behind (or with too small array) rebuilds full list
+    EXPECT_EQ(-1, mgr->GetPageTableBOChanges(AUXTT, NewGen - GMM_PAGETABLE_BO_CHANGE_LOG_SIZE - 1, Changes, GMM_PAGETABLE_BO_CHANGE_LOG_SIZE, &NewGen));
+    EXPECT_EQ(-1, mgr->GetPageTableBOChanges(AUXTT, 0, Changes, 0, &NewGen));
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    delete surf;
+}
+
+TEST_F(CTestAuxTable, TestAuxTableIdempotentMap)
+{
+    FakeDevice          dev;
+    GMM_PAGETABLE_MGR_STATS Stats = {0};
+    Surface *               surf  = new Surface(1280, 720);
+    Surface *               surf2 = new Surface(1920, 1080); // CCS at different offset
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+    ASSERT_TRUE(surf2 != NULL && surf2->init());
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+    dev.attach(mgr);
+
+    const GMM_GFX_ADDRESS BaseVA = GMM_GBYTE(4);
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+    updateReq.UmdContext             = dev.getUmdContext();
+    updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+    updateReq.BaseGpuVA              = BaseVA;
+    updateReq.Map                    = 1;
+
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    mgr->GetStats(&Stats, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+    const uint64_t NumL1e = Stats.NumL1eWritten;
+    EXPECT_GT(NumL1e, 0u);
+    EXPECT_EQ(0u, Stats.NumL1eSkipped);
+
+    // Re-bind to same CCS emits no L1e update
+    dev.retire();
+    dev.resetStats();
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    EXPECT_EQ(0u, dev.Stats.NumWriteL1Entries);
+    mgr->GetStats(&Stats, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+    EXPECT_EQ(NumL1e, Stats.NumL1eWritten);
+    EXPECT_EQ(NumL1e, Stats.NumL1eSkipped);
+    EXPECT_EQ(NumL1e * sizeof(uint64_t), Stats.SkippedEntryBytes);
+
+    // Different CCS at same VA is written
+    updateReq.BaseResInfo = surf2->getGMMResourceInfo();
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    EXPECT_GT(dev.Stats.NumWriteL1Entries, 0u);
+    mgr->GetStats(&Stats, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+    EXPECT_GT(Stats.NumL1eWritten, NumL1e);
+    EXPECT_EQ(NumL1e, Stats.NumL1eSkipped);
+
+    // Unmap drops entries, re-map after it is written again
+    uint64_t NumWritten = Stats.NumL1eWritten;
+    updateReq.Map       = 0;
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    updateReq.Map = 1;
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    mgr->GetStats(&Stats, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+    EXPECT_EQ(2 * NumWritten - NumL1e, Stats.NumL1eWritten);
+    EXPECT_EQ(NumL1e, Stats.NumL1eSkipped);
+
+    GMM_GFX_ADDRESS auxOffset = surf2->getAuxGfxAddress(GMM_AUX_CCS) - surf2->getGfxAddress(GMM_PLANE_Y);
+    Walker          walker(BaseVA, BaseVA + auxOffset, mgr->GetAuxL3TableAddr());
+
+    for(size_t j = 0; j < surf2->getSurfaceSize(GMM_PLANE_Y); j += GMM_KBYTE(64))
+    {
+        ASSERT_EQ(walker.expected(BaseVA + j), walker.walk(BaseVA + j));
+    }
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    delete surf2;
+    delete surf;
+}
+
+TEST_F(CTestAuxTable, TestAuxTableStats)
+{
+    const uint32_t NumSurf = 64;
+
+    FakeDevice              dev;
+    GMM_PAGETABLE_MGR_STATS Stats = {0};
+    Surface *               surf  = new Surface(1280, 720);
+
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+
+    ASSERT_TRUE(mgr != NULL);
+    dev.attach(mgr);
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+    updateReq.UmdContext             = dev.getUmdContext();
+    updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+    updateReq.Map                    = 1;
+
+    for(uint32_t i = 0; i < NumSurf; i++)
+    {
+        updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    }
+
+    mgr->GetStats(&Stats, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+
+    EXPECT_GE(Stats.NumPools[POOL_TYPE_AUXTTL1] + Stats.NumPools[POOL_TYPE_AUXTTL2], 2u);
+    EXPECT_EQ(1u, Stats.NumL2Tables);
+    EXPECT_EQ(NumSurf, Stats.NumL1Tables);
+    EXPECT_GE(Stats.NumUsedNodes[POOL_TYPE_AUXTTL1], NumSurf);
+    EXPECT_EQ(GMM_KBYTE(32), Stats.L3TableSize);
+    EXPECT_EQ((GMM_GFX_SIZE_T)(Stats.NumUsedNodes[POOL_TYPE_AUXTTL1] + Stats.NumUsedNodes[POOL_TYPE_AUXTTL2]) * GMM_KBYTE(4), Stats.UsedSize);
+    EXPECT_EQ(Stats.UsedSize + Stats.FragmentedSize, Stats.PoolSize);
+    EXPECT_EQ(Stats.NumL1eWritten * GMM_KBYTE(64), Stats.MappedSize);
+
+    // Callback counts match what the device saw
+    EXPECT_EQ(dev.Stats.NumAlloc, Stats.NumCallbacks[GMM_PAGETABLE_CB_ALLOCATE]);
+    EXPECT_EQ(dev.Stats.NumWriteL1Entries, Stats.NumCallbacks[GMM_PAGETABLE_CB_WRITE_L1_ENTRIES]);
+    EXPECT_EQ(dev.Stats.NumWriteL2L3Entry, Stats.NumCallbacks[GMM_PAGETABLE_CB_WRITE_L2L3_ENTRY]);
+    EXPECT_EQ(dev.Stats.NumSubmit, Stats.NumCallbacks[GMM_PAGETABLE_CB_PROLOG]);
+    EXPECT_EQ(dev.Stats.NumSubmit, Stats.NumCallbacks[GMM_PAGETABLE_CB_EPILOG]);
+
+    // Released table nodes keep their fence until Gpu completes it
+    updateReq.Map = 0;
+    for(uint32_t i = 0; i < NumSurf; i += 2)
+    {
+        updateReq.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)i * GMM_MBYTE(16);
+        ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    }
+    mgr->GetStats(&Stats, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+    EXPECT_EQ(NumSurf / 2, Stats.NumL1Tables);
+    EXPECT_EQ(NumSurf / 2, Stats.NumPendingFences); // one per released table, not per pool node
+
+    dev.retire();
+    mgr->GetStats(&Stats, dev.getUmdContext()->BBFenceObj, dev.getCompletedFence());
+    EXPECT_EQ(0u, Stats.NumPendingFences);
+
+    // Dump has one line per L1 table, size query matches output
+    uint32_t Len = mgr->DumpPageTables(NULL, 0);
+    ASSERT_GT(Len, 0u);
+
+    std::vector<char> Dump(Len + 1);
+    EXPECT_EQ(Len, mgr->DumpPageTables(Dump.data(), Len + 1));
+    EXPECT_EQ(Len, strlen(Dump.data()));
+
+    uint32_t NumL1Lines = 0;
+    for(const char *p = strstr(Dump.data(), "L2e["); p; p = strstr(p + 1, "L2e["))
+    {
+        NumL1Lines++;
+    }
+    EXPECT_EQ(Stats.NumL1Tables, NumL1Lines);
+
+    char Small[16];
+    EXPECT_EQ(Len, mgr->DumpPageTables(Small, sizeof(Small)));
+    EXPECT_EQ(sizeof(Small) - 1, strlen(Small));
+
+    pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+    delete surf;
+}
+
+// Counting heap, registered as client allocator
+typedef struct AUXTT_TEST_HEAP_REC
+{
+    uint64_t NumAlloc;
+    uint64_t NumFree;
+    uint64_t NumReset;
+} AUXTT_TEST_HEAP;
+
+static void *GMM_STDCALL AuxTTHeapAlloc(void *pUserData, uint32_t Size, uint32_t Alignment)
+{
+    AUXTT_TEST_HEAP *pHeap = (AUXTT_TEST_HEAP *)pUserData;
+
+    __sync_fetch_and_add(&pHeap->NumAlloc, 1);
+    return aligned_alloc(Alignment, ALIGN(Size, Alignment));
+}
+
+static void GMM_STDCALL AuxTTHeapFree(void *pUserData, void *pMem)
+{
+    AUXTT_TEST_HEAP *pHeap = (AUXTT_TEST_HEAP *)pUserData;
+
+    __sync_fetch_and_add(&pHeap->NumFree, 1);
+    free(pMem);
+}
+
+static void GMM_STDCALL AuxTTHeapReset(void *pUserData)
+{
+    ((AUXTT_TEST_HEAP *)pUserData)->NumReset++;
+}
+
+TEST_F(CTestAuxTable, TestAuxTableClientAllocator)
+{
+    AUXTT_TEST_HEAP              Heap        = {0};
+    GmmClientAllocationCallbacks AllocatorCb = {0};
+    GMM_INIT_IN_ARGS             InArgs      = {};
+    GMM_INIT_OUT_ARGS            OutArgs     = {0};
+    pfnGmmInitWithAllocator      pfnInit     = NULL;
+
+    *(void **)(&pfnInit) = dlsym(hGmmLib, "InitializeGmmWithAllocator");
+    ASSERT_TRUE(pfnInit != NULL);
+
+    InArgs.ClientType = GMM_EXCITE_VISTA;
+    InArgs.pGtSysInfo = &pGfxAdapterInfo->SystemInfo;
+    InArgs.pSkuTable  = &pGfxAdapterInfo->SkuTable;
+    InArgs.pWaTable   = &pGfxAdapterInfo->WaTable;
+    InArgs.Platform   = GfxPlatform;
+
+    // Blocks not from client allocator are what malloc returned, modules built against older headers free() them
+    void *pPlain = GmmMemAllocator::AllocMem(NULL, 64, GMM_HEAP_OTHER);
+    ASSERT_TRUE(pPlain != NULL);
+    free(pPlain);
+
+    // Free without alloc is rejected
+    AllocatorCb.size      = sizeof(AllocatorCb);
+    AllocatorCb.pUserData = &Heap;
+    AllocatorCb.pfnFree   = AuxTTHeapFree;
+    EXPECT_EQ(GMM_INVALIDPARAM, pfnInit(&InArgs, &OutArgs, &AllocatorCb));
+
+    AllocatorCb.pfnAllocation = AuxTTHeapAlloc;
+    AllocatorCb.pfnResetArena = AuxTTHeapReset;
+    ASSERT_EQ(GMM_SUCCESS, pfnInit(&InArgs, &OutArgs, &AllocatorCb));
+
+    GMM_CLIENT_CONTEXT *pClientContext = OutArgs.pGmmClientContext;
+    ASSERT_TRUE(pClientContext != NULL);
+    EXPECT_EQ(1u, Heap.NumAlloc);
+
+    // Resource info comes from client heap, as do the context's resource mem stats and their entries
+    GMM_RESCREATE_PARAMS gmmParams = {};
+    gmmParams.Type                 = RESOURCE_BUFFER;
+    gmmParams.Format               = GMM_FORMAT_GENERIC_8BIT;
+    gmmParams.BaseWidth64          = GMM_KBYTE(64);
+    gmmParams.BaseHeight           = 1;
+    gmmParams.Depth                = 1;
+    gmmParams.Flags.Gpu.Texture    = 1;
+
+    GMM_RESOURCE_INFO *pRes = pClientContext->CreateResInfoObject(&gmmParams);
+    ASSERT_TRUE(pRes != NULL);
+    EXPECT_EQ(4u, Heap.NumAlloc);
+
+    // Page-table manager and its table metadata too
+    FakeDevice dev;
+    Surface *  surf = new Surface(1280, 720);
+    ASSERT_TRUE(surf != NULL && surf->init());
+
+    GmmPageTableMgr *mgr = pClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+    ASSERT_TRUE(mgr != NULL);
+    dev.attach(mgr);
+
+    uint64_t NumAllocMgr = Heap.NumAlloc;
+    EXPECT_GT(NumAllocMgr, 4u);
+
+    GMM_DDI_UPDATEAUXTABLE updateReq = {0};
+    updateReq.UmdContext             = dev.getUmdContext();
+    updateReq.BaseResInfo            = surf->getGMMResourceInfo();
+    updateReq.BaseGpuVA              = GMM_GBYTE(4);
+    updateReq.Map                    = 1;
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+    EXPECT_GT(Heap.NumAlloc, NumAllocMgr); // L2/L1 table objects
+
+    updateReq.Map = 0;
+    ASSERT_EQ(GMM_SUCCESS, mgr->UpdateAuxTable(&updateReq));
+
+    pClientContext->DestroyPageTblMgrObject(mgr);
+    pClientContext->DestroyResInfoObject(pRes);
+    delete surf;
+
+    // Only the context and its stats are left, arena reset once they're gone
+    EXPECT_EQ(Heap.NumAlloc - 3, Heap.NumFree);
+    EXPECT_EQ(0u, Heap.NumReset);
+
+    pfnGmmDestroy(&OutArgs);
+    EXPECT_EQ(Heap.NumAlloc, Heap.NumFree);
+    EXPECT_EQ(1u, Heap.NumReset);
+
+    // Struct of client built before pfnResetArena, member past size isn't read
+    AllocatorCb.size = offsetof(GmmClientAllocationCallbacks, pfnResetArena);
+    ASSERT_EQ(GMM_SUCCESS, pfnInit(&InArgs, &OutArgs, &AllocatorCb));
+    ASSERT_TRUE(OutArgs.pGmmClientContext != NULL);
+    pfnGmmDestroy(&OutArgs);
+    EXPECT_EQ(Heap.NumAlloc, Heap.NumFree);
+    EXPECT_EQ(1u, Heap.NumReset);
+}
+
+// Replays map/unmap pattern through FakeDevice, reports latency, callback counts and page-table memory
+static void AuxTTReplay(CTestAuxTable::FakeDevice &dev, GmmPageTableMgr *mgr, const char *Name,
+                        GMM_DDI_UPDATEAUXTABLE *Reqs, uint32_t NumReqs, uint32_t BatchSize, GMM_GFX_SIZE_T MappedBytes)
+{
+    dev.resetStats();
+
+    auto Start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < NumReqs; i += BatchSize)
+    {
+        uint32_t Num = GFX_MIN(BatchSize, NumReqs - i);
+        EXPECT_EQ(GMM_SUCCESS, (Num == 1) ? mgr->UpdateAuxTable(&Reqs[i]) : mgr->UpdateAuxTables(&Reqs[i], Num, NULL));
+        dev.retire();
+    }
+    auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+
+    printf("%-12s %7u reqs: %9.3f us/req | submits %6llu L1 %7llu L2L3 %7llu bytes %9llu max-cmds %5llu | BO alloc/free %4llu/%4llu waits %4llu stalls %4llu | PT peak %6llu KB (%.2f%% of %llu MB peak mapped)\n",
+           Name, NumReqs, (double)Elapsed / NumReqs,
+           (unsigned long long)dev.Stats.NumSubmit, (unsigned long long)dev.Stats.NumWriteL1Entries,
+           (unsigned long long)dev.Stats.NumWriteL2L3Entry, (unsigned long long)dev.Stats.NumCmdBytes,
+           (unsigned long long)dev.Stats.MaxSubmitCmds, (unsigned long long)dev.Stats.NumAlloc,
+           (unsigned long long)dev.Stats.NumFree, (unsigned long long)dev.Stats.NumCpuWait,
+           (unsigned long long)dev.Stats.NumCpuStall, (unsigned long long)(dev.Stats.PeakBytes >> 10),
+           MappedBytes ? 100.0 * dev.Stats.PeakBytes / MappedBytes : 0.0, (unsigned long long)(MappedBytes >> 20));
+}
+
+TEST_F(CTestAuxTable, DISABLED_BenchmarkAuxTableReplay)
+{
+    const uint32_t NumSurf = 4096;
+    const uint32_t NumLive = 256;
+
+    Surface *small = new Surface(1280, 720);
+    Surface *large = new Surface(16384, 12288);
+
+    ASSERT_TRUE(small != NULL && small->init());
+    ASSERT_TRUE(large != NULL && large->init());
+
+    GMM_GFX_SIZE_T SmallSize = GFX_ALIGN(small->getGMMResourceInfo()->GetSizeMainSurface(), GMM_KBYTE(64));
+    GMM_GFX_SIZE_T LargeSize = GFX_ALIGN(large->getGMMResourceInfo()->GetSizeMainSurface(), GMM_KBYTE(64));
+
+    std::vector<GMM_DDI_UPDATEAUXTABLE> Reqs;
+
+    for(int Pattern = 0; Pattern < 5; Pattern++)
+    {
+        FakeDevice       dev;
+        GmmPageTableMgr *mgr = pGmmULTClientContext->CreatePageTblMgrObject(dev.getDeviceCb(), TT_TYPE::AUXTT);
+
+        ASSERT_TRUE(mgr != NULL);
+        dev.attach(mgr);
+
+        GMM_DDI_UPDATEAUXTABLE Req = {0};
+        Req.UmdContext             = dev.getUmdContext();
+        Req.BaseResInfo            = small->getGMMResourceInfo();
+
+        const char *   Name      = "";
+        uint32_t       BatchSize = 1;
+        GMM_GFX_SIZE_T Mapped    = 0;
+
+        Reqs.clear();
+        switch(Pattern)
+        {
+            case 0: // Back-to-back surfaces mapped, then unmapped
+            case 1: // Same, bulk-updated 64 requests at a time
+                Name      = Pattern ? "seq-bulk64" : "sequential";
+                BatchSize = Pattern ? 64 : 1;
+                for(int Map = 1; Map >= 0; Map--)
+                {
+                    for(uint32_t i = 0; i < NumSurf; i++)
+                    {
+                        Req.BaseGpuVA = GMM_GBYTE(4) + i * SmallSize;
+                        Req.Map       = Map;
+                        Reqs.push_back(Req);
+                    }
+                }
+                Mapped = NumSurf * SmallSize;
+                break;
+            case 2: // Scattered surfaces, one per L1 table
+                Name = "scattered";
+                for(int Map = 1; Map >= 0; Map--)
+                {
+                    for(uint32_t i = 0; i < NumSurf; i++)
+                    {
+                        Req.BaseGpuVA = GMM_GBYTE(4) + (GMM_GFX_ADDRESS)((i * 2731) % NumSurf) * GMM_MBYTE(16);
+                        Req.Map       = Map;
+                        Reqs.push_back(Req);
+                    }
+                }
+                Mapped = NumSurf * SmallSize;
+                break;
+            case 3: // Short-lived surfaces, NumLive slots recycled in random order
+            {
+                uint32_t Lcg = 12345;
+                bool     Live[NumLive] = {};
+
+                Name = "churn";
+                for(uint32_t i = 0; i < 4 * NumSurf; i++)
+                {
+                    Lcg           = Lcg * 1103515245 + 12345;
+                    uint32_t Slot = (Lcg >> 8) % NumLive;
+                    Req.BaseGpuVA = GMM_GBYTE(4) + Slot * SmallSize;
+                    Req.Map       = Live[Slot] ? 0 : 1;
+                    Live[Slot]    = !Live[Slot];
+                    Reqs.push_back(Req);
+                }
+                for(uint32_t Slot = 0; Slot < NumLive; Slot++)
+                {
+                    if(Live[Slot])
+                    {
+                        Req.BaseGpuVA = GMM_GBYTE(4) + Slot * SmallSize;
+                        Req.Map       = 0;
+                        Reqs.push_back(Req);
+                    }
+                }
+                Mapped = NumLive * SmallSize;
+                break;
+            }
+            default: // Few large surfaces
+                Name            = "large";
+                Req.BaseResInfo = large->getGMMResourceInfo();
+                for(int Map = 1; Map >= 0; Map--)
+                {
+                    for(uint32_t i = 0; i < 8; i++)
+                    {
+                        Req.BaseGpuVA = GMM_GBYTE(4) + i * LargeSize;
+                        Req.Map       = Map;
+                        Reqs.push_back(Req);
+                    }
+                }
+                Mapped = 8 * LargeSize;
+                break;
+        }
+
+        AuxTTReplay(dev, mgr, Name, Reqs.data(), (uint32_t)Reqs.size(), BatchSize, Mapped);
+
+        pGmmULTClientContext->DestroyPageTblMgrObject(mgr);
+        EXPECT_EQ(0u, dev.Stats.LiveBytes);
+    }
+
+    delete large;
+    delete small;
+}
+
 #endif /* __linux__ */
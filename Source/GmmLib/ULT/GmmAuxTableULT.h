@@ -31,6 +31,7 @@ OTHER DEALINGS IN THE SOFTWARE.
 #include "GmmGen10ResourceULT.h"
 #include <stdlib.h>
 #include <malloc.h>
+#include <vector>
 
 #ifndef ALIGN
 #define ALIGN(v, a) (((v) + ((a)-1)) & ~((a)-1))
@@ -50,6 +51,231 @@ public:
     static void freeCB(void *bo);
     static void waitFromCpuCB(void *bo);
 
+    // Translation-table callbacks, apply Gpu-updates directly (gpuAddr == cpuAddr) and count them
+    static int prologTranslationTableCB(void *pDeviceHandle);
+    static int writeL1EntriesCB(void *pDeviceHandle, const uint32_t NumEntries, GMM_GFX_ADDRESS GfxAddress, uint32_t *Data);
+    static int writeL2L3EntryCB(void *pDeviceHandle, GMM_GFX_ADDRESS GfxAddress, uint64_t Data);
+    static int epilogTranslationTableCB(void *pDeviceHandle, uint8_t ForceFlush);
+
+    typedef struct
+    {
+        uint64_t NumWriteL1Entries; // pfWriteL1Entries callbacks
+        uint64_t NumWriteL2L3Entry; // pfWriteL2L3Entry callbacks
+        uint64_t NumBytes;          // Table-entry bytes written by both
+        uint64_t NumProlog;         // pfPrologTranslationTable callbacks
+        uint64_t NumEpilog;         // pfEpilogTranslationTable callbacks
+    } TT_WRITE_STATS;
+
+    static TT_WRITE_STATS TTWriteStats;
+
+    // In-memory stand-in for client device: host-memory BOs (gpuAddr == cpuAddr), fence timeline
+    // advanced per submission, and recorder of translation-table commands. Gpu-updates are applied
+    // to host memory as recorded, so Walker can verify tables. Not thread-safe.
+    class FakeDevice
+    {
+    public:
+        typedef enum
+        {
+            CMD_WRITE_L1_ENTRIES,
+            CMD_WRITE_L2L3_ENTRY,
+        } CMD_TYPE;
+
+        typedef struct
+        {
+            CMD_TYPE        Type;
+            GMM_GFX_ADDRESS GfxAddress;
+            uint32_t        NumBytes;
+        } CMD;
+
+        typedef struct
+        {
+            uint64_t NumAlloc;          // pfnAllocate callbacks (page-table BOs)
+            uint64_t NumFree;           // pfnDeallocate callbacks
+            uint64_t LiveBytes;         // BO bytes currently allocated
+            uint64_t PeakBytes;         // max. LiveBytes
+            uint64_t NumCpuWait;        // pfnWaitFromCpu callbacks
+            uint64_t NumCpuStall;       // CPU waits on fence not yet retired
+            uint64_t NumWriteL1Entries; // pfWriteL1Entries callbacks
+            uint64_t NumWriteL2L3Entry; // pfWriteL2L3Entry callbacks
+            uint64_t NumCmdBytes;       // Table-entry bytes written by both
+            uint64_t NumSubmit;         // pfPrologTranslationTable/pfEpilogTranslationTable pairs
+            uint64_t MaxSubmitCmds;     // max. commands recorded in one submission
+        } STATS;
+
+        FakeDevice()
+        {
+            memset(&Stats, 0, sizeof(Stats));
+            memset(&UmdContext, 0, sizeof(UmdContext));
+            memset(&DeviceCb, 0, sizeof(DeviceCb));
+
+            DeviceCb.pBufMgr                   = this;
+            DeviceCb.DevCbPtrs_.pfnAllocate    = allocCB;
+            DeviceCb.DevCbPtrs_.pfnDeallocate  = freeCB;
+            DeviceCb.DevCbPtrs_.pfnWaitFromCpu = waitFromCpuCB;
+
+            UmdContext.pCommandQueueHandle = this;
+            UmdContext.BBFenceObj          = this;
+            CompletedFence                 = 0;
+            InSubmit                       = false;
+        }
+
+        // Hooks translation-table callbacks of given manager to this device
+        void attach(GmmLib::GmmPageTableMgr *mgr)
+        {
+            mgr->TTCb.pfPrologTranslationTable = prologCB;
+            mgr->TTCb.pfWriteL1Entries         = writeL1EntriesCB;
+            mgr->TTCb.pfWriteL2L3Entry         = writeL2L3EntryCB;
+            mgr->TTCb.pfEpilogTranslationTable = epilogCB;
+            mgr->SetAuxMapGpuUpdate(1);
+            mgr->SetAtomicL1EntriesWrite(1);
+        }
+
+        // Gpu catches up with all submissions
+        void retire()
+        {
+            CompletedFence = UmdContext.BBLastFence;
+        }
+
+        uint64_t getCompletedFence()
+        {
+            return CompletedFence;
+        }
+
+        void resetStats()
+        {
+            uint64_t LiveBytes = Stats.LiveBytes;
+            memset(&Stats, 0, sizeof(Stats));
+            Stats.LiveBytes = Stats.PeakBytes = LiveBytes;
+        }
+
+        GMM_DEVICE_CALLBACKS_INT *getDeviceCb()
+        {
+            return &DeviceCb;
+        }
+
+        GMM_UMD_SYNCCONTEXT *getUmdContext()
+        {
+            return &UmdContext;
+        }
+
+        const std::vector<CMD> &getCommands()
+        {
+            return Cmds;
+        }
+
+        STATS Stats;
+
+    private:
+        typedef struct
+        {
+            FakeDevice *pDevice;
+            void *      pMem;
+            size_t      Size;
+        } BO;
+
+        static int allocCB(void *bufMgr, size_t size, size_t alignment, void **bo, void **cpuAddr, uint64_t *gpuAddr)
+        {
+            FakeDevice *pDevice = (FakeDevice *)bufMgr;
+            BO *        pBO     = new BO;
+
+            pBO->pDevice = pDevice;
+            pBO->Size    = ALIGN(size, alignment);
+            pBO->pMem    = aligned_alloc(alignment, pBO->Size);
+            if(!pBO->pMem)
+            {
+                delete pBO;
+                return -3;
+            }
+
+            *bo      = pBO;
+            *cpuAddr = pBO->pMem;
+            *gpuAddr = (uint64_t)pBO->pMem;
+
+            pDevice->Stats.NumAlloc++;
+            pDevice->Stats.LiveBytes += pBO->Size;
+            pDevice->Stats.PeakBytes = GFX_MAX(pDevice->Stats.PeakBytes, pDevice->Stats.LiveBytes);
+            return 0;
+        }
+
+        static void freeCB(void *bo)
+        {
+            BO *pBO = (BO *)bo;
+
+            pBO->pDevice->Stats.NumFree++;
+            pBO->pDevice->Stats.LiveBytes -= pBO->Size;
+            free(pBO->pMem);
+            delete pBO;
+        }
+
+        static void waitFromCpuCB(void *bo)
+        {
+            FakeDevice *pDevice = ((BO *)bo)->pDevice;
+
+            pDevice->Stats.NumCpuWait++;
+            if(pDevice->CompletedFence < pDevice->UmdContext.BBLastFence)
+            {
+                pDevice->Stats.NumCpuStall++;
+                pDevice->retire();
+            }
+        }
+
+        static int prologCB(void *pDeviceHandle)
+        {
+            FakeDevice *pDevice = (FakeDevice *)pDeviceHandle;
+
+            pDevice->InSubmit = true;
+            pDevice->Cmds.clear();
+            return 0;
+        }
+
+        static int writeL1EntriesCB(void *pDeviceHandle, const uint32_t NumEntries, GMM_GFX_ADDRESS GfxAddress, uint32_t *Data)
+        {
+            FakeDevice *pDevice = (FakeDevice *)pDeviceHandle;
+            CMD         Cmd     = {CMD_WRITE_L1_ENTRIES, GfxAddress, (uint32_t)(NumEntries * sizeof(uint32_t))}; // NumEntries is in DWORDs
+
+            memcpy((void *)GfxAddress, Data, Cmd.NumBytes);
+            pDevice->record(Cmd);
+            pDevice->Stats.NumWriteL1Entries++;
+            return 0;
+        }
+
+        static int writeL2L3EntryCB(void *pDeviceHandle, GMM_GFX_ADDRESS GfxAddress, uint64_t Data)
+        {
+            FakeDevice *pDevice = (FakeDevice *)pDeviceHandle;
+            CMD         Cmd     = {CMD_WRITE_L2L3_ENTRY, GfxAddress, sizeof(uint64_t)};
+
+            *(uint64_t *)GfxAddress = Data;
+            pDevice->record(Cmd);
+            pDevice->Stats.NumWriteL2L3Entry++;
+            return 0;
+        }
+
+        // Submission: BB carrying recorded commands gets next fence value
+        static int epilogCB(void *pDeviceHandle, uint8_t ForceFlush)
+        {
+            FakeDevice *pDevice = (FakeDevice *)pDeviceHandle;
+
+            pDevice->InSubmit = false;
+            pDevice->Stats.NumSubmit++;
+            pDevice->Stats.MaxSubmitCmds = GFX_MAX(pDevice->Stats.MaxSubmitCmds, (uint64_t)pDevice->Cmds.size());
+            pDevice->UmdContext.BBLastFence++;
+            return 0;
+        }
+
+        void record(const CMD &Cmd)
+        {
+            EXPECT_TRUE(InSubmit) << "Table update outside prolog/epilog";
+            Cmds.push_back(Cmd);
+            Stats.NumCmdBytes += Cmd.NumBytes;
+        }
+
+        GMM_DEVICE_CALLBACKS_INT DeviceCb;
+        GMM_UMD_SYNCCONTEXT      UmdContext;
+        uint64_t                 CompletedFence;
+        bool                     InSubmit;
+        std::vector<CMD>         Cmds; // commands of current/last submission
+    };
+
     class Surface
     {
     public:
@@ -226,6 +452,12 @@ public:
             return auxAddr;
         }
 
+        bool l2Valid(GMM_GFX_ADDRESS addr)
+        {
+            uint64_t *l2Base = (uint64_t *)((mL3Base[l3Index(addr)] >> 15) << 15);
+            return l2Base[l2Index(addr)] & 1;
+        }
+
     public:
         static inline uint32_t l3Index(GMM_GFX_ADDRESS addr)
         {
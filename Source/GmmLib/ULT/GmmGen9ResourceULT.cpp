@@ -4244,3 +4244,108 @@ TEST_F(CTestGen9Resource, TestStdSwizzle)
 {
     // TODO: Test RedescribedPlanes, along with other StdSwizzle mappings
 }
+
+/// @brief ULT for size breakdown of a mip tailed resource, tail mips share one 64KB tile
+TEST_F(CTestGen9Resource, TestResourceSizeInfoMipTail)
+{
+    GMM_RESOURCE_SIZE_INFO SizeInfo;
+    GMM_RESCREATE_PARAMS   gmmParams = {};
+    GMM_RESOURCE_INFO *    ResourceInfo;
+
+    gmmParams.Type              = RESOURCE_2D;
+    gmmParams.Format            = GMM_FORMAT_GENERIC_32BIT;
+    gmmParams.Flags.Gpu.Texture = 1;
+    gmmParams.BaseWidth64       = 0x100;
+    gmmParams.BaseHeight        = 0x100;
+    gmmParams.Depth             = 1;
+    gmmParams.MaxLod            = 8;
+    SetTileFlag(gmmParams, TEST_TILEYS);
+
+    ResourceInfo = pGmmULTClientContext->CreateResInfoObject(&gmmParams);
+    ASSERT_TRUE(ResourceInfo != NULL);
+    // Called non-virtually: GetSizeInfo() follows OverridePlatform() in the vtable, which
+    // Debug ULTs declare and the Linux lib (built without _DEBUG) doesn't
+    ResourceInfo->GmmLib::GmmResourceInfoCommon::GetSizeInfo(&SizeInfo);
+    EXPECT_EQ(0u, SizeInfo.AlignPadding); // Ys HAlign/VAlign match lod 0 and 1
+    EXPECT_EQ(GMM_KBYTE(64) - (SizeInfo.LogicalSize - (256u * 256u * 4u) - (128u * 128u * 4u)), SizeInfo.MipTailPadding);
+    EXPECT_EQ(SizeInfo.MainSurfaceSize, SizeInfo.LogicalSize + SizeInfo.AlignPadding + SizeInfo.MipTailPadding + SizeInfo.LayoutPadding);
+    EXPECT_EQ(SizeInfo.AllocationSize, SizeInfo.MainSurfaceSize + SizeInfo.AuxSize + SizeInfo.ClearColorSize +
+                                       SizeInfo.AuxPadding + SizeInfo.PageSizePadding);
+    pGmmULTClientContext->DestroyResInfoObject(ResourceInfo);
+}
+
+/// @brief ULT for Flags.Info.OptimizeTilingForSize candidate search
+TEST_F(CTestGen9Resource, TestOptimizeTilingForSize)
+{
+    const GMM_RESOURCE_TYPE ResType[] = {RESOURCE_2D, RESOURCE_3D};
+    GMM_RESOURCE_SIZE_INFO  SizeInfo;
+    GMM_TILING_SEARCH       Search;
+    GMM_RESCREATE_PARAMS    gmmParams = {};
+    GMM_RESOURCE_INFO *     ResourceInfo;
+
+    for(uint32_t i = 0; i < sizeof(ResType) / sizeof(ResType[0]); i++)
+    {
+        for(uint32_t Policy = GMM_TILING_SEARCH_SMALLEST; Policy <= GMM_TILING_SEARCH_PREFER_64KB; Policy++)
+        {
+            gmmParams                                  = {};
+            gmmParams.Type                             = ResType[i];
+            gmmParams.Format                           = GMM_FORMAT_GENERIC_32BIT;
+            gmmParams.Flags.Gpu.Texture                = 1;
+            gmmParams.Flags.Info.OptimizeTilingForSize = 1;
+            gmmParams.BaseWidth64                      = 0x28;
+            gmmParams.BaseHeight                       = 0x6;
+            gmmParams.Depth                            = 0x3;
+            gmmParams.pTilingSearch                    = &Search;
+
+            Search                  = {};
+            Search.Policy           = static_cast<GMM_TILING_SEARCH_POLICY>(Policy);
+            Search.MaxGrowthPercent = 100;
+
+            ResourceInfo = pGmmULTClientContext->CreateResInfoObject(&gmmParams);
+            ASSERT_TRUE(ResourceInfo != NULL);
+            ResourceInfo->GmmLib::GmmResourceInfoCommon::GetSizeInfo(&SizeInfo);
+
+            // Y, Ys, Yf and Linear, plus X for 2D
+            EXPECT_EQ((ResType[i] == RESOURCE_3D) ? 4u : 5u, Search.NumCandidates);
+            ASSERT_LT(Search.Selected, Search.NumCandidates);
+            EXPECT_EQ(Search.Candidates[Search.Selected].TileMode, SizeInfo.TileMode);
+            EXPECT_EQ(Search.Candidates[Search.Selected].Size, ResourceInfo->GetSizeAllocation());
+
+            for(uint32_t j = 0; j < Search.NumCandidates; j++)
+            {
+                if(Search.Policy == GMM_TILING_SEARCH_SMALLEST ||
+                   !Search.Candidates[Search.Selected].Is64KBPageSuitable)
+                {
+                    EXPECT_LE(Search.Candidates[Search.Selected].Size, Search.Candidates[j].Size);
+                }
+                else if(Search.Candidates[j].Is64KBPageSuitable)
+                {
+                    EXPECT_LE(Search.Candidates[Search.Selected].Size, Search.Candidates[j].Size);
+                }
+            }
+
+            pGmmULTClientContext->DestroyResInfoObject(ResourceInfo);
+        }
+    }
+
+    // Usage dictated tiling is left alone
+    gmmParams                                  = {};
+    gmmParams.Type                             = RESOURCE_2D;
+    gmmParams.Format                           = GMM_FORMAT_GENERIC_32BIT;
+    gmmParams.Flags.Gpu.Texture                = 1;
+    gmmParams.Flags.Gpu.Depth                  = 1;
+    gmmParams.Flags.Info.OptimizeTilingForSize = 1;
+    gmmParams.BaseWidth64                      = 0x28;
+    gmmParams.BaseHeight                       = 0x6;
+    gmmParams.Depth                            = 0x1;
+    gmmParams.pTilingSearch                    = &Search;
+    SetTileFlag(gmmParams, TEST_TILEY);
+    Search = {};
+
+    ResourceInfo = pGmmULTClientContext->CreateResInfoObject(&gmmParams);
+    ASSERT_TRUE(ResourceInfo != NULL);
+    ResourceInfo->GmmLib::GmmResourceInfoCommon::GetSizeInfo(&SizeInfo);
+    EXPECT_EQ(0u, Search.NumCandidates);
+    EXPECT_EQ(LEGACY_TILE_Y, SizeInfo.TileMode);
+    pGmmULTClientContext->DestroyResInfoObject(ResourceInfo);
+}
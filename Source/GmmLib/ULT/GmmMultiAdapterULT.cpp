@@ -22,8 +22,11 @@ OTHER DEALINGS IN THE SOFTWARE.
 #include "GmmMultiAdapterULT.h"
 #ifndef _WIN32
 #include <dlfcn.h>
+#include <dirent.h>
+#include <unistd.h>
 #endif
 #include <stdlib.h>
+#include <chrono>
 
 ADAPTER_INFO *      MACommonULT::pGfxAdapterInfo[MAX_NUM_ADAPTERS][MAX_COUNT_PER_ADAPTER];
 PLATFORM            MACommonULT::GfxPlatform[MAX_NUM_ADAPTERS][MAX_COUNT_PER_ADAPTER];
@@ -527,5 +530,480 @@ TEST_F(CTestMA, TestMTLoadMultipleAdaptersMultipleTimes)
     CreateMAThread(MAX_NUM_ADAPTERS * MAX_COUNT_PER_ADAPTER);
 }
 
+#ifdef __linux__
+// Create the LibContext twice with GMM_CONTEXT_SNAPSHOT_DIR set. The first init writes
+// the snapshot, the second one is restored from it and must match bit for bit. A
+// corrupted snapshot must be ignored and fall back to the full init.
+TEST_F(CTestMA, TestContextSnapshot)
+{
+    const uint32_t                AdapterIdx = 2;
+    char                          SnapshotDir[] = "/tmp/gmm_ult_snapshot_XXXXXX";
+    char                          SnapshotFile[512] = {0};
+    GMM_CACHE_POLICY_ELEMENT     *pRefCachePolicy;
+    GMM_CACHE_POLICY_TBL_ELEMENT *pRefCachePolicyTbl;
+    DIR *                         pDir;
+    struct dirent *               pEntry;
+    ADAPTER_INFO                  AdapterInfo;
+
+    ASSERT_TRUE(mkdtemp(SnapshotDir) != NULL);
+    setenv("GMM_CONTEXT_SNAPSHOT_DIR", SnapshotDir, 1);
+
+    pRefCachePolicy    = (GMM_CACHE_POLICY_ELEMENT *)calloc(GMM_RESOURCE_USAGE_MAX, sizeof(GMM_CACHE_POLICY_ELEMENT));
+    pRefCachePolicyTbl = (GMM_CACHE_POLICY_TBL_ELEMENT *)calloc(GMM_MAX_NUMBER_MOCS_INDEXES, sizeof(GMM_CACHE_POLICY_TBL_ELEMENT));
+    ASSERT_TRUE(pRefCachePolicy && pRefCachePolicyTbl);
+
+    LoadGmmDll(AdapterIdx, 0);
+
+    // Full init, writes the snapshot
+    GmmInitModule(AdapterIdx, 0);
+    memcpy(pRefCachePolicy, pLibContext[AdapterIdx][0]->GetCachePolicyUsage(), GMM_RESOURCE_USAGE_MAX * sizeof(GMM_CACHE_POLICY_ELEMENT));
+    memcpy(pRefCachePolicyTbl, pLibContext[AdapterIdx][0]->GetCachePolicyTlbElement(), GMM_MAX_NUMBER_MOCS_INDEXES * sizeof(GMM_CACHE_POLICY_TBL_ELEMENT));
+    EXPECT_EQ(1u, pLibContext[AdapterIdx][0]->GetInitStats().Phase[GMM_INIT_PHASE_INIT_CACHE_POLICY].Count);
+    EXPECT_EQ(1u, pLibContext[AdapterIdx][0]->GetInitStats().Phase[GMM_INIT_PHASE_SETUP_MOCS_TABLE].Count);
+    GmmDestroyModule(AdapterIdx, 0);
+
+    pDir = opendir(SnapshotDir);
+    ASSERT_TRUE(pDir);
+    while((pEntry = readdir(pDir)) != NULL)
+    {
+        if(pEntry->d_name[0] != '.')
+        {
+            snprintf(SnapshotFile, sizeof(SnapshotFile), "%s/%s", SnapshotDir, pEntry->d_name);
+        }
+    }
+    closedir(pDir);
+    ASSERT_NE(SnapshotFile[0], 0);
+
+    // Restored from the snapshot, InitCachePolicy() and its MOCS setup are skipped
+    GmmInitModule(AdapterIdx, 0);
+    EXPECT_EQ(0, memcmp(pRefCachePolicy, pLibContext[AdapterIdx][0]->GetCachePolicyUsage(), GMM_RESOURCE_USAGE_MAX * sizeof(GMM_CACHE_POLICY_ELEMENT)));
+    EXPECT_EQ(0, memcmp(pRefCachePolicyTbl, pLibContext[AdapterIdx][0]->GetCachePolicyTlbElement(), GMM_MAX_NUMBER_MOCS_INDEXES * sizeof(GMM_CACHE_POLICY_TBL_ELEMENT)));
+    EXPECT_EQ(1u, pLibContext[AdapterIdx][0]->GetInitStats().Phase[GMM_INIT_PHASE_INIT_CACHE_POLICY].Count);
+    EXPECT_EQ(0u, pLibContext[AdapterIdx][0]->GetInitStats().Phase[GMM_INIT_PHASE_SETUP_MOCS_TABLE].Count);
+    AdapterInfo = *pGfxAdapterInfo[AdapterIdx][0];
+    GmmDestroyModule(AdapterIdx, 0);
+
+    // Padding and fields the cache policy doesn't read keep the key, still restored.
+    // GmmInitModule() takes adapter info already set up as is.
+    pGfxAdapterInfo[AdapterIdx][0] = (ADAPTER_INFO *)malloc(sizeof(ADAPTER_INFO));
+    ASSERT_TRUE(pGfxAdapterInfo[AdapterIdx][0] != NULL);
+    *pGfxAdapterInfo[AdapterIdx][0] = AdapterInfo;
+    ((uint8_t *)&pGfxAdapterInfo[AdapterIdx][0]->SystemInfo)[offsetof(GT_SYSTEM_INFO, IsL3HashModeEnabled) + 1] ^= 0xFF;
+    pGfxAdapterInfo[AdapterIdx][0]->SystemInfo.EUCount += 8;
+    GmmInitModule(AdapterIdx, 0);
+    EXPECT_EQ(0u, pLibContext[AdapterIdx][0]->GetInitStats().Phase[GMM_INIT_PHASE_SETUP_MOCS_TABLE].Count);
+    GmmDestroyModule(AdapterIdx, 0);
+
+    // Corrupted snapshot is rejected
+    FILE *pFile = fopen(SnapshotFile, "r+b");
+    ASSERT_TRUE(pFile);
+    fseek(pFile, 64, SEEK_SET);
+    fputc(0xA5, pFile);
+    fclose(pFile);
+
+    GmmInitModule(AdapterIdx, 0);
+    EXPECT_EQ(0, memcmp(pRefCachePolicy, pLibContext[AdapterIdx][0]->GetCachePolicyUsage(), GMM_RESOURCE_USAGE_MAX * sizeof(GMM_CACHE_POLICY_ELEMENT)));
+    EXPECT_EQ(0, memcmp(pRefCachePolicyTbl, pLibContext[AdapterIdx][0]->GetCachePolicyTlbElement(), GMM_MAX_NUMBER_MOCS_INDEXES * sizeof(GMM_CACHE_POLICY_TBL_ELEMENT)));
+    EXPECT_EQ(1u, pLibContext[AdapterIdx][0]->GetInitStats().Phase[GMM_INIT_PHASE_SETUP_MOCS_TABLE].Count);
+    GmmDestroyModule(AdapterIdx, 0);
+
+    UnLoadGmmDll(AdapterIdx, 0);
+
+    unsetenv("GMM_CONTEXT_SNAPSHOT_DIR");
+    unlink(SnapshotFile);
+    rmdir(SnapshotDir);
+    free(pRefCachePolicy);
+    free(pRefCachePolicyTbl);
+}
+
+// Context creation records the cost of each init phase; lazily built phases are
+// recorded on first access.
+TEST_F(CTestMA, TestContextInitStats)
+{
+    const uint32_t AdapterIdx = 2;
+
+    LoadGmmDll(AdapterIdx, 0);
+    GmmInitModule(AdapterIdx, 0);
+
+    const GMM_INIT_STATS &Stats = pLibContext[AdapterIdx][0]->GetInitStats();
+    EXPECT_EQ(1u, Stats.Phase[GMM_INIT_PHASE_CREATE_LIB_CONTEXT].Count);
+    EXPECT_EQ(1u, Stats.Phase[GMM_INIT_PHASE_INIT_CONTEXT].Count);
+    EXPECT_GT(Stats.Phase[GMM_INIT_PHASE_CREATE_LIB_CONTEXT].WallTimeNs, 0u);
+    EXPECT_GE(Stats.Phase[GMM_INIT_PHASE_CREATE_LIB_CONTEXT].WallTimeNs, Stats.Phase[GMM_INIT_PHASE_INIT_CONTEXT].WallTimeNs);
+    EXPECT_GE(Stats.Phase[GMM_INIT_PHASE_CREATE_LIB_CONTEXT].AllocCount, 1u);
+
+    ASSERT_TRUE(pLibContext[AdapterIdx][0]->GetCachePolicyObj() != NULL);
+    ASSERT_TRUE(pLibContext[AdapterIdx][0]->GetTextureCalc() != NULL);
+    EXPECT_EQ(1u, Stats.Phase[GMM_INIT_PHASE_INIT_CACHE_POLICY].Count);
+    EXPECT_EQ(1u, Stats.Phase[GMM_INIT_PHASE_SETUP_MOCS_TABLE].Count);
+    EXPECT_EQ(1u, Stats.Phase[GMM_INIT_PHASE_CREATE_TEXTURE_CALC].Count);
+    EXPECT_GE(Stats.Phase[GMM_INIT_PHASE_INIT_CACHE_POLICY].AllocCount, 1u);
+    EXPECT_GE(Stats.Phase[GMM_INIT_PHASE_INIT_CACHE_POLICY].WallTimeNs, Stats.Phase[GMM_INIT_PHASE_SETUP_MOCS_TABLE].WallTimeNs);
+
+    GmmDestroyModule(AdapterIdx, 0);
+    UnLoadGmmDll(AdapterIdx, 0);
+}
+
+// Checks per category heap accounting follows object creation and destruction
+TEST_F(CTestMA, TestContextHeapStats)
+{
+    const uint32_t        AdapterIdx = 2;
+    GMM_HEAP_STATS        Before = {}, After = {}, Freed = {};
+    GMM_RESCREATE_PARAMS  gmmParams = {};
+
+    LoadGmmDll(AdapterIdx, 0);
+    GmmInitModule(AdapterIdx, 0);
+    ASSERT_TRUE(pLibContext[AdapterIdx][0]->GetCachePolicyObj() != NULL);
+
+    pGmmULTClientContext[AdapterIdx][0]->GetHeapStats(&Before);
+#if !GMM_HEAP_TRACK_STATS
+    // Not built in, allocations must not be accounted
+    EXPECT_EQ(0u, Before.Total.TotalObjects);
+    GmmDestroyModule(AdapterIdx, 0);
+    UnLoadGmmDll(AdapterIdx, 0);
+    return;
+#endif
+    EXPECT_GE(Before.Category[GMM_HEAP_CONTEXT].CurrentObjects, 2u);
+    EXPECT_GE(Before.Category[GMM_HEAP_CACHE_POLICY].CurrentObjects, 1u);
+
+    gmmParams.Type              = RESOURCE_2D;
+    gmmParams.Format            = GMM_FORMAT_R8G8B8A8_UNORM;
+    gmmParams.BaseWidth64       = 256;
+    gmmParams.BaseHeight        = 256;
+    gmmParams.Depth             = 1;
+    gmmParams.ArraySize         = 1;
+    gmmParams.Flags.Gpu.Texture = 1;
+    gmmParams.Flags.Info.Linear = 1;
+
+    GMM_RESOURCE_INFO *pResInfo = pGmmULTClientContext[AdapterIdx][0]->CreateResInfoObject(&gmmParams);
+    ASSERT_TRUE(pResInfo != NULL);
+    pGmmULTClientContext[AdapterIdx][0]->GetHeapStats(&After);
+    EXPECT_EQ(Before.Category[GMM_HEAP_RESOURCE_INFO].CurrentObjects + 1, After.Category[GMM_HEAP_RESOURCE_INFO].CurrentObjects);
+    EXPECT_GT(After.Category[GMM_HEAP_RESOURCE_INFO].CurrentBytes, Before.Category[GMM_HEAP_RESOURCE_INFO].CurrentBytes);
+    EXPECT_GE(After.Category[GMM_HEAP_RESOURCE_INFO].PeakObjects, After.Category[GMM_HEAP_RESOURCE_INFO].CurrentObjects);
+
+    pGmmULTClientContext[AdapterIdx][0]->DestroyResInfoObject(pResInfo);
+    pGmmULTClientContext[AdapterIdx][0]->GetHeapStats(&Freed);
+    EXPECT_EQ(Before.Category[GMM_HEAP_RESOURCE_INFO].CurrentObjects, Freed.Category[GMM_HEAP_RESOURCE_INFO].CurrentObjects);
+    EXPECT_EQ(Before.Category[GMM_HEAP_RESOURCE_INFO].CurrentBytes, Freed.Category[GMM_HEAP_RESOURCE_INFO].CurrentBytes);
+    EXPECT_GE(Freed.Category[GMM_HEAP_RESOURCE_INFO].PeakBytes, After.Category[GMM_HEAP_RESOURCE_INFO].CurrentBytes);
+
+    uint64_t Bytes = 0, Objects = 0;
+    for(uint32_t i = 0; i < GMM_HEAP_CATEGORY_MAX; i++)
+    {
+        Bytes += Freed.Category[i].CurrentBytes;
+        Objects += Freed.Category[i].CurrentObjects;
+    }
+    EXPECT_EQ(Freed.Total.CurrentBytes, Bytes);
+    EXPECT_EQ(Freed.Total.CurrentObjects, Objects);
+
+    GmmDestroyModule(AdapterIdx, 0);
+    UnLoadGmmDll(AdapterIdx, 0);
+}
+
+#define MAX_CLIENT_THREADS 8
+
+typedef struct ClientThreadParams_Rec
+{
+    PFNGMMINIT       pfnGmmInit;
+    PFNGMMDESTROY    pfnGmmDestroy;
+    GMM_INIT_IN_ARGS InArgs;
+    GMM_LIB_CONTEXT *pExpectedLibContext;
+    uint32_t         Iterations;
+    uint32_t         Failures;
+} ClientThreadParams;
+
+// Creates and destroys a client context on an adapter Iterations times
+static void *ClientThread(void *lpParam)
+{
+    ClientThreadParams *pParams = (ClientThreadParams *)lpParam;
+
+    for(uint32_t i = 0; i < pParams->Iterations; i++)
+    {
+        GMM_INIT_OUT_ARGS OutArgs = {};
+
+        if((pParams->pfnGmmInit(&pParams->InArgs, &OutArgs) != GMM_SUCCESS) || !OutArgs.pGmmClientContext)
+        {
+            pParams->Failures++;
+            continue;
+        }
+        if(OutArgs.pGmmClientContext->GetLibContext() != pParams->pExpectedLibContext)
+        {
+            pParams->Failures++;
+        }
+        pParams->pfnGmmDestroy(&OutArgs);
+    }
+
+    pthread_exit(NULL);
+}
+
+// Spawns NumThreads ClientThreads on an adapter whose LibContext is held by
+// Client 0 and returns the total number of failed iterations.
+static uint32_t RunClientThreads(uint32_t AdapterIdx, uint32_t NumThreads, uint32_t Iterations)
+{
+    pthread_t          ThreadId[MAX_CLIENT_THREADS];
+    ClientThreadParams Params[MAX_CLIENT_THREADS];
+    uint32_t           Failures = 0;
+    uint32_t           i;
+
+    for(i = 0; i < NumThreads; i++)
+    {
+        Params[i].pfnGmmInit          = MACommonULT::pfnGmmInit[AdapterIdx][0];
+        Params[i].pfnGmmDestroy       = MACommonULT::pfnGmmDestroy[AdapterIdx][0];
+        Params[i].InArgs              = MACommonULT::InArgs[AdapterIdx][0];
+        Params[i].pExpectedLibContext = MACommonULT::pLibContext[AdapterIdx][0];
+        Params[i].Iterations          = Iterations;
+        Params[i].Failures            = 0;
+        EXPECT_EQ(0, pthread_create(&ThreadId[i], NULL, ClientThread, (void *)&Params[i]));
+    }
+
+    for(i = 0; i < NumThreads; i++)
+    {
+        EXPECT_EQ(0, pthread_join(ThreadId[i], NULL));
+        Failures += Params[i].Failures;
+    }
+
+    return Failures;
+}
+
+// Clients created and destroyed concurrently on an active adapter take the
+// lock-free path and must all share the adapter's LibContext, which has to
+// survive them.
+TEST_F(CTestMA, TestMTClientContextOnActiveAdapter)
+{
+    const uint32_t AdapterIdx = 3;
+
+    LoadGmmDll(AdapterIdx, 0);
+    GmmInitModule(AdapterIdx, 0);
+
+    EXPECT_EQ(0u, RunClientThreads(AdapterIdx, MAX_CLIENT_THREADS, 200));
+
+    LoadGmmDll(AdapterIdx, 1);
+    GmmInitModule(AdapterIdx, 1);
+    EXPECT_EQ(pLibContext[AdapterIdx][0], pLibContext[AdapterIdx][1]);
+    GmmDestroyModule(AdapterIdx, 1);
+    UnLoadGmmDll(AdapterIdx, 1);
+
+    GmmDestroyModule(AdapterIdx, 0);
+    UnLoadGmmDll(AdapterIdx, 0);
+}
+
+typedef struct FirstClientThreadParams_Rec
+{
+    pthread_barrier_t *pBarrier;
+    GMM_INIT_IN_ARGS   InArgs;
+    GMM_INIT_OUT_ARGS  OutArgs;
+    GMM_STATUS         Status;
+} FirstClientThreadParams;
+
+static void *FirstClientThread(void *lpParam)
+{
+    FirstClientThreadParams *pParams = (FirstClientThreadParams *)lpParam;
+
+    pthread_barrier_wait(pParams->pBarrier);
+    pParams->Status = MACommonULT::pfnGmmInit[4][0](&pParams->InArgs, &pParams->OutArgs);
+
+    pthread_exit(NULL);
+}
+
+// Clients racing to open a new adapter wait for the one creating its LibContext
+// and must all end up on the same LibContext.
+TEST_F(CTestMA, TestMTCreateLibContextSameAdapter)
+{
+    const uint32_t          AdapterIdx = 4;
+    pthread_t               ThreadId[MAX_CLIENT_THREADS];
+    FirstClientThreadParams Params[MAX_CLIENT_THREADS];
+    pthread_barrier_t       Barrier;
+    uint32_t                i;
+
+    LoadGmmDll(AdapterIdx, 0);
+
+    // Only used to fill InArgs, the adapter is closed again before the race
+    GmmInitModule(AdapterIdx, 0);
+    GMM_INIT_IN_ARGS InArgsTemplate = InArgs[AdapterIdx][0];
+    ADAPTER_INFO     AdapterInfo    = *pGfxAdapterInfo[AdapterIdx][0];
+    GmmDestroyModule(AdapterIdx, 0);
+
+    InArgsTemplate.pGtSysInfo = &AdapterInfo.SystemInfo;
+    InArgsTemplate.pSkuTable  = &AdapterInfo.SkuTable;
+    InArgsTemplate.pWaTable   = &AdapterInfo.WaTable;
+
+    ASSERT_EQ(0, pthread_barrier_init(&Barrier, NULL, MAX_CLIENT_THREADS));
+    for(i = 0; i < MAX_CLIENT_THREADS; i++)
+    {
+        memset(&Params[i], 0, sizeof(Params[i]));
+        Params[i].pBarrier = &Barrier;
+        Params[i].InArgs   = InArgsTemplate;
+        ASSERT_EQ(0, pthread_create(&ThreadId[i], NULL, FirstClientThread, (void *)&Params[i]));
+    }
+    for(i = 0; i < MAX_CLIENT_THREADS; i++)
+    {
+        ASSERT_EQ(0, pthread_join(ThreadId[i], NULL));
+    }
+    pthread_barrier_destroy(&Barrier);
+
+    for(i = 0; i < MAX_CLIENT_THREADS; i++)
+    {
+        EXPECT_EQ(GMM_SUCCESS, Params[i].Status);
+        ASSERT_TRUE(Params[i].OutArgs.pGmmClientContext != NULL);
+        EXPECT_EQ(Params[0].OutArgs.pGmmClientContext->GetLibContext(), Params[i].OutArgs.pGmmClientContext->GetLibContext());
+        EXPECT_EQ(1u, Params[i].OutArgs.pGmmClientContext->GetLibContext()->GetInitStats().Phase[GMM_INIT_PHASE_INIT_CONTEXT].Count);
+    }
+
+    for(i = 0; i < MAX_CLIENT_THREADS; i++)
+    {
+        pfnGmmDestroy[AdapterIdx][0](&Params[i].OutArgs);
+    }
+
+    UnLoadGmmDll(AdapterIdx, 0);
+}
+
+// Client context create/destroy throughput on one active adapter as the number
+// of threads grows.
+// Run with --gtest_also_run_disabled_tests --gtest_filter=*ClientContextScaling*
+TEST_F(CTestMA, DISABLED_BenchmarkMTClientContextScaling)
+{
+    const uint32_t AdapterIdx = 3;
+    const uint32_t Iterations = 20000;
+
+    LoadGmmDll(AdapterIdx, 0);
+    GmmInitModule(AdapterIdx, 0);
+
+    for(uint32_t NumThreads = 1; NumThreads <= MAX_CLIENT_THREADS; NumThreads *= 2)
+    {
+        auto Start = std::chrono::steady_clock::now();
+        EXPECT_EQ(0u, RunClientThreads(AdapterIdx, NumThreads, Iterations));
+        auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count();
+
+        printf("%u thread(s): %llu client contexts in %lld us, %.1f ns/op per thread, %.0f ops/s\n", NumThreads,
+               (unsigned long long)NumThreads * Iterations, (long long)Elapsed / 1000,
+               (double)Elapsed / Iterations,
+               (double)NumThreads * Iterations * 1e9 / Elapsed);
+    }
+
+    GmmDestroyModule(AdapterIdx, 0);
+    UnLoadGmmDll(AdapterIdx, 0);
+}
+
+#if GMM_CONTEXT_LAZY_INIT
+#define MAX_LAZY_INIT_THREADS 8
+
+typedef struct LazyInitThreadParams_Rec
+{
+    GMM_LIB_CONTEXT *         pLibContext;
+    GMM_CACHE_POLICY *        pCachePolicy;
+    GMM_TEXTURE_CALC *        pTextureCalc;
+    GMM_CACHE_POLICY_ELEMENT *pCachePolicyUsage;
+} LazyInitThreadParams;
+
+static void *LazyInitThread(void *lpParam)
+{
+    LazyInitThreadParams *pParams = (LazyInitThreadParams *)lpParam;
+
+    pParams->pTextureCalc      = pParams->pLibContext->GetTextureCalc();
+    pParams->pCachePolicy      = pParams->pLibContext->GetCachePolicyObj();
+    pParams->pCachePolicyUsage = pParams->pLibContext->GetCachePolicyUsage();
+
+    pthread_exit(NULL);
+}
+
+// Subsystems of a fresh LibContext are built on first use. Threads racing on the
+// first access must all observe the same, fully built objects.
+TEST_F(CTestMA, TestLazyInitMT)
+{
+    const uint32_t       AdapterIdx = 2;
+    pthread_t            ThreadId[MAX_LAZY_INIT_THREADS];
+    LazyInitThreadParams Params[MAX_LAZY_INIT_THREADS];
+    GMM_CACHE_POLICY_ELEMENT *pRefCachePolicy;
+    uint32_t             i;
+
+    pRefCachePolicy = (GMM_CACHE_POLICY_ELEMENT *)calloc(GMM_RESOURCE_USAGE_MAX, sizeof(GMM_CACHE_POLICY_ELEMENT));
+    ASSERT_TRUE(pRefCachePolicy);
+
+    LoadGmmDll(AdapterIdx, 0);
+
+    // Reference tables from a single threaded first access
+    GmmInitModule(AdapterIdx, 0);
+    memcpy(pRefCachePolicy, pLibContext[AdapterIdx][0]->GetCachePolicyUsage(), GMM_RESOURCE_USAGE_MAX * sizeof(GMM_CACHE_POLICY_ELEMENT));
+    GmmDestroyModule(AdapterIdx, 0);
+
+    GmmInitModule(AdapterIdx, 0);
+    for(i = 0; i < MAX_LAZY_INIT_THREADS; i++)
+    {
+        memset(&Params[i], 0, sizeof(Params[i]));
+        Params[i].pLibContext = pLibContext[AdapterIdx][0];
+        ASSERT_EQ(0, pthread_create(&ThreadId[i], NULL, LazyInitThread, (void *)&Params[i]));
+    }
+
+    for(i = 0; i < MAX_LAZY_INIT_THREADS; i++)
+    {
+        ASSERT_EQ(0, pthread_join(ThreadId[i], NULL));
+    }
+
+    for(i = 0; i < MAX_LAZY_INIT_THREADS; i++)
+    {
+        EXPECT_TRUE(Params[i].pCachePolicy != NULL);
+        EXPECT_TRUE(Params[i].pTextureCalc != NULL);
+        EXPECT_EQ(Params[0].pCachePolicy, Params[i].pCachePolicy);
+        EXPECT_EQ(Params[0].pTextureCalc, Params[i].pTextureCalc);
+        EXPECT_EQ(Params[0].pCachePolicyUsage, Params[i].pCachePolicyUsage);
+    }
+    EXPECT_EQ(0, memcmp(pRefCachePolicy, Params[0].pCachePolicyUsage, GMM_RESOURCE_USAGE_MAX * sizeof(GMM_CACHE_POLICY_ELEMENT)));
+    GmmDestroyModule(AdapterIdx, 0);
+
+    UnLoadGmmDll(AdapterIdx, 0);
+    free(pRefCachePolicy);
+}
+
+// Startup cost of a query-only client, which never touches the cache policy or
+// texture calculator, against a client that creates a resource right away.
+// Run with --gtest_also_run_disabled_tests --gtest_filter=*LazyInitStartup*
+TEST_F(CTestMA, DISABLED_BenchmarkLazyInitStartup)
+{
+    const uint32_t       AdapterIdx = 2;
+    const uint32_t       Iterations = 1000;
+    GMM_RESCREATE_PARAMS gmmParams  = {};
+    uint32_t             i;
+
+    gmmParams.Type              = RESOURCE_2D;
+    gmmParams.Format            = GMM_FORMAT_R8G8B8A8_UNORM;
+    gmmParams.BaseWidth64       = 256;
+    gmmParams.BaseHeight        = 256;
+    gmmParams.Depth             = 1;
+    gmmParams.ArraySize         = 1;
+    gmmParams.Flags.Gpu.Texture = 1;
+    gmmParams.Flags.Info.Linear = 1;
+
+    LoadGmmDll(AdapterIdx, 0);
+
+    auto Start = std::chrono::steady_clock::now();
+    for(i = 0; i < Iterations; i++)
+    {
+        GmmInitModule(AdapterIdx, 0);
+        pLibContext[AdapterIdx][0]->GetPlatformInfo();
+        GmmDestroyModule(AdapterIdx, 0);
+    }
+    auto QueryOnly = std::chrono::steady_clock::now() - Start;
+
+    Start = std::chrono::steady_clock::now();
+    for(i = 0; i < Iterations; i++)
+    {
+        GmmInitModule(AdapterIdx, 0);
+        GMM_RESOURCE_INFO *pResInfo = pGmmULTClientContext[AdapterIdx][0]->CreateResInfoObject(&gmmParams);
+        EXPECT_TRUE(pResInfo != NULL);
+        pGmmULTClientContext[AdapterIdx][0]->DestroyResInfoObject(pResInfo);
+        GmmDestroyModule(AdapterIdx, 0);
+    }
+    auto CreateHeavy = std::chrono::steady_clock::now() - Start;
+
+    UnLoadGmmDll(AdapterIdx, 0);
+
+    printf("Init+Destroy x%u: query-only %lld us, create-heavy %lld us\n", Iterations,
+           (long long)std::chrono::duration_cast<std::chrono::microseconds>(QueryOnly).count(),
+           (long long)std::chrono::duration_cast<std::chrono::microseconds>(CreateHeavy).count());
+}
+#endif // GMM_CONTEXT_LAZY_INIT
+#endif
+
 #endif // GMM_LIB_DLL_MA
 
@@ -3495,3 +3495,107 @@ TEST_F(CTestResource, TestCompressedSurface)
 
     pGmmULTClientContext->DestroyResInfoObject(ResourceInfo);
 }
+
+/// @brief ULT for resource size breakdown and client context resource mem stats
+TEST_F(CTestResource, TestResourceSizeInfo)
+{
+    GMM_RESOURCE_SIZE_INFO SizeInfo;
+    GMM_RESOURCE_MEM_STATS Before, After;
+    GMM_RESCREATE_PARAMS   gmmParams = {};
+
+    // Linear: only pitch and page padding on top of the texels
+    gmmParams.Type              = RESOURCE_2D;
+    gmmParams.Format            = GMM_FORMAT_GENERIC_32BIT;
+    gmmParams.Flags.Gpu.Texture = 1;
+    gmmParams.BaseWidth64       = 100;
+    gmmParams.BaseHeight        = 100;
+    gmmParams.Depth             = 1;
+    gmmParams.Flags.Info.Linear = 1;
+
+    pGmmULTClientContext->GetResourceMemStats(&Before);
+
+    GMM_RESOURCE_INFO *ResourceInfo = pGmmULTClientContext->CreateResInfoObject(&gmmParams);
+    ASSERT_TRUE(ResourceInfo != NULL);
+    // Called non-virtually: GetSizeInfo() follows OverridePlatform() in the vtable, which
+    // Debug ULTs declare and the Linux lib (built without _DEBUG) doesn't
+    ResourceInfo->GmmLib::GmmResourceInfoCommon::GetSizeInfo(&SizeInfo);
+
+    EXPECT_EQ(RESOURCE_2D, SizeInfo.Type);
+    EXPECT_EQ(GMM_FORMAT_GENERIC_32BIT, SizeInfo.Format);
+    EXPECT_EQ(100u * 100u * 4u, SizeInfo.LogicalSize);
+    EXPECT_EQ(ResourceInfo->GetSizeMainSurface(), SizeInfo.MainSurfaceSize);
+    EXPECT_EQ(SizeInfo.MainSurfaceSize, SizeInfo.LogicalSize + SizeInfo.AlignPadding + SizeInfo.MipTailPadding + SizeInfo.LayoutPadding);
+    EXPECT_GT(SizeInfo.LayoutPadding, 0u);
+    EXPECT_EQ(0u, SizeInfo.MipTailPadding);
+    EXPECT_EQ(0u, SizeInfo.AuxSize + SizeInfo.ClearColorSize + SizeInfo.AuxPadding);
+    EXPECT_EQ(ResourceInfo->GetSizeAllocation(), SizeInfo.AllocationSize);
+    EXPECT_EQ(SizeInfo.AllocationSize, SizeInfo.MainSurfaceSize + SizeInfo.PageSizePadding);
+
+    // Added to the context's totals and histograms, copies are not
+    GMM_RESOURCE_INFO *CopyInfo = pGmmULTClientContext->CopyResInfoObject(ResourceInfo);
+    ASSERT_TRUE(CopyInfo != NULL);
+    pGmmULTClientContext->DestroyResInfoObject(CopyInfo);
+
+    pGmmULTClientContext->GetResourceMemStats(&After);
+    EXPECT_EQ(Before.Total.Count + 1, After.Total.Count);
+    EXPECT_EQ(Before.Total.LogicalSize + SizeInfo.LogicalSize, After.Total.LogicalSize);
+    EXPECT_EQ(Before.Total.AllocationSize + SizeInfo.AllocationSize, After.Total.AllocationSize);
+    EXPECT_GE(After.PeakAllocationSize, After.Total.AllocationSize);
+    EXPECT_EQ(Before.Type[RESOURCE_2D].Count + 1, After.Type[RESOURCE_2D].Count);
+    EXPECT_EQ(Before.Format[GMM_FORMAT_GENERIC_32BIT].Count + 1, After.Format[GMM_FORMAT_GENERIC_32BIT].Count);
+    EXPECT_EQ(Before.TileMode[SizeInfo.TileMode].AllocationSize + SizeInfo.AllocationSize, After.TileMode[SizeInfo.TileMode].AllocationSize);
+    EXPECT_EQ(Before.Breakdown.LayoutPadding + SizeInfo.LayoutPadding, After.Breakdown.LayoutPadding);
+
+    pGmmULTClientContext->DestroyResInfoObject(ResourceInfo);
+    pGmmULTClientContext->GetResourceMemStats(&After);
+    EXPECT_EQ(Before.Total.Count, After.Total.Count);
+    EXPECT_EQ(Before.Total.AllocationSize, After.Total.AllocationSize);
+    EXPECT_EQ(Before.Format[GMM_FORMAT_GENERIC_32BIT].Count, After.Format[GMM_FORMAT_GENERIC_32BIT].Count);
+    EXPECT_EQ(Before.Breakdown.LogicalSize, After.Breakdown.LogicalSize);
+
+    // Many live resources destroyed out of creation order still take out what they added
+    const uint32_t     NumRes = 300;
+    GMM_RESOURCE_INFO *pRes[NumRes];
+
+    for(uint32_t i = 0; i < NumRes; i++)
+    {
+        gmmParams.BaseWidth64 = 64 + i;
+        pRes[i]               = pGmmULTClientContext->CreateResInfoObject(&gmmParams);
+        ASSERT_TRUE(pRes[i] != NULL);
+    }
+    pGmmULTClientContext->GetResourceMemStats(&After);
+    EXPECT_EQ(Before.Total.Count + NumRes, After.Total.Count);
+
+    for(uint32_t i = 0; i < NumRes; i += 2)
+    {
+        pGmmULTClientContext->DestroyResInfoObject(pRes[i]);
+    }
+    pGmmULTClientContext->GetResourceMemStats(&After);
+    EXPECT_EQ(Before.Total.Count + NumRes / 2, After.Total.Count);
+
+    for(uint32_t i = NumRes - 1; i < NumRes; i -= 2)
+    {
+        pGmmULTClientContext->DestroyResInfoObject(pRes[i]);
+    }
+    pGmmULTClientContext->GetResourceMemStats(&After);
+    EXPECT_EQ(Before.Total.Count, After.Total.Count);
+    EXPECT_EQ(Before.Total.AllocationSize, After.Total.AllocationSize);
+    EXPECT_EQ(Before.Breakdown.LayoutPadding, After.Breakdown.LayoutPadding);
+
+    // Compressed: logical size counts blocks, tile-aligned BC1 256x256 has no padding
+    gmmParams                   = {};
+    gmmParams.Type              = RESOURCE_2D;
+    gmmParams.Format            = GMM_FORMAT_BC1_UNORM;
+    gmmParams.Flags.Gpu.Texture = 1;
+    gmmParams.BaseWidth64       = 0x100;
+    gmmParams.BaseHeight        = 0x100;
+    gmmParams.Depth             = 1;
+    SetTileFlag(gmmParams, TEST_TILEY);
+
+    ResourceInfo = pGmmULTClientContext->CreateResInfoObject(&gmmParams);
+    ASSERT_TRUE(ResourceInfo != NULL);
+    ResourceInfo->GmmLib::GmmResourceInfoCommon::GetSizeInfo(&SizeInfo);
+    EXPECT_EQ(64u * 64u * 8u, SizeInfo.LogicalSize);
+    EXPECT_EQ(SizeInfo.LogicalSize, SizeInfo.MainSurfaceSize);
+    pGmmULTClientContext->DestroyResInfoObject(ResourceInfo);
+}
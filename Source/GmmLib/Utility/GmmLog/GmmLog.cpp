@@ -279,7 +279,7 @@ extern "C" void GMM_STDCALL GmmLibLogging(GmmLogLevel Level, const char *str, ..
         const size_t length = vscprintf_lin(str, args);
 #endif
 
-        char *temp = new char[length + 1];
+        char *temp = GmmMemAllocator::NewArray<char>(NULL, length + 1, GMM_HEAP_LOG);
 
         if(temp)
         {
@@ -309,7 +309,7 @@ extern "C" void GMM_STDCALL GmmLibLogging(GmmLogLevel Level, const char *str, ..
                     break;
             }
 
-            delete[] temp;
+            GmmMemAllocator::DeleteArray(temp);
         }
     }
 
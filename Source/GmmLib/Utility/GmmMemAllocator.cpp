@@ -0,0 +1,390 @@
+/*==============================================================================
+Copyright(c) 2017 Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files(the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and / or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+============================================================================*/
+
+#include "Internal/Common/GmmLibInc.h"
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @file GmmMemAllocator.cpp
+/// @brief GmmMemAllocator block allocation. Blocks carry no header: plain blocks are
+///        what malloc returned, so modules built against older GmmLib headers can
+///        still free() them. Blocks from a client allocator, arrays and, with
+///        GMM_HEAP_TRACK_STATS, every block are recorded in a table private to this
+///        module, which FreeMem() consults to release them where they came from.
+/////////////////////////////////////////////////////////////////////////////////////
+
+// Per-category heap stats cost a table record on every allocation, so they are only
+// built with '-DGMM_HEAP_TRACK_STATS=TRUE' passed to cmake.
+#ifndef GMM_HEAP_TRACK_STATS
+#define GMM_HEAP_TRACK_STATS 0
+#endif
+
+#define GMM_ALLOC_ALIGNMENT         16                  // Alignment requested from client allocator
+#define GMM_HEAP_BLOCKS_MIN         64                  // Initial table size
+#define GMM_HEAP_BLOCK_DELETED      ((void *)1)         // Removed record, keeps probe chains intact
+
+typedef struct GMM_HEAP_BLOCK_REC
+{
+    void *                 ptr;         // NULL if slot unused
+    PFN_ClientFreeFunction pfnFree;     // NULL if malloc'ed
+    void *                 pUserData;
+    size_t                 Size;        // Requested size
+    uint64_t               Seq;         // Allocation sequence number
+    uint32_t               Category;    // GMM_HEAP_CATEGORY
+    uint32_t               Count;       // Elements, for NewArray
+} GMM_HEAP_BLOCK;
+
+static struct
+{
+    GMM_HEAP_STATS  Stats;
+    uint32_t        Lock;               // Spin lock for the table
+    GMM_HEAP_BLOCK *pBlocks;            // Open addressing, MaxBlocks is power of 2
+    uint32_t        MaxBlocks;
+    uint32_t        NumBlocks;          // Recorded blocks
+    uint32_t        NumUsed;            // Recorded and deleted slots
+} GmmHeap;
+
+static void __GmmLockHeap()
+{
+#if _WIN32
+    while(InterlockedExchange((LONG *)&GmmHeap.Lock, 1))
+#else
+    while(__sync_lock_test_and_set(&GmmHeap.Lock, 1))
+#endif
+    {
+    }
+}
+
+static void __GmmUnlockHeap()
+{
+#if _WIN32
+    InterlockedExchange((LONG *)&GmmHeap.Lock, 0);
+#else
+    __sync_lock_release(&GmmHeap.Lock);
+#endif
+}
+
+#if GMM_HEAP_TRACK_STATS
+static uint64_t __GmmUpdateHeapStats(GMM_HEAP_CATEGORY_STATS *pStats, int64_t Bytes, int64_t Objects)
+{
+    uint64_t Total = 0;
+
+    GmmMemAllocator::AtomicMax64(&pStats->PeakBytes, GmmMemAllocator::AtomicAdd64(&pStats->CurrentBytes, Bytes));
+    GmmMemAllocator::AtomicMax64(&pStats->PeakObjects, GmmMemAllocator::AtomicAdd64(&pStats->CurrentObjects, Objects));
+    if(Objects > 0)
+    {
+        Total = GmmMemAllocator::AtomicAdd64(&pStats->TotalObjects, Objects);
+    }
+    return Total;
+}
+#endif
+
+//=============================================================================
+//
+// Function: __GmmFindHeapBlock
+//
+// Desc: Looks up ptr in the block table, caller holds the lock.
+//
+// Returns:
+//      Slot recording ptr, or first free/deleted slot on its probe chain (ptr
+//      not recorded). NULL if neither (table full of deleted slots or unallocated).
+//-----------------------------------------------------------------------------
+static GMM_HEAP_BLOCK *__GmmFindHeapBlock(void *ptr)
+{
+    GMM_HEAP_BLOCK *pFree = NULL;
+    uint32_t        Mask  = GmmHeap.MaxBlocks - 1;
+    uint32_t        Idx   = (uint32_t)((((uint64_t)(uintptr_t)ptr >> 4) * 0x9E3779B97F4A7C15ULL) >> 32);
+
+    for(uint32_t n = 0; n < GmmHeap.MaxBlocks; n++)
+    {
+        GMM_HEAP_BLOCK *pBlock = &GmmHeap.pBlocks[(Idx + n) & Mask];
+
+        if(pBlock->ptr == ptr)
+        {
+            return pBlock;
+        }
+        if(pBlock->ptr == GMM_HEAP_BLOCK_DELETED)
+        {
+            pFree = pFree ? pFree : pBlock;
+        }
+        else if(!pBlock->ptr)
+        {
+            return pFree ? pFree : pBlock;
+        }
+    }
+    return pFree;
+}
+
+//=============================================================================
+//
+// Function: __GmmGrowHeapBlocks
+//
+// Desc: Rehashes block table into a table twice the size (same size if it's
+//       mostly deleted slots), caller holds the lock.
+//
+// Returns:
+//      false if out of memory
+//-----------------------------------------------------------------------------
+static bool __GmmGrowHeapBlocks()
+{
+    GMM_HEAP_BLOCK *pOld    = GmmHeap.pBlocks;
+    uint32_t        OldMax  = GmmHeap.MaxBlocks;
+    uint32_t        NewMax  = GFX_MAX(GMM_HEAP_BLOCKS_MIN, (GmmHeap.NumBlocks * 4 >= OldMax) ? OldMax * 2 : OldMax);
+    GMM_HEAP_BLOCK *pNew    = (GMM_HEAP_BLOCK *)calloc(NewMax, sizeof(GMM_HEAP_BLOCK));
+
+    if(!pNew)
+    {
+        return false;
+    }
+
+    GmmHeap.pBlocks   = pNew;
+    GmmHeap.MaxBlocks = NewMax;
+    GmmHeap.NumUsed   = GmmHeap.NumBlocks;
+
+    for(uint32_t i = 0; i < OldMax; i++)
+    {
+        if(pOld[i].ptr && (pOld[i].ptr != GMM_HEAP_BLOCK_DELETED))
+        {
+            *__GmmFindHeapBlock(pOld[i].ptr) = pOld[i];
+        }
+    }
+    free(pOld);
+
+    return true;
+}
+
+//=============================================================================
+//
+// Function: __GmmRemoveHeapBlock
+//
+// Desc: Removes record of ptr from block table, if any. Caller holds the lock.
+//
+// Parameters:
+//      ptr: Block
+//      pBlock: Returns removed record
+//
+// Returns:
+//      true if ptr was recorded
+//-----------------------------------------------------------------------------
+static bool __GmmRemoveHeapBlock(void *ptr, GMM_HEAP_BLOCK *pBlock)
+{
+    GMM_HEAP_BLOCK *pSlot = GmmHeap.NumBlocks ? __GmmFindHeapBlock(ptr) : NULL;
+
+    if(!pSlot || (pSlot->ptr != ptr))
+    {
+        return false;
+    }
+
+    *pBlock    = *pSlot;
+    pSlot->ptr = GMM_HEAP_BLOCK_DELETED;
+    GmmHeap.NumBlocks--;
+
+#if GMM_HEAP_TRACK_STATS
+    __GmmUpdateHeapStats(&GmmHeap.Stats.Category[pBlock->Category], -(int64_t)pBlock->Size, -1);
+    __GmmUpdateHeapStats(&GmmHeap.Stats.Total, -(int64_t)pBlock->Size, -1);
+#endif
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Allocates Size bytes from pAllocatorCb or malloc. Blocks from pAllocatorCb, with
+/// Count other than 1 or, with GMM_HEAP_TRACK_STATS, any block are recorded so
+/// FreeMem()/GetArrayCount() can find out about them.
+///
+/// @param[in]  pAllocatorCb: Client heap hooks, NULL selects malloc
+/// @param[in]  Size: Bytes requested
+/// @param[in]  Category: What the block is used for, for heap stats
+/// @param[in]  Count: Elements, returned by GetArrayCount
+/// @return     Block, NULL if out of memory
+/////////////////////////////////////////////////////////////////////////////////////
+void *GMM_STDCALL GmmMemAllocator::AllocMem(const GmmClientAllocationCallbacks *pAllocatorCb, size_t Size,
+                                            GMM_HEAP_CATEGORY Category, uint32_t Count)
+{
+    GMM_HEAP_BLOCK Block = {0};
+
+    if(pAllocatorCb && pAllocatorCb->pfnAllocation)
+    {
+        Block.ptr       = pAllocatorCb->pfnAllocation(pAllocatorCb->pUserData, (uint32_t)Size, GMM_ALLOC_ALIGNMENT);
+        Block.pfnFree   = pAllocatorCb->pfnFree;
+        Block.pUserData = pAllocatorCb->pUserData;
+    }
+    else
+    {
+        Block.ptr = malloc(Size);
+    }
+
+    if(!Block.ptr || (!GMM_HEAP_TRACK_STATS && !Block.pfnFree && (Count == 1)))
+    {
+        return Block.ptr;
+    }
+
+    Block.Size     = Size;
+    Block.Category = Category;
+    Block.Count    = Count;
+
+    __GmmLockHeap();
+
+    GMM_HEAP_BLOCK Stale;
+    GMM_HEAP_BLOCK *pSlot = NULL;
+
+    // Plain block free()'d by a module built against older headers leaves its record behind
+    __GmmRemoveHeapBlock(Block.ptr, &Stale);
+
+    if(((GmmHeap.NumUsed + 1) * 4 <= GmmHeap.MaxBlocks * 3) || __GmmGrowHeapBlocks())
+    {
+        pSlot = __GmmFindHeapBlock(Block.ptr);
+    }
+
+    if(pSlot)
+    {
+#if GMM_HEAP_TRACK_STATS
+        __GmmUpdateHeapStats(&GmmHeap.Stats.Category[Category], (int64_t)Size, 1);
+        Block.Seq = __GmmUpdateHeapStats(&GmmHeap.Stats.Total, (int64_t)Size, 1);
+#endif
+        GmmHeap.NumUsed += pSlot->ptr ? 0 : 1;
+        GmmHeap.NumBlocks++;
+        *pSlot = Block;
+    }
+
+    __GmmUnlockHeap();
+
+    if(!pSlot)
+    {
+        if(Block.pfnFree)
+        {
+            Block.pfnFree(Block.pUserData, Block.ptr);
+        }
+        else
+        {
+            free(Block.ptr);
+        }
+        return NULL;
+    }
+
+    return Block.ptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Frees block from AllocMem() back to where it came from. Unrecorded blocks are
+/// malloc'ed ones.
+///
+/// @param[in]  ptr: Block, may be NULL
+/////////////////////////////////////////////////////////////////////////////////////
+void GMM_STDCALL GmmMemAllocator::FreeMem(void *ptr)
+{
+    GMM_HEAP_BLOCK Block    = {0};
+    bool           Recorded = false;
+
+    if(!ptr)
+    {
+        return;
+    }
+
+    // Recorded block outlives this call's check, nothing to look up if table is empty
+    if(*(volatile uint32_t *)&GmmHeap.NumBlocks)
+    {
+        __GmmLockHeap();
+        Recorded = __GmmRemoveHeapBlock(ptr, &Block);
+        __GmmUnlockHeap();
+    }
+
+    if(Recorded && Block.pfnFree)
+    {
+        Block.pfnFree(Block.pUserData, ptr);
+    }
+    else
+    {
+        free(ptr);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Returns Count passed to AllocMem() for the block at ptr
+/////////////////////////////////////////////////////////////////////////////////////
+uint32_t GMM_STDCALL GmmMemAllocator::GetArrayCount(void *ptr)
+{
+    uint32_t Count = 1;
+
+    if(*(volatile uint32_t *)&GmmHeap.NumBlocks)
+    {
+        __GmmLockHeap();
+        GMM_HEAP_BLOCK *pSlot = __GmmFindHeapBlock(ptr);
+        if(pSlot && (pSlot->ptr == ptr))
+        {
+            Count = pSlot->Count;
+        }
+        __GmmUnlockHeap();
+    }
+
+    return Count;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Returns this module's heap stats, all zero unless GMM_HEAP_TRACK_STATS
+/////////////////////////////////////////////////////////////////////////////////////
+void GmmMemAllocator::GetHeapStats(GMM_HEAP_STATS *pStats)
+{
+#if GMM_HEAP_TRACK_STATS
+    *pStats = GmmHeap.Stats;
+#else
+    memset(pStats, 0, sizeof(*pStats));
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Copies up to MaxBlocks outstanding blocks, in no particular order. Only tracked
+/// with GMM_HEAP_TRACK_STATS.
+///
+/// @param[out] pBlocks: Outstanding blocks
+/// @param[in]  MaxBlocks: Entries in pBlocks
+/// @return     Number of outstanding blocks, may exceed MaxBlocks
+/////////////////////////////////////////////////////////////////////////////////////
+uint32_t GmmMemAllocator::GetOutstandingBlocks(GMM_HEAP_BLOCK_INFO *pBlocks, uint32_t MaxBlocks)
+{
+    uint32_t Count = 0;
+
+#if GMM_HEAP_TRACK_STATS
+    __GmmLockHeap();
+    for(uint32_t i = 0; i < GmmHeap.MaxBlocks; i++)
+    {
+        GMM_HEAP_BLOCK *pBlock = &GmmHeap.pBlocks[i];
+
+        if(!pBlock->ptr || (pBlock->ptr == GMM_HEAP_BLOCK_DELETED))
+        {
+            continue;
+        }
+        if(Count < MaxBlocks)
+        {
+            pBlocks[Count].ptr      = pBlock->ptr;
+            pBlocks[Count].Size     = pBlock->Size;
+            pBlocks[Count].Seq      = pBlock->Seq;
+            pBlocks[Count].Category = pBlock->Category;
+        }
+        Count++;
+    }
+    __GmmUnlockHeap();
+#else
+    GMM_UNREFERENCED_PARAMETER(pBlocks);
+    GMM_UNREFERENCED_PARAMETER(MaxBlocks);
+#endif
+
+    return Count;
+}
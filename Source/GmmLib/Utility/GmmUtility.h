@@ -38,8 +38,6 @@ namespace GmmLib
 #endif
 
 #ifndef __GMM_KMD__
-    #define GMM_MALLOC(size)    malloc(size)
-    #define GMM_FREE(p)         free(p)
 
 #define GMM_COMPR_FORMAT_INVALID(pGmmLibContext)                                                                          \
      ((pGmmLibContext->GetSkuTable().FtrFlatPhysCCS != 0)    ? static_cast<uint8_t>(GMM_FLATCCS_FORMAT_INVALID) :          \
@@ -47,6 +47,18 @@ namespace GmmLib
                 return CurrentMaxSpecialMocsIndex;
             }
 
+            void GetCachePolicyState(GMM_CACHE_POLICY_STATE *pState)
+            {
+                GmmGen10CachePolicy::GetCachePolicyState(pState);
+                pState->CurrentMaxSpecialMocsIndex = CurrentMaxSpecialMocsIndex;
+            }
+
+            void SetCachePolicyState(const GMM_CACHE_POLICY_STATE *pState)
+            {
+                GmmGen10CachePolicy::SetCachePolicyState(pState);
+                CurrentMaxSpecialMocsIndex = pState->CurrentMaxSpecialMocsIndex;
+            }
+
             int32_t IsSpecialMOCSUsage(GMM_RESOURCE_USAGE_TYPE Usage, bool &UpdateMOCS);
 
             /* Function prototypes */
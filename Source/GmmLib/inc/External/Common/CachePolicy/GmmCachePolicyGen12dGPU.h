@@ -45,6 +45,18 @@ namespace GmmLib
             {
             }
 
+            void GetCachePolicyState(GMM_CACHE_POLICY_STATE *pState)
+            {
+                GmmGen12CachePolicy::GetCachePolicyState(pState);
+                pState->CurrentMaxPATIndex = CurrentMaxPATIndex;
+            }
+
+            void SetCachePolicyState(const GMM_CACHE_POLICY_STATE *pState)
+            {
+                GmmGen12CachePolicy::SetCachePolicyState(pState);
+                CurrentMaxPATIndex = pState->CurrentMaxPATIndex;
+            }
+
             /* Function prototypes */
             GMM_STATUS InitCachePolicy();
             void       SetUpMOCSTable();
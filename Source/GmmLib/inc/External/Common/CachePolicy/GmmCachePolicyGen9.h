@@ -44,6 +44,20 @@ namespace GmmLib
             {
             }
 
+            void GetCachePolicyState(GMM_CACHE_POLICY_STATE *pState)
+            {
+                GmmGen8CachePolicy::GetCachePolicyState(pState);
+                pState->CurrentMaxMocsIndex      = CurrentMaxMocsIndex;
+                pState->CurrentMaxL1HdcMocsIndex = CurrentMaxL1HdcMocsIndex;
+            }
+
+            void SetCachePolicyState(const GMM_CACHE_POLICY_STATE *pState)
+            {
+                GmmGen8CachePolicy::SetCachePolicyState(pState);
+                CurrentMaxMocsIndex      = pState->CurrentMaxMocsIndex;
+                CurrentMaxL1HdcMocsIndex = pState->CurrentMaxL1HdcMocsIndex;
+            }
+
             /* Function prototypes */
             GMM_STATUS InitCachePolicy();
             GMM_STATUS SetupPAT();
@@ -47,6 +47,18 @@ namespace GmmLib
             {
             }
 
+            void GetCachePolicyState(GMM_CACHE_POLICY_STATE *pState)
+            {
+                GmmGen12CachePolicy::GetCachePolicyState(pState);
+                pState->CurrentMaxPATIndex = CurrentMaxPATIndex;
+            }
+
+            void SetCachePolicyState(const GMM_CACHE_POLICY_STATE *pState)
+            {
+                GmmGen12CachePolicy::SetCachePolicyState(pState);
+                CurrentMaxPATIndex = pState->CurrentMaxPATIndex;
+            }
+
             /* Function prototypes */
             GMM_STATUS InitCachePolicy();
             uint32_t GMM_STDCALL CachePolicyGetPATIndex(GMM_RESOURCE_INFO *pResInfo, GMM_RESOURCE_USAGE_TYPE Usage, bool *pCompressionEnable, bool IsCpuCacheable);
@@ -35,6 +35,25 @@ OTHER DEALINGS IN THE SOFTWARE.
 /// @file GmmCachePolicyCommon.h
 /// @brief This file contains Gmm Cache Policy functions
 /////////////////////////////////////////////////////////////////////////////////////
+
+//===========================================================================
+// typedef:
+//      GMM_CACHE_POLICY_STATE
+//
+// Description:
+//      Scalar bookkeeping of the gen specific cache policy objects which is
+//      produced by InitCachePolicy() alongside the context owned MOCS/PAT
+//      tables. Used to save/restore a fully initialized cache policy.
+//----------------------------------------------------------------------------
+typedef struct GMM_CACHE_POLICY_STATE_REC
+{
+    uint32_t NumPATRegisters;
+    uint32_t CurrentMaxMocsIndex;
+    uint32_t CurrentMaxL1HdcMocsIndex;
+    uint32_t CurrentMaxSpecialMocsIndex;
+    uint32_t CurrentMaxPATIndex;
+} GMM_CACHE_POLICY_STATE;
+
 namespace GmmLib
 {
     /////////////////////////////////////////////////////////////////////////
@@ -99,6 +118,27 @@ namespace GmmLib
             virtual ~GmmCachePolicyCommon()
             {
             }
+
+            /////////////////////////////////////////////////////////////////////////
+            /// Saves the object's InitCachePolicy() bookkeeping into pState.
+            /// Gen specific classes hide this and chain to their base to fill in
+            /// their members. Non-virtual so the public vtable is unchanged, callers
+            /// cast to the class Context::CreateCachePolicyCommon() created.
+            /// @param[out]  pState: state to be filled
+            /////////////////////////////////////////////////////////////////////////
+            void GetCachePolicyState(GMM_CACHE_POLICY_STATE *pState)
+            {
+                pState->NumPATRegisters = NumPATRegisters;
+            }
+
+            /////////////////////////////////////////////////////////////////////////
+            /// Restores the bookkeeping previously saved by GetCachePolicyState()
+            /// @param[in]  pState: state to be restored
+            /////////////////////////////////////////////////////////////////////////
+            void SetCachePolicyState(const GMM_CACHE_POLICY_STATE *pState)
+            {
+                NumPATRegisters = pState->NumPATRegisters;
+            }
             virtual uint32_t GMM_STDCALL CachePolicyGetPATIndex(GMM_RESOURCE_INFO *pResInfo, GMM_RESOURCE_USAGE_TYPE Usage, bool *pCompressionEnable, bool IsCpuCacheable);
             uint32_t GMM_STDCALL CachePolicyGetNumPATRegisters();
 
@@ -24,29 +24,6 @@ OTHER DEALINGS IN THE SOFTWARE.
 #include "GmmCommonExt.h"
 #include "GmmInfo.h"
 
-//////////////////////////////////////////////////////////////////
-// Memory Allocators and DeAllocators for Gmm Create Objects
-// This is needed for Clients who want to construct using their
-// own memory allocators
-//////////////////////////////////////////////////////////////////
-typedef void* (GMM_STDCALL *PFN_ClientAllocationFunction)(
-    void*                                       pUserData,
-    uint32_t                                    size,
-    uint32_t                                    alignment);
-
-typedef void (GMM_STDCALL *PFN_ClientFreeFunction)(
-    void*                                       pUserData,
-    void*                                       pMemory);
-
-typedef struct _GmmClientAllocationCallbacks_
-{
-    void*                                   pUserData;
-    uint32_t                                size;
-    uint32_t                                alignment;
-    PFN_ClientAllocationFunction            pfnAllocation;
-    PFN_ClientFreeFunction                  pfnFree;
-} GmmClientAllocationCallbacks;
-
 //===========================================================================
 // typedef:
 //      GMM_DEVICE_OPERATION
@@ -62,6 +39,8 @@ typedef struct _GMM_DEVICE_INFO_REC
 #ifdef __cplusplus
 #include "GmmMemAllocator.hpp"
 
+struct GMM_RESOURCE_MEM_TRACKER_REC;
+
 /////////////////////////////////////////////////////////////////////////////////////
 /// @file GmmClientContext.h
 /// @brief This file contains the functions and members of GmmClientContext that is
@@ -87,11 +66,17 @@ namespace GmmLib
         // Flag to indicate Device_callbacks received.
         uint8_t             IsDeviceCbReceived;
         Context *pGmmLibContext;
+        GmmClientAllocationCallbacks          AllocatorCb;    ///< Client heap hooks, pfnAllocation NULL if not registered
+        GMM_RESOURCE_MEM_TRACKER_REC         *pResMemTracker; ///< Live resource totals and accounted sizes, allocated with the first resource
+
+        void GMM_STDCALL                                AddResourceMem(GMM_RESOURCE_INFO *pRes);
+        void GMM_STDCALL                                RemoveResourceMem(GMM_RESOURCE_INFO *pRes);
 
     public:
         /* Constructor */
         GmmClientContext(GMM_CLIENT ClientType);
         GmmClientContext(GMM_CLIENT ClientType, Context* pLibContext);
+        GmmClientContext(GMM_CLIENT ClientType, Context* pLibContext, const GmmClientAllocationCallbacks *pAllocatorCb);
 
         /* Virtual destructor */
         virtual ~GmmClientContext();
@@ -111,6 +96,15 @@ namespace GmmLib
             return pGmmLibContext;
         }
 
+        /////////////////////////////////////////////////////////////////////////////////////
+        /// Returns client heap hooks for internal allocations on behalf of this context.
+        /// @return     GmmClientAllocationCallbacks, NULL if none registered (malloc is used)
+        /////////////////////////////////////////////////////////////////////////////////////
+        const GmmClientAllocationCallbacks *GetAllocatorCb()
+        {
+            return AllocatorCb.pfnAllocation ? &AllocatorCb : NULL;
+        }
+
         /* Function prototypes */
         /* CachePolicy Related Exported Functions from GMM Lib */
         GMM_VIRTUAL MEMORY_OBJECT_CONTROL_STATE         GMM_STDCALL CachePolicyGetMemoryObject(GMM_RESOURCE_INFO *pResInfo, GMM_RESOURCE_USAGE_TYPE Usage);
@@ -176,6 +170,8 @@ namespace GmmLib
         GMM_VIRTUAL GMM_RESOURCE_INFO *GMM_STDCALL      CreateCustomResInfoObject_2(GMM_RESCREATE_CUSTOM_PARAMS_2 *pCreateParams);
 #endif
 	GMM_VIRTUAL uint32_t GMM_STDCALL CachePolicyGetPATIndex(GMM_RESOURCE_INFO *pResInfo, GMM_RESOURCE_USAGE_TYPE Usage, bool *pCompressionEnable, bool IsCpuCacheable);
+        GMM_VIRTUAL void GMM_STDCALL                    GetHeapStats(GMM_HEAP_STATS *pStats);
+        GMM_VIRTUAL void GMM_STDCALL                    GetResourceMemStats(GMM_RESOURCE_MEM_STATS *pStats);
     };
 }
 
@@ -195,6 +191,7 @@ extern "C" {
 
     /* ClientContext will be unique to each client */
     GMM_CLIENT_CONTEXT* GMM_STDCALL GmmCreateClientContextForAdapter(GMM_CLIENT ClientType, ADAPTER_BDF sBdf);
+    GMM_CLIENT_CONTEXT* GMM_STDCALL GmmCreateClientContextWithAllocator(GMM_CLIENT ClientType, ADAPTER_BDF sBdf, const GmmClientAllocationCallbacks *pAllocatorCb);
     void GMM_STDCALL GmmDeleteClientContext(GMM_CLIENT_CONTEXT *pGmmClientContext);
 
 #if GMM_LIB_DLL
@@ -315,6 +315,77 @@ typedef struct GMM_CACHE_SIZES_REC
     GMM_GFX_SIZE_T TotalEDRAM;    // eDRAM Size in Bytes
 } GMM_CACHE_SIZES;
 
+
+//////////////////////////////////////////////////////////////////
+// Memory Allocators and DeAllocators for Gmm Create Objects
+// This is needed for Clients who want to construct using their
+// own memory allocators
+//////////////////////////////////////////////////////////////////
+typedef void* (GMM_STDCALL *PFN_ClientAllocationFunction)(
+    void*                                       pUserData,
+    uint32_t                                    size,
+    uint32_t                                    alignment);
+
+typedef void (GMM_STDCALL *PFN_ClientFreeFunction)(
+    void*                                       pUserData,
+    void*                                       pMemory);
+
+typedef void (GMM_STDCALL *PFN_ClientResetFunction)(
+    void*                                       pUserData);
+
+typedef struct _GmmClientAllocationCallbacks_
+{
+    void*                                   pUserData;
+    uint32_t                                size;           // sizeof(GmmClientAllocationCallbacks) client was built with,
+                                                            // members past it aren't read
+    uint32_t                                alignment;
+    PFN_ClientAllocationFunction            pfnAllocation;
+    PFN_ClientFreeFunction                  pfnFree;
+    PFN_ClientResetFunction                 pfnResetArena;  // Optional. Only used when registered with the client context,
+                                                            // called once the context and all its allocations are freed
+} GmmClientAllocationCallbacks;
+
+//===========================================================================
+// typedef:
+//     GMM_HEAP_CATEGORY
+//
+// Description:
+//     What an internal GmmLib heap allocation is used for.
+//---------------------------------------------------------------------------
+typedef enum GMM_HEAP_CATEGORY_ENUM
+{
+    GMM_HEAP_OTHER = 0,         // Platform info, texture calculator, misc
+    GMM_HEAP_RESOURCE_INFO,     // Resource info objects and their system memory
+    GMM_HEAP_PAGETABLE,         // Page-table manager, pools, table objects and metadata
+    GMM_HEAP_CONTEXT,           // Lib, multi-adapter and client contexts
+    GMM_HEAP_CACHE_POLICY,      // Cache policy objects
+    GMM_HEAP_LOG,               // Log message buffers
+    GMM_HEAP_CATEGORY_MAX
+} GMM_HEAP_CATEGORY;
+
+//===========================================================================
+// typedef:
+//     GMM_HEAP_STATS
+//
+// Description:
+//     Internal heap usage of the GmmLib module, per GMM_HEAP_CATEGORY.
+//     Only kept when GmmLib is built with GMM_HEAP_TRACK_STATS.
+//---------------------------------------------------------------------------
+typedef struct GMM_HEAP_CATEGORY_STATS_REC
+{
+    uint64_t CurrentBytes;      // Outstanding
+    uint64_t PeakBytes;
+    uint64_t CurrentObjects;    // Outstanding allocations
+    uint64_t PeakObjects;
+    uint64_t TotalObjects;      // Allocations made so far
+} GMM_HEAP_CATEGORY_STATS;
+
+typedef struct GMM_HEAP_STATS_REC
+{
+    GMM_HEAP_CATEGORY_STATS Category[GMM_HEAP_CATEGORY_MAX];
+    GMM_HEAP_CATEGORY_STATS Total;                              // All categories, peaks are of the sum
+} GMM_HEAP_STATS;
+
 //------------------------------------------------------------------------
 // GMM Legacy Flags
 //------------------------------------------------------------------------
@@ -55,6 +55,45 @@ typedef struct GMM_UMD_CONTEXT_REC
     uint32_t   TBD3;
 } GMM_UMD_CONTEXT;
 
+//===========================================================================
+// typedef:
+//      GMM_INIT_PHASE
+//
+// Description:
+//      Instrumented phases of lib context creation and destruction.
+//----------------------------------------------------------------------------
+typedef enum GMM_INIT_PHASE_ENUM
+{
+    GMM_INIT_PHASE_CREATE_LIB_CONTEXT = 0,  // GmmCreateLibContext(), includes InitContext()
+    GMM_INIT_PHASE_INIT_CONTEXT,
+    GMM_INIT_PHASE_INIT_CACHE_POLICY,       // Snapshot restore or InitCachePolicy()
+    GMM_INIT_PHASE_SETUP_MOCS_TABLE,
+    GMM_INIT_PHASE_SETUP_PAT,
+    GMM_INIT_PHASE_CREATE_TEXTURE_CALC,
+    GMM_INIT_PHASE_DESTROY_CONTEXT,
+    GMM_INIT_PHASE_MAX
+} GMM_INIT_PHASE;
+
+//===========================================================================
+// typedef:
+//      GMM_INIT_STATS
+//
+// Description:
+//      Accumulated cost of each GMM_INIT_PHASE for one lib context.
+//----------------------------------------------------------------------------
+typedef struct GMM_INIT_PHASE_STATS_REC
+{
+    uint32_t   Count;           // Number of times the phase ran
+    uint64_t   WallTimeNs;      // Wall-clock time
+    uint64_t   CpuTimeNs;       // CPU time of the calling thread
+    uint64_t   AllocCount;      // Objects allocated through GmmMemAllocator
+} GMM_INIT_PHASE_STATS;
+
+typedef struct GMM_INIT_STATS_REC
+{
+    GMM_INIT_PHASE_STATS Phase[GMM_INIT_PHASE_MAX];
+} GMM_INIT_STATS;
+
 
 #if (!defined(__GMM_KMD__) && !defined(GMM_UNIFIED_LIB))
 #include "GmmClientContext.h"
@@ -74,6 +113,28 @@ typedef struct GMM_UMD_CONTEXT_REC
 #ifdef __cplusplus
 #include "GmmMemAllocator.hpp"
 
+// Opt-in (cmake -DGMM_CONTEXT_LAZY_INIT=TRUE): UMD builds the cache policy and
+// texture calculator on first use. Only for stacks whose clients are all built
+// against this header, older inline getters read the tables without building them.
+#if(!defined(GMM_CONTEXT_LAZY_INIT) || defined(__GMM_KMD__))
+#undef GMM_CONTEXT_LAZY_INIT
+#define GMM_CONTEXT_LAZY_INIT 0
+#endif
+
+//===========================================================================
+// typedef:
+//      GMM_CONTEXT_SUBSYSTEM
+//
+// Description:
+//      Context subsystems which are built lazily on first use.
+//----------------------------------------------------------------------------
+typedef enum GMM_CONTEXT_SUBSYSTEM_ENUM
+{
+    GMM_CONTEXT_SUBSYSTEM_CACHE_POLICY = 0,
+    GMM_CONTEXT_SUBSYSTEM_TEXTURE_CALC,
+    GMM_CONTEXT_SUBSYSTEM_MAX
+} GMM_CONTEXT_SUBSYSTEM;
+
 namespace GmmLib
 {
     class NON_PAGED_SECTION Context : public GmmMemAllocator
@@ -119,6 +180,23 @@ namespace GmmLib
         static GMM_MUTEX_HANDLE           SingletonContextSyncMutex;
 #endif
         GMM_PRIVATE_PAT PrivatePATTable[GMM_NUM_PAT_ENTRIES];
+
+        /////////////////////////////////////////////////////////////////////////
+        /// Makes sure the given subsystem is built before it is accessed
+        /// @param[in]  Subsystem: subsystem to be accessed
+        /////////////////////////////////////////////////////////////////////////
+        GMM_INLINE void EnsureSubsystem(GMM_CONTEXT_SUBSYSTEM Subsystem)
+        {
+#if GMM_CONTEXT_LAZY_INIT
+            // Out of line, the subsystem state is not at the same offset in every module
+            InitSubsystem(Subsystem);
+#else
+            GMM_UNREFERENCED_PARAMETER(Subsystem);
+#endif
+        }
+
+        GMM_STATUS GMM_STDCALL BuildCachePolicy(const PLATFORM &Platform);
+
     public :
         //Constructors and destructors
         Context();
@@ -167,6 +245,16 @@ namespace GmmLib
 
         void GMM_STDCALL DestroyContext();
 
+        void GMM_STDCALL RecordInitPhase(GMM_INIT_PHASE Phase, uint64_t WallTimeNs, uint64_t CpuTimeNs, uint64_t AllocCount);
+        void GMM_STDCALL LogInitStats();
+        void GMM_STDCALL LogHeapStats();
+
+        GMM_LIB_API const GMM_INIT_STATS& GMM_STDCALL GetInitStats();
+
+#if GMM_CONTEXT_LAZY_INIT
+        GMM_LIB_API GMM_STATUS GMM_STDCALL InitSubsystem(GMM_CONTEXT_SUBSYSTEM Subsystem);
+#endif
+
 #if (!defined(__GMM_KMD__) && !defined(GMM_UNIFIED_LIB))
         GMM_CLIENT_CONTEXT *pGmmGlobalClientContext;
 #endif
@@ -197,6 +285,7 @@ namespace GmmLib
         /////////////////////////////////////////////////////////////////////////
         GMM_INLINE GMM_CACHE_POLICY_ELEMENT*  GMM_STDCALL GetCachePolicyUsage()
         {
+            EnsureSubsystem(GMM_CONTEXT_SUBSYSTEM_CACHE_POLICY);
             return (&CachePolicy[0]);
         }
 
@@ -206,6 +295,7 @@ namespace GmmLib
         /////////////////////////////////////////////////////////////////////////
         GMM_INLINE GMM_CACHE_POLICY_TBL_ELEMENT*  GMM_STDCALL GetCachePolicyTlbElement()
         {
+            EnsureSubsystem(GMM_CONTEXT_SUBSYSTEM_CACHE_POLICY);
             return (&CachePolicyTbl[0]);
         }
 
@@ -215,6 +305,7 @@ namespace GmmLib
         /////////////////////////////////////////////////////////////////////////
         GMM_INLINE GMM_TEXTURE_CALC* GMM_STDCALL GetTextureCalc()
         {
+            EnsureSubsystem(GMM_CONTEXT_SUBSYSTEM_TEXTURE_CALC);
             return (pTextureCalc);
         }
 
@@ -233,6 +324,7 @@ namespace GmmLib
         /////////////////////////////////////////////////////////////////////////
         GMM_INLINE GMM_CACHE_POLICY* GMM_STDCALL GetCachePolicyObj()
         {
+            EnsureSubsystem(GMM_CONTEXT_SUBSYSTEM_CACHE_POLICY);
             return (pGmmCachePolicy);
         }
 
@@ -278,6 +370,7 @@ namespace GmmLib
         ////////////////////////////////////////////////////////////////////////
         GMM_INLINE GMM_CACHE_POLICY_ELEMENT GetCachePolicyElement(GMM_RESOURCE_USAGE_TYPE Usage)
         {
+            EnsureSubsystem(GMM_CONTEXT_SUBSYSTEM_CACHE_POLICY);
             return (CachePolicy[Usage]);
         }
 
@@ -564,6 +657,8 @@ namespace GmmLib
 
     private: 
         void GMM_STDCALL OverrideSkuWa();
+        GMM_STATUS GMM_STDCALL LoadContextSnapshot(const PLATFORM &Platform);
+        void GMM_STDCALL SaveContextSnapshot(const PLATFORM &Platform);
         
     public:
     /////////////////////////////////////////////////////////////////////////
@@ -572,9 +667,56 @@ namespace GmmLib
     /////////////////////////////////////////////////////////////////////////
     GMM_INLINE GMM_PRIVATE_PAT *GMM_STDCALL GetPrivatePATTable()
     {
+        EnsureSubsystem(GMM_CONTEXT_SUBSYSTEM_CACHE_POLICY);
         return (&PrivatePATTable[0]);
     }
-    
+
+    private:
+        // Appended so the layout of the members above stays unchanged. The offset
+        // of these differs between lib and client builds (pGmmGlobalClientContext),
+        // so they are only accessed from out of line lib code.
+        GMM_INIT_STATS  InitStats;
+
+#if GMM_CONTEXT_LAZY_INIT
+        // Lazy init state of each GMM_CONTEXT_SUBSYSTEM
+        enum
+        {
+            SUBSYSTEM_NOT_READY = 0,
+            SUBSYSTEM_IN_PROGRESS,
+            SUBSYSTEM_READY
+        };
+        volatile uint32_t                SubsystemState[GMM_CONTEXT_SUBSYSTEM_MAX];
+        GMM_MUTEX_HANDLE                 SubsystemLock;   // Recursive, builders re-enter the getters
+#endif
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// Scoped timer which adds the wall-clock time, thread CPU time and
+    /// allocation count of its lifetime to a context's GMM_INIT_STATS.
+    /////////////////////////////////////////////////////////////////////////
+    class NON_PAGED_SECTION InitPhaseTimer
+    {
+    private:
+        Context *       pGmmLibContext;
+        GMM_INIT_PHASE  Phase;
+        uint64_t        StartWallTimeNs;
+        uint64_t        StartCpuTimeNs;
+        uint64_t        StartAllocCount;
+
+    public:
+        InitPhaseTimer(Context *pGmmLibContext, GMM_INIT_PHASE Phase);
+        ~InitPhaseTimer();
+        void GMM_STDCALL     Stop();
+        uint64_t GMM_STDCALL GetElapsedNs();
+
+        /////////////////////////////////////////////////////////////////////////
+        /// Sets the context to account to, for phases which create it
+        /// @param[in]  pContext: context the phase is accounted to
+        /////////////////////////////////////////////////////////////////////////
+        GMM_INLINE void SetLibContext(Context *pContext)
+        {
+            pGmmLibContext = pContext;
+        }
     };
 
 // Max number of Multi-Adapters allowed in the system
@@ -586,15 +728,42 @@ namespace GmmLib
 // Description:
 //      Struct holds Adapter level information.
 //----------------------------------------------------------------------------
+//===========================================================================
+// typedef:
+//      GMM_ADAPTER_INIT_STATE
+//
+// Description:
+//      State of an Adapter's LibContext creation.
+//----------------------------------------------------------------------------
+typedef enum GMM_ADAPTER_INIT_STATE_ENUM
+{
+    GMM_ADAPTER_UNINITIALIZED = 0,
+    GMM_ADAPTER_INITIALIZING,                               // Creator holds the Adapter's SyncMutex
+    GMM_ADAPTER_READY
+} GMM_ADAPTER_INIT_STATE;
+
 typedef struct _GMM_ADAPTER_INFO_
 {
     Context             *pGmmLibContext;                    // Gmm UMD Lib Context which is process Singleton
-    int32_t             RefCount;                           // Ref Count for the number of Gmm UMD Lib process Singleton Context created per Process
+    volatile uint64_t   KeyRefCount;                        // GMM_ADAPTER_KEY in the upper 32 bits, Ref Count for the number of Gmm UMD Lib process Singleton
+                                                            // Context created per Process in the lower 32 bits. 0 when the slot is free.
     GMM_MUTEX_HANDLE    SyncMutex;                          // SyncMutex to protect access of Gmm UMD Lib process Singleton Context 
     ADAPTER_BDF         sBdf;                               // Adpater's Bus, Device and Function info for which Gmm UMD Lib process Singleton Context is created
-    _GMM_ADAPTER_INFO_  *pNext;                             // Linked List Next pointer to point to the Next Adapter node in the List
+    GMM_ADAPTER_INIT_STATE InitState;                       // LibContext creation state, protected by MAContextSyncMutex
+    uint32_t            InitWaiters;                        // Clients waiting for the LibContext creation, protected by MAContextSyncMutex
 
 }GMM_ADAPTER_INFO;
+
+// Non-zero lookup key of an adapter's GMM_ADAPTER_INFO slot
+#define GMM_ADAPTER_KEY(sBdf)   ((uint64_t)(0x80000000u | ((sBdf).Bus << 16) | ((sBdf).Device << 8) | (sBdf).Function))
+
+#if _WIN32
+#define GMM_ADAPTER_LOAD_ACQUIRE(p)         (*(p)) // volatile read has acquire semantics
+#define GMM_ADAPTER_STORE_RELEASE(p, Value) InterlockedExchange64((LONG64 *)(p), (LONG64)(Value))
+#else
+#define GMM_ADAPTER_LOAD_ACQUIRE(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define GMM_ADAPTER_STORE_RELEASE(p, Value) __atomic_store_n((p), (Value), __ATOMIC_RELEASE)
+#endif
     
 ////////////////////////////////////////////////////////////////////////////////////
 /// Multi Adpater Context to hold data related to Multiple Adapters in the system
@@ -603,15 +772,15 @@ typedef struct _GMM_ADAPTER_INFO_
     class NON_PAGED_SECTION GmmMultiAdapterContext : public GmmMemAllocator
     {
     private:
-        GMM_ADAPTER_INFO                AdapterInfo[MAX_NUM_ADAPTERS];// For Static Initialization of adapter.
-        GMM_MUTEX_HANDLE                MAContextSyncMutex;         // SyncMutex to protect access of GmmMultiAdpaterContext
+        GMM_ADAPTER_INFO                AdapterInfo[MAX_NUM_ADAPTERS];// Registered adapters. Lookups are lock-free, slots are only
+                                                                    // claimed and freed under MAContextSyncMutex.
+        GMM_MUTEX_HANDLE                MAContextSyncMutex;         // SyncMutex to protect insertion, removal and init state of adapters
         uint32_t                        NumAdapters;
 	void*                           pCpuReserveBase;
 	uint64_t                        CpuReserveSize;
-        GMM_ADAPTER_INFO                *pHeadNode;// For dynamic Initialization of adapter.
-                                                   // The Multi-Adapter Initialization is done dynamiclly using a Linked list Vector
-                                                   // pHeadNode points to the root node of the linked list and registers the first
-                                                   // adapter received from UMD.
+
+        int32_t GMM_STDCALL             UpdateRefCount(ADAPTER_BDF sBdf, int32_t Delta, int32_t MinCount);
+
     public:
         //Constructors and destructors
         GmmMultiAdapterContext();
@@ -628,10 +797,12 @@ typedef struct _GMM_ADAPTER_INFO_
         uint32_t GMM_STDCALL            GetNumAdapters();
         /* Fucntions that update AdapterInfo*/
         int32_t GMM_STDCALL             IncrementRefCount(ADAPTER_BDF sBdf);
+        int32_t GMM_STDCALL             IncrementRefCountIfActive(ADAPTER_BDF sBdf);
         int32_t GMM_STDCALL             DecrementRefCount(ADAPTER_BDF sBdf);
+        int32_t GMM_STDCALL             DecrementRefCountIfShared(ADAPTER_BDF sBdf);
         GMM_STATUS GMM_STDCALL          LockSingletonContextSyncMutex(ADAPTER_BDF sBdf);
         GMM_STATUS GMM_STDCALL          UnlockSingletonContextSyncMutex(ADAPTER_BDF sBdf);
-        void *GMM_STDCALL               GetAdapterNode(ADAPTER_BDF sBdf); // Replacemet for GetAdapterIndex, now get adapter info from a node in the linked list
+        void *GMM_STDCALL               GetAdapterNode(ADAPTER_BDF sBdf); // Returns the adapter's slot in AdapterInfo
     }; // GmmMultiAdapterContext
 
 } //namespace
@@ -69,6 +69,8 @@ extern "C" {
 /// Only function exported from GMM lib DLL.
 /////////////////////////////////////////////////////////////////////////////////////
     GMM_LIB_API GMM_STATUS GMM_STDCALL InitializeGmm(GMM_INIT_IN_ARGS *pInArgs, GMM_INIT_OUT_ARGS *pOutArgs);
+    GMM_LIB_API GMM_STATUS GMM_STDCALL InitializeGmmWithAllocator(GMM_INIT_IN_ARGS *pInArgs, GMM_INIT_OUT_ARGS *pOutArgs,
+                                                                  const GmmClientAllocationCallbacks *pAllocatorCb);
     GMM_LIB_API void GMM_STDCALL GmmAdapterDestroy(GMM_INIT_OUT_ARGS *pInArgs);
 
 #ifdef __cplusplus
@@ -77,4 +79,5 @@ extern "C" {
 
 typedef GMM_STATUS (GMM_STDCALL *pfnGmmEntry)(GmmExportEntries *);
 typedef GMM_STATUS (GMM_STDCALL *pfnGmmInit)(GMM_INIT_IN_ARGS *, GMM_INIT_OUT_ARGS *);
+typedef GMM_STATUS (GMM_STDCALL *pfnGmmInitWithAllocator)(GMM_INIT_IN_ARGS *, GMM_INIT_OUT_ARGS *, const GmmClientAllocationCallbacks *);
 typedef void (GMM_STDCALL *pfnGmmDestroy)(GMM_INIT_OUT_ARGS *);
@@ -23,22 +23,148 @@ OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 #include "GmmUtil.h"
 #include <stdlib.h>
+#include <new>
 
 #define NON_PAGED_SECTION
 
 #define GMM_MALLOC(size)    malloc(size)
 #define GMM_FREE(p)         free(p)
 
+// Some includers are inside extern "C" blocks, member templates need C++ linkage
+extern "C++" {
 /////////////////////////////////////////////////////////////
 /// Overrides new() and delete() to work with both user mode
 /// and kernel mode.
+/// Memory comes from the client's GmmClientAllocationCallbacks when
+/// passed to new(), malloc otherwise. Blocks have no header, those
+/// from malloc can still be free()'d. AllocMem()/FreeMem() live in
+/// GmmLib and record which blocks came from client allocators (and
+/// heap stats, GMM_HEAP_TRACK_STATS), so delete() works across
+/// modules built with different settings.
 /////////////////////////////////////////////////////////////
 class NON_PAGED_SECTION GmmMemAllocator
 {
     public:
+        // Outstanding block, as reported by GetOutstandingBlocks()
+        typedef struct GMM_HEAP_BLOCK_INFO_REC
+        {
+            void *   ptr;
+            size_t   Size;
+            uint64_t Seq;           // Allocation sequence number
+            uint32_t Category;      // GMM_HEAP_CATEGORY
+        } GMM_HEAP_BLOCK_INFO;
+
+        /////////////////////////////////////////////////////////////
+        /// Allocates Size bytes from pAllocatorCb, or malloc if NULL.
+        /// Free with FreeMem(), or free() if malloc'ed.
+        /////////////////////////////////////////////////////////////
+        static GMM_LIB_API void *GMM_STDCALL AllocMem(const GmmClientAllocationCallbacks *pAllocatorCb, size_t Size,
+                                                      GMM_HEAP_CATEGORY Category = GMM_HEAP_OTHER, uint32_t Count = 1);
+        static GMM_LIB_API void GMM_STDCALL     FreeMem(void *ptr);
+        /////////////////////////////////////////////////////////////
+        /// Returns Count passed to AllocMem() for the block at ptr.
+        /////////////////////////////////////////////////////////////
+        static GMM_LIB_API uint32_t GMM_STDCALL GetArrayCount(void *ptr);
+
+        static uint64_t AtomicAdd64(uint64_t *p, int64_t Value)
+        {
+#if _WIN32
+            return (uint64_t)InterlockedExchangeAdd64((LONG64 *)p, (LONG64)Value) + (uint64_t)Value;
+#else
+            return __sync_add_and_fetch(p, (uint64_t)Value);
+#endif
+        }
+
+        static void AtomicMax64(uint64_t *p, uint64_t Value)
+        {
+            uint64_t Old = *(volatile uint64_t *)p;
+
+            while(Value > Old)
+            {
+#if _WIN32
+                uint64_t Prev = (uint64_t)InterlockedCompareExchange64((LONG64 *)p, (LONG64)Value, (LONG64)Old);
+#else
+                uint64_t Prev = __sync_val_compare_and_swap(p, Old, Value);
+#endif
+                if(Prev == Old)
+                {
+                    break;
+                }
+                Old = Prev;
+            }
+        }
+
+        // Module heap stats and outstanding blocks, for GmmLib's own reporting
+        static void     GetHeapStats(GMM_HEAP_STATS *pStats);
+        static uint32_t GetOutstandingBlocks(GMM_HEAP_BLOCK_INFO *pBlocks, uint32_t MaxBlocks);
+
+        /////////////////////////////////////////////////////////////
+        /// new T[Count]() replacement routed through pAllocatorCb.
+        /// Elements are value-initialized. Free with DeleteArray().
+        /////////////////////////////////////////////////////////////
+        template <class T>
+        static T* NewArray(const GmmClientAllocationCallbacks *pAllocatorCb, size_t Count, GMM_HEAP_CATEGORY Category = GMM_HEAP_OTHER)
+        {
+            T *ptr = static_cast<T *>(AllocMem(pAllocatorCb, Count * sizeof(T), Category, (uint32_t)Count));
+
+            if(ptr)
+            {
+                for(size_t i = 0; i < Count; i++)
+                {
+                    ::new(static_cast<void *>(&ptr[i])) T();
+                }
+            }
+            return ptr;
+        }
+
+        template <class T>
+        static void DeleteArray(T *ptr)
+        {
+            if(ptr)
+            {
+                uint32_t Count = GetArrayCount(ptr);
+
+                for(uint32_t i = 0; i < Count; i++)
+                {
+                    ptr[i].~T();
+                }
+                FreeMem(ptr);
+            }
+        }
+
         void* operator new(size_t size)
         {
-            return GMM_MALLOC(size);
+            return operator new(size, (const GmmClientAllocationCallbacks *)NULL, GMM_HEAP_OTHER);
+        }
+
+        void* operator new(size_t size, GMM_HEAP_CATEGORY Category)
+        {
+            return operator new(size, (const GmmClientAllocationCallbacks *)NULL, Category);
+        }
+
+        void* operator new(size_t size, const GmmClientAllocationCallbacks *pAllocatorCb)
+        {
+            return operator new(size, pAllocatorCb, GMM_HEAP_OTHER);
+        }
+
+        void* operator new(size_t size, const GmmClientAllocationCallbacks *pAllocatorCb, GMM_HEAP_CATEGORY Category)
+        {
+#if _WIN32
+            InterlockedIncrement64((LONG64 *)&AllocCount());
+#else
+            __sync_fetch_and_add(&AllocCount(), 1);
+#endif
+            return AllocMem(pAllocatorCb, size, Category);
+        }
+
+        /////////////////////////////////////////////////////////////
+        /// Returns the number of objects allocated through new() so
+        /// far in this module. Used for init phase accounting.
+        /////////////////////////////////////////////////////////////
+        static uint64_t& AllocCount()
+        {
+            static uint64_t Count = 0;
+            return Count;
         }
 
         void* operator new(size_t size, void* ptr)
@@ -49,7 +175,26 @@ class NON_PAGED_SECTION GmmMemAllocator
 
         void operator delete(void *ptr)
         {
-            GMM_FREE(ptr);
+            FreeMem(ptr);
+        }
+
+        void operator delete(void *ptr, const GmmClientAllocationCallbacks *pAllocatorCb)
+        {
+            GMM_UNREFERENCED_PARAMETER(pAllocatorCb);
+            FreeMem(ptr);
+        }
+
+        void operator delete(void *ptr, GMM_HEAP_CATEGORY Category)
+        {
+            GMM_UNREFERENCED_PARAMETER(Category);
+            FreeMem(ptr);
+        }
+
+        void operator delete(void *ptr, const GmmClientAllocationCallbacks *pAllocatorCb, GMM_HEAP_CATEGORY Category)
+        {
+            GMM_UNREFERENCED_PARAMETER(pAllocatorCb);
+            GMM_UNREFERENCED_PARAMETER(Category);
+            FreeMem(ptr);
         }
 
         void operator delete(void *ptr, void *place)
@@ -59,3 +204,4 @@ class NON_PAGED_SECTION GmmMemAllocator
             // placement delete -- nothing to do.
         }
 };
+}
@@ -62,6 +62,15 @@ typedef struct __GMM_DDI_UPDATEAUXTABLE
     uint8_t DoNotWait;                    // [in]  specifies if PageTable update be done on CPU (true) or GPU (false)
 }GMM_DDI_UPDATEAUXTABLE;
 
+#define GMM_PAGETABLE_BO_CHANGE_LOG_SIZE 64   // Page-table BO list changes kept for GetPageTableBOChanges
+
+// Page-table BO added to/removed from BO list, reported by GmmPageTableMgr::GetPageTableBOChanges
+typedef struct GMM_PAGETABLE_BO_CHANGE_REC
+{
+    HANDLE  bo;
+    uint8_t Added;                      // 1: added to BO list, 0: removed
+} GMM_PAGETABLE_BO_CHANGE;
+
 #ifdef __cplusplus
 #include "GmmMemAllocator.hpp"
 
@@ -88,8 +97,46 @@ namespace GmmLib
          POOL_TYPE_TRTTL2  = 1,
          POOL_TYPE_AUXTTL1 = 2,
          POOL_TYPE_AUXTTL2 = 3,
+         POOL_TYPE_MAX
      } POOL_TYPE;
 
+     // Client callbacks issued by GmmPageTableMgr, counted in GMM_PAGETABLE_MGR_STATS
+     typedef enum GMM_PAGETABLE_CB_TYPE_REC
+     {
+         GMM_PAGETABLE_CB_ALLOCATE = 0,       // pfnAllocate (L3 table, pools)
+         GMM_PAGETABLE_CB_DEALLOCATE,         // pfnDeallocate
+         GMM_PAGETABLE_CB_WAIT_FROM_CPU,      // pfnWaitFromCpu
+         GMM_PAGETABLE_CB_PROLOG,             // pfPrologTranslationTable
+         GMM_PAGETABLE_CB_EPILOG,             // pfEpilogTranslationTable
+         GMM_PAGETABLE_CB_WRITE_L1_ENTRIES,   // pfWriteL1Entries
+         GMM_PAGETABLE_CB_WRITE_L2L3_ENTRY,   // pfWriteL2L3Entry
+         GMM_PAGETABLE_CB_MAX
+     } GMM_PAGETABLE_CB_TYPE;
+
+     // Page-table memory, pool fragmentation and activity, reported by GmmPageTableMgr::GetStats
+     typedef struct GMM_PAGETABLE_MGR_STATS_REC
+     {
+         uint32_t       NumPools[POOL_TYPE_MAX];           // Pools in BO list, by PoolType
+         uint32_t       NumUsedNodes[POOL_TYPE_MAX];       // Pool nodes assigned to tables
+         uint32_t       NumFreeNodes[POOL_TYPE_MAX];       // Pool nodes unassigned
+         uint32_t       NumUnusedPools;                    // Pools in BO list with no table assigned
+         uint32_t       NumSparsePools;                    // Pools with tables assigned, occupancy below compaction threshold
+         uint32_t       NumRetiredPools;                   // Pools pending ReclaimPools
+         uint32_t       NumPendingFences;                  // Unassigned tables (BO list and retired pools) whose last Gpu use isn't complete
+         GMM_GFX_SIZE_T L3TableSize;                       // Bytes allocated for L3 table
+         GMM_GFX_SIZE_T PoolSize;                          // Bytes in pools of BO list
+         GMM_GFX_SIZE_T UsedSize;                          // Pool bytes assigned to tables
+         GMM_GFX_SIZE_T FragmentedSize;                    // Unassigned bytes in pools with tables assigned
+         GMM_GFX_SIZE_T RetiredSize;                       // Bytes in retired pools
+         uint32_t       NumL2Tables;                       // Live Aux L2 tables
+         uint32_t       NumL1Tables;                       // Live Aux L1 tables
+         GMM_GFX_SIZE_T MappedSize;                        // Main-surface bytes with valid (non-null) L1e
+         uint64_t       NumL1eWritten;                     // L1e Gpu-updated by map requests
+         uint64_t       NumL1eSkipped;                     // L1e re-mapped to unchanged CCS, Gpu-update skipped
+         uint64_t       SkippedEntryBytes;                 // L1e bytes (GMM_AUX_L1e_SIZE each) not written due to skipped L1e, excludes command overhead
+         uint64_t       NumCallbacks[GMM_PAGETABLE_CB_MAX]; // Callbacks issued since creation, by GMM_PAGETABLE_CB_TYPE
+     } GMM_PAGETABLE_MGR_STATS;
+
     //////////////////////////////////////////////////////////////////////////////////////////////
     /// Contains functions and members for GMM_PAGETABLE_MGR, clients must place its pointer in
     /// their device object. Clients call GmmLib to initialize the instance and use it for mapping
@@ -132,6 +179,14 @@ namespace GmmLib
                                                                        //for given host page VA  when base/Aux surf is mapped/unmapped
         GMM_VIRTUAL void __ReleaseUnusedPool(GMM_UMD_SYNCCONTEXT *UmdContext);
         GMM_VIRTUAL GMM_PAGETABLEPool * __GetFreePoolNode(uint32_t * FreePoolNodeIdx, POOL_TYPE PoolType);
+        GMM_PAGETABLEPool * __AssignFreePoolNode(uint32_t *FreePoolNodeIdx, POOL_TYPE PoolType, SyncInfo *NodeBBInfo);
+        void __ReleasePoolNode(GMM_UMD_SYNCCONTEXT *UmdContext, GMM_PAGETABLEPool *Pool, int NodeIdx, int PerTableNodes);
+        void __CountCallback(GMM_PAGETABLE_CB_TYPE Type);
+        void __WriteL2L3Entry(HANDLE CmdQHandle, GMM_GFX_ADDRESS EntryAdr, uint64_t Data);
+        GMM_INLINE uint8_t __IsAtomicL1EntriesWrite()
+        {
+            return AtomicL1EntriesWrite;
+        }
 
 
 #if defined __linux__
@@ -154,8 +209,59 @@ namespace GmmLib
             return pClientContext;
         }
 
+        //Bulk Aux TT update, one prolog/epilog per cmdQ, requests applied in VA order, overlapping ones in caller's order (placed last, keeps existing vtable slots)
+        GMM_VIRTUAL GMM_STATUS UpdateAuxTables(const GMM_DDI_UPDATEAUXTABLE *UpdateReqs, uint32_t NumReqs, GMM_STATUS *pStatus);
+
+        //Deferred Aux TT invalidation, unmapped VA ranges are queued merged and invalidated in bulk at client's sync point
+        GMM_VIRTUAL void SetDeferredAuxInvalidation(uint8_t Enable);
+        GMM_VIRTUAL GMM_STATUS FlushAuxTableInvalidations(GMM_UMD_SYNCCONTEXT *UmdContext, uint8_t DoNotWait);
+        GMM_VIRTUAL uint32_t GetNumPendingAuxInvalidations();
+
+        //Fence-driven reclamation of page-table pools retired on unmap path (unmap never waits for Gpu)
+        GMM_VIRTUAL uint32_t ReclaimPools(HANDLE BBQueueHandle, uint64_t CompletedFence);
+        GMM_VIRTUAL uint32_t ReclaimPools();
+        GMM_VIRTUAL uint32_t GetNumRetiredPools();
+
+        //Opt-in compaction, moves tables out of sparse pools and retires the emptied pools
+        GMM_VIRTUAL GMM_STATUS CompactPools(GMM_UMD_SYNCCONTEXT *UmdContext, uint8_t DoNotWait, uint64_t CompletedFence, uint32_t *pNumPoolsEmptied);
+
+#if defined __linux__
+        //Incremental BO list, generation bumps on every page-table BO added to/removed from BO list
+        GMM_VIRTUAL uint32_t GetPageTableBOGeneration(uint8_t TTFlags);
+        //returns changes since Generation in order (0 if none, lock-free), -1 if client must rebuild with GetPageTableBOList
+        GMM_VIRTUAL int GetPageTableBOChanges(uint8_t TTFlags, uint32_t Generation, GMM_PAGETABLE_BO_CHANGE *Changes, int MaxChanges, uint32_t *pGeneration);
+#endif
+
+        //Introspection (pools, tables, map updates, callbacks), pending fences counted against CompletedFence observed on BBQueueHandle
+        GMM_VIRTUAL void GetStats(GMM_PAGETABLE_MGR_STATS *pStats, HANDLE BBQueueHandle, uint64_t CompletedFence);
+        //Text dump of pools and table tree (snprintf-like), returns length excluding terminating null
+        GMM_VIRTUAL uint32_t DumpPageTables(char *pBuffer, uint32_t BufferSize);
+        //Opt-in Gpu-update of non-TR Aux TT maps on the request's cmdQ (default Cpu-update)
+        GMM_VIRTUAL void SetAuxMapGpuUpdate(uint8_t Enable);
+        //Opt-in coalesced L1e writes via pfWriteL1Entries, client declares each QWORD of it is written atomically (default per-entry pfWriteL2L3Entry)
+        GMM_VIRTUAL void SetAtomicL1EntriesWrite(uint8_t Enable);
+
     private:
+        GMM_PAGETABLEPool *pFreePool[POOL_TYPE_MAX];   //per PoolType list of pools with unassigned nodes (full ones dropped lazily)
+        GMM_PAGETABLEPool *pRetiredPool;               //unused pools unlinked from pPool, freed once their last Gpu use completes
+        uint32_t           NumRetiredPools;
+        uint32_t           BOListGen;                  //bumped on every pool added to/removed from pool list (BO list)
+        uint64_t           NumCallbacks[GMM_PAGETABLE_CB_MAX]; //callbacks issued, by type (atomic, updated under different locks)
+        uint8_t            AuxMapGpuUpdate;            //non-TR maps Gpu-update when client's cmdQ and callbacks allow it
+        uint8_t            AtomicL1EntriesWrite;       //client's pfWriteL1Entries writes whole L1e (QWORD) atomically, L1e runs may be coalesced
+        GMM_PAGETABLE_BO_CHANGE BOListLog[GMM_PAGETABLE_BO_CHANGE_LOG_SIZE]; //last BO list changes, indexed by generation
+
         GMM_PAGETABLEPool * __AllocateNodePool(uint32_t AddrAlignment, POOL_TYPE Type);
+        void __AddToFreePoolList(GMM_PAGETABLEPool *Pool);
+        void __RemoveFromFreePoolList(GMM_PAGETABLEPool *Pool);
+        GMM_PAGETABLEPool *__ReviveRetiredPool(POOL_TYPE Type);
+        void __FreeRetiredPool(GMM_PAGETABLEPool *Pool, bool WaitForIdle);
+        void __RetirePool(GMM_PAGETABLEPool *Pool, GMM_PAGETABLEPool *PrevPool);
+        void __LogBOListChange(HANDLE bo, bool Added);
+        uint32_t __SelectEvacuatePools(HANDLE BBQueueHandle, uint64_t CompletedFence);
+        uint32_t __RetireEvacuatedPools(GMM_UMD_SYNCCONTEXT *UmdContext);
+        GMM_STATUS __ValidateAuxTableUpdate(const GMM_DDI_UPDATEAUXTABLE *UpdateReq);
+        GMM_STATUS __UpdateAuxTable(const GMM_DDI_UPDATEAUXTABLE *UpdateReq, uint8_t CpuUpdate);
 
         GMM_INLINE GMM_LIB_CONTEXT *GetLibContext() 
         {
@@ -134,6 +134,7 @@ typedef struct GMM_RESOURCE_FLAG_REC
         uint32_t __PreWddm2SVM             : 1; // Internal GMM flag--Clients don't set.
         uint32_t Tile4                     : 1; // 4KB tile
         uint32_t Tile64                    : 1; // 64KB tile
+        uint32_t OptimizeTilingForSize     : 1; // Pick the tiling by resulting size, see GMM_RESCREATE_PARAMS.pTilingSearch
     } Info;
 
     // Wa: Any Surface specific Work Around will go in here
@@ -81,6 +81,7 @@ namespace GmmLib
 
         private:
             GMM_STATUS          ApplyExistingSysMemRestrictions();
+            void                SelectTilingForSize(Context &GmmLibContext, GMM_RESCREATE_PARAMS &CreateParams);
 
         protected:
             /* Function prototypes */
@@ -2008,6 +2009,9 @@ namespace GmmLib
 		return 0;          
             }
 
+            // Size breakdown for resource mem stats (placed last, keeps existing vtable slots)
+            GMM_VIRTUAL void                    GMM_STDCALL GetSizeInfo(GMM_RESOURCE_SIZE_INFO *pSizeInfo);
+
     };
 
 } // namespace GmmLib
@@ -337,6 +337,7 @@ typedef struct GMM_RESCREATE_PARAMS_REC
     uint8_t                             NoGfxMemory;
     GMM_RESOURCE_INFO                   *pPreallocatedResInfo;
     GMM_MULTI_TILE_ARCH                 MultiTileArch;
+    struct GMM_TILING_SEARCH_REC        *pTilingSearch;  // Optional, for Flags.Info.OptimizeTilingForSize
 
 } GMM_RESCREATE_PARAMS;
 
@@ -213,6 +213,97 @@ typedef struct GMM_TEXTURE_INFO_REC
 
 }GMM_TEXTURE_INFO;
 
+//===========================================================================
+// typedef:
+//        GMM_RESOURCE_SIZE_INFO
+//
+// Description:
+//     Breaks a resource's allocation size down into the bytes its texels
+//     need and where the rest comes from. Main surface parts add up to
+//     MainSurfaceSize, and everything adds up to AllocationSize.
+//     Padding split is an estimate from mip dimensions and alignments.
+//---------------------------------------------------------------------------
+typedef struct GMM_RESOURCE_SIZE_INFO_REC
+{
+    GMM_RESOURCE_TYPE       Type;
+    GMM_RESOURCE_FORMAT     Format;
+    GMM_TILE_MODE           TileMode;
+
+    GMM_GFX_SIZE_T          LogicalSize;        // Tightly packed texels of all mips, slices, samples and planes
+    GMM_GFX_SIZE_T          AlignPadding;       // Rounding mips up to HAlign/VAlign/DAlign
+    GMM_GFX_SIZE_T          MipTailPadding;     // Unused space in packed mip tail tiles
+    GMM_GFX_SIZE_T          LayoutPadding;      // Pitch, QPitch, tile and plane alignment, mip arrangement
+    GMM_GFX_SIZE_T          MainSurfaceSize;    // Sum of the above
+
+    GMM_GFX_SIZE_T          AuxSize;            // Unpadded CCS/MCS/HiZ and secondary aux surface
+    GMM_GFX_SIZE_T          ClearColorSize;     // Indirect clear color
+    GMM_GFX_SIZE_T          AuxPadding;         // Aux surface alignment
+
+    GMM_GFX_SIZE_T          PageSizePadding;    // Rounding up for 64KB pages (Is64KBPageSuitable)
+    GMM_GFX_SIZE_T          AllocationSize;     // GetSizeAllocation()
+}GMM_RESOURCE_SIZE_INFO;
+
+//===========================================================================
+// typedef:
+//        GMM_RESOURCE_MEM_STATS
+//
+// Description:
+//     Running totals of the resources a client context has created and not
+//     yet destroyed, with histograms by type, format and tile mode.
+//     Breakdown holds the sum of the resources' GMM_RESOURCE_SIZE_INFO
+//     (Type, Format and TileMode unused).
+//---------------------------------------------------------------------------
+typedef struct GMM_RESOURCE_MEM_BUCKET_REC
+{
+    uint64_t                Count;
+    GMM_GFX_SIZE_T          LogicalSize;
+    GMM_GFX_SIZE_T          AllocationSize;
+}GMM_RESOURCE_MEM_BUCKET;
+
+typedef struct GMM_RESOURCE_MEM_STATS_REC
+{
+    GMM_RESOURCE_MEM_BUCKET Total;
+    GMM_GFX_SIZE_T          PeakAllocationSize;
+    GMM_RESOURCE_SIZE_INFO  Breakdown;
+    GMM_RESOURCE_MEM_BUCKET Type[GMM_MAX_HW_RESOURCE_TYPE];
+    GMM_RESOURCE_MEM_BUCKET Format[GMM_RESOURCE_FORMATS];
+    GMM_RESOURCE_MEM_BUCKET TileMode[GMM_TILE_MODES];
+}GMM_RESOURCE_MEM_STATS;
+
+//===========================================================================
+// typedef:
+//        GMM_TILING_SEARCH
+//
+// Description:
+//     Policy and report for Flags.Info.OptimizeTilingForSize. The resource
+//     is laid out with each legal candidate tiling and created with the one
+//     Policy selects. Candidates are listed in preference order; on equal
+//     size the earlier one wins.
+//---------------------------------------------------------------------------
+typedef enum GMM_TILING_SEARCH_POLICY_ENUM
+{
+    GMM_TILING_SEARCH_SMALLEST = 0,     // Smallest allocation size
+    GMM_TILING_SEARCH_PREFER_64KB,      // Smallest 64KB page suitable candidate within MaxGrowthPercent of the smallest
+}GMM_TILING_SEARCH_POLICY;
+
+#define GMM_MAX_TILING_CANDIDATES   5
+
+typedef struct GMM_TILING_CANDIDATE_REC
+{
+    GMM_TILE_MODE           TileMode;
+    GMM_GFX_SIZE_T          Size;               // GetSizeAllocation()
+    uint8_t                 Is64KBPageSuitable;
+}GMM_TILING_CANDIDATE;
+
+typedef struct GMM_TILING_SEARCH_REC
+{
+    GMM_TILING_SEARCH_POLICY Policy;            // In
+    uint32_t                 MaxGrowthPercent;  // In, GMM_TILING_SEARCH_PREFER_64KB only
+    uint32_t                 NumCandidates;     // Out, 0 if the resource was not eligible
+    uint32_t                 Selected;          // Out, index into Candidates
+    GMM_TILING_CANDIDATE     Candidates[GMM_MAX_TILING_CANDIDATES];
+}GMM_TILING_SEARCH;
+
 //***************************************************************************
 //
 //                      GMM_TEXTURE API